@@ -0,0 +1,352 @@
+#include "lxgui/impl/gui_common_font.hpp"
+#include "lxgui/impl/gui_common_fontface.hpp"
+#include <lxgui/gui_manager.hpp>
+#include <lxgui/gui_out.hpp>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_GLYPH_H
+#include FT_SIZES_H
+
+#include <cmath>
+
+namespace gui {
+namespace common
+{
+const FT_Int32 LOAD_FLAGS = FT_LOAD_RENDER | FT_LOAD_NO_HINTING;
+
+// Maximum distance (in texels) stored in distance field fonts
+const uint DISTANCE_FIELD_SPREAD = 8u;
+
+font::font(utils::refptr<font_face> pFace) : pFace_(pFace), bDistanceField_(false),
+    uiPadding_(0u), uiTextureWidth_(0u), uiTextureHeight_(0u), uiTextureRevision_(0u),
+    pSize_(nullptr), uiSpacing_(1u), uiMaxHeight_(0u), iMaxBearingY_(0), bKerning_(false)
+{
+}
+
+font::~font()
+{
+    if (pSize_)
+        FT_Done_Size(pSize_);
+}
+
+void font::init_(uint uiSize, bool bDistanceField)
+{
+    bDistanceField_ = bDistanceField;
+
+    // NOTE : Code inspired from Ogre::Font, from the OGRE3D graphics engine
+    // http://www.ogre3d.org
+    //
+    // Some tweaking has been done to improve the text quality :
+    //  - Disable hinting (FT_LOAD_NO_HINTING)
+    //  - Character width is calculated as : max(x_bearing + width, advance),
+    //    since advance sometimes doesn't cover the whole glyph
+    //    (typical example is the 'w' character, in Consolas:9).
+    //
+    // Characters are only rendered the first time they are used
+    // (see get_character_()).
+
+    // Each size has its own FT_Size on the shared face
+    FT_Face mFace = pFace_->get_face();
+    if (FT_New_Size(mFace, &pSize_) || FT_Activate_Size(pSize_) ||
+        FT_Set_Char_Size(mFace, uiSize*64, uiSize*64, 96, 96))
+    {
+        if (pSize_)
+        {
+            FT_Done_Size(pSize_);
+            pSize_ = nullptr;
+        }
+
+        throw gui::exception("gui::common::font", "Error loading font : \""+pFace_->get_file()+
+            "\" : cannot set font size."
+        );
+    }
+
+    // The line height is given by the face, so that it does not
+    // depend on the characters that have been loaded so far
+    iMaxBearingY_ = pSize_->metrics.ascender >> 6;
+    uiMaxHeight_  = (pSize_->metrics.ascender - pSize_->metrics.descender) >> 6;
+
+    // Distance fields extend outside of the characters
+    if (bDistanceField_)
+        uiPadding_ = DISTANCE_FIELD_SPREAD;
+
+    // Start with a texture that can hold about a hundred characters
+    uint uiTexSide = 1;
+    while (uiTexSide < 10*(uiMaxHeight_ + 2*uiPadding_ + uiSpacing_))
+        uiTexSide += uiTexSide;
+
+    uiTextureWidth_ = uiTexSide;
+    uiTextureHeight_ = uiTexSide/2;
+
+    create_texture_(uiTextureWidth_, uiTextureHeight_);
+
+    lCharacterTable_.fill(nullptr);
+
+    if (FT_HAS_KERNING(mFace))
+        bKerning_ = true;
+}
+
+quad2f font::get_character_uvs(char32_t uiChar) const
+{
+    const quad2i& mRect = get_character_(uiChar).mRect;
+    return quad2f(
+        mRect.left/float(uiTextureWidth_), mRect.right/float(uiTextureWidth_),
+        mRect.top/float(uiTextureHeight_), mRect.bottom/float(uiTextureHeight_)
+    );
+}
+
+float font::get_character_width(char32_t uiChar) const
+{
+    return get_character_(uiChar).mRect.width();
+}
+
+float font::get_character_kerning(char32_t uiChar1, char32_t uiChar2) const
+{
+    if (!bKerning_)
+        return 0.0f;
+
+    unsigned long long uiKey = (static_cast<unsigned long long>(uiChar1) << 32) | uiChar2;
+    std::unordered_map<unsigned long long, float>::iterator iter = lKerningList_.find(uiKey);
+    if (iter != lKerningList_.end())
+        return iter->second;
+
+    float fKerning = 0.0f;
+
+    uint uiIndex1 = get_character_(uiChar1).uiGlyphIndex;
+    uint uiIndex2 = get_character_(uiChar2).uiGlyphIndex;
+
+    FT_Face mFace = pFace_->get_face();
+    FT_Activate_Size(pSize_);
+
+    FT_Vector kern;
+    if (!FT_Get_Kerning(mFace, uiIndex1, uiIndex2, FT_KERNING_UNFITTED, &kern))
+        fKerning = kern.x >> 6;
+
+    lKerningList_[uiKey] = fKerning;
+    return fKerning;
+}
+
+void font::get_character_widths(const char32_t* pChars, uint uiCount, float* pWidths) const
+{
+    for (uint i = 0; i < uiCount; ++i)
+        pWidths[i] = get_character_(pChars[i]).mRect.width();
+}
+
+void font::get_character_kernings(const char32_t* pChars, uint uiCount, float* pKernings) const
+{
+    if (!bKerning_)
+    {
+        if (uiCount > 1)
+            std::fill(pKernings, pKernings + uiCount - 1, 0.0f);
+        return;
+    }
+
+    for (uint i = 0; i + 1 < uiCount; ++i)
+        pKernings[i] = font::get_character_kerning(pChars[i], pChars[i+1]);
+}
+
+uint font::get_texture_revision() const
+{
+    return uiTextureRevision_;
+}
+
+const character_info& font::get_character_(char32_t uiChar) const
+{
+    // The most common characters are also stored in a flat table, to
+    // avoid hashing them (elements of the map are never moved)
+    if (uiChar < lCharacterTable_.size() && lCharacterTable_[uiChar])
+        return *lCharacterTable_[uiChar];
+
+    std::unordered_map<char32_t, character_info>::iterator iter = lCharacterList_.find(uiChar);
+    if (iter != lCharacterList_.end())
+        return iter->second;
+
+    // Characters that cannot be loaded are kept empty, so that
+    // they are not loaded again
+    character_info& mCI = lCharacterList_[uiChar];
+    mCI.uiCodePoint = uiChar;
+    mCI.uiGlyphIndex = FT_Get_Char_Index(pFace_->get_face(), uiChar);
+    mCI.mRect = quad2i::ZERO;
+    load_character_(mCI);
+
+    if (uiChar < lCharacterTable_.size())
+        lCharacterTable_[uiChar] = &mCI;
+
+    return mCI;
+}
+
+bool font::load_character_(character_info& mCI) const
+{
+    FT_Face mFace = pFace_->get_face();
+    FT_Activate_Size(pSize_);
+
+    if (FT_Load_Char(mFace, mCI.uiCodePoint, LOAD_FLAGS))
+    {
+        gui::out << gui::warning << "gui::common::font : Cannot load character " << mCI.uiCodePoint
+            << " in font \"" << pFace_->get_file() << "\"." << std::endl;
+        return false;
+    }
+
+    FT_GlyphSlot pGlyph = mFace->glyph;
+
+    int iXBearing = std::max(0, int(pGlyph->metrics.horiBearingX >> 6));
+    int iAdvance  = std::max(iXBearing + int(pGlyph->bitmap.width), int(pGlyph->advance.x >> 6));
+
+    if (!pack_character_(iAdvance, mCI.mRect))
+    {
+        gui::out << gui::warning << "gui::common::font : No room left in the texture of font \""
+            << pFace_->get_file() << "\" for character " << mCI.uiCodePoint << "." << std::endl;
+        return false;
+    }
+
+    if (bDistanceField_)
+    {
+        // Draw the character with its padding, then compute the distance field
+        uint uiWidth = mCI.mRect.width() + 2*uiPadding_;
+        uint uiHeight = mCI.mRect.height() + 2*uiPadding_;
+        std::vector<float> lCoverage(uiWidth*uiHeight, 0.0f);
+
+        if (pGlyph->bitmap.buffer)
+        {
+            int iYBearing = iMaxBearingY_ - (pGlyph->metrics.horiBearingY >> 6) + uiPadding_;
+
+            for (int j = 0; j < int(pGlyph->bitmap.rows); ++j)
+            {
+                int y = iYBearing + j;
+                if (y < 0 || y >= int(uiHeight))
+                    continue;
+
+                const uchar* sBuffer = pGlyph->bitmap.buffer + j*pGlyph->bitmap.pitch;
+                for (int i = 0; i < int(pGlyph->bitmap.width); ++i, ++sBuffer)
+                {
+                    int x = uiPadding_ + iXBearing + i;
+                    if (x < int(uiWidth))
+                        lCoverage[x + y*uiWidth] = *sBuffer/255.0f;
+                }
+            }
+        }
+
+        write_distance_field_(lCoverage, uiWidth, uiHeight, mCI.mRect);
+    }
+    else if (pGlyph->bitmap.buffer)
+    {
+        int iYBearing = iMaxBearingY_ - (pGlyph->metrics.horiBearingY >> 6);
+
+        for (int j = 0; j < int(pGlyph->bitmap.rows); ++j)
+        {
+            int y = iYBearing + j;
+            if (y < 0 || y >= int(uiMaxHeight_))
+                continue;
+
+            const uchar* sBuffer = pGlyph->bitmap.buffer + j*pGlyph->bitmap.pitch;
+            for (int i = 0; i < int(pGlyph->bitmap.width); ++i, ++sBuffer)
+            {
+                    set_texture_alpha_(mCI.mRect.left + iXBearing + i, mCI.mRect.top + y, *sBuffer);
+            }
+        }
+    }
+
+    update_texture_(quad2i(
+        mCI.mRect.left - uiPadding_, mCI.mRect.right + uiPadding_,
+        mCI.mRect.top - uiPadding_, mCI.mRect.bottom + uiPadding_
+    ));
+
+    return true;
+}
+
+void font::write_distance_field_(const std::vector<float>& lCoverage, uint uiWidth, uint uiHeight,
+    const quad2i& mRect) const
+{
+    // For each texel, look for the closest texel on the other side of the edge.
+    // The search is limited to the spread of the distance field, which is small
+    // enough for this to be fast, and only done once per character.
+    int iSpread = uiPadding_;
+    int iMaxDist2 = iSpread*iSpread;
+
+    for (int y = 0; y < int(uiHeight); ++y)
+    for (int x = 0; x < int(uiWidth); ++x)
+    {
+        float fCoverage = lCoverage[x + y*uiWidth];
+        bool bInside = fCoverage >= 0.5f;
+
+        int iMinDist2 = iMaxDist2;
+        for (int j = std::max(0, y - iSpread); j <= std::min(int(uiHeight) - 1, y + iSpread); ++j)
+        for (int i = std::max(0, x - iSpread); i <= std::min(int(uiWidth) - 1, x + iSpread); ++i)
+        {
+            if ((lCoverage[i + j*uiWidth] >= 0.5f) != bInside)
+                iMinDist2 = std::min(iMinDist2, (i - x)*(i - x) + (j - y)*(j - y));
+        }
+
+        float fDistance;
+        if (iMinDist2 == 1)
+        {
+            // Texels on the edge : the coverage is more accurate
+            fDistance = fCoverage - 0.5f;
+        }
+        else
+        {
+            fDistance = sqrt(float(iMinDist2)) - 0.5f;
+            if (!bInside)
+                fDistance = -fDistance;
+        }
+
+        int iAlpha = 128 + int(fDistance*127.0f/iSpread);
+        iAlpha = std::max(0, std::min(255, iAlpha));
+
+        set_texture_alpha_(mRect.left - iSpread + x, mRect.top - iSpread + y, iAlpha);
+    }
+}
+
+bool font::pack_character_(uint uiWidth, quad2i& mRect) const
+{
+    // All characters have the same height : they are packed in rows,
+    // each row being filled from left to right. The padding is reserved
+    // around each character, but not included in the returned rect.
+    uint uiCellWidth = uiWidth + 2*uiPadding_;
+    uint uiCellHeight = uiMaxHeight_ + 2*uiPadding_;
+    uint uiRowHeight = uiCellHeight + uiSpacing_;
+
+    while (true)
+    {
+        for (uint i = 0; i < lRowList_.size(); ++i)
+        {
+            if (lRowList_[i] + uiCellWidth <= uiTextureWidth_)
+            {
+                mRect = quad2i(
+                    lRowList_[i] + uiPadding_, lRowList_[i] + uiPadding_ + uiWidth,
+                    i*uiRowHeight + uiPadding_, i*uiRowHeight + uiPadding_ + uiMaxHeight_
+                );
+
+                lRowList_[i] += uiCellWidth + uiSpacing_;
+                return true;
+            }
+        }
+
+        if (lRowList_.size()*uiRowHeight + uiCellHeight <= uiTextureHeight_)
+            lRowList_.push_back(0u);
+        else if (!grow_texture_())
+            return false;
+    }
+}
+
+bool font::grow_texture_() const
+{
+    uint uiNewWidth = uiTextureWidth_;
+    uint uiNewHeight = uiTextureHeight_;
+    if (uiTextureHeight_ < uiTextureWidth_)
+        uiNewHeight += uiNewHeight;
+    else
+        uiNewWidth += uiNewWidth;
+
+    if (!resize_texture_(uiNewWidth, uiNewHeight))
+        return false;
+
+    uiTextureWidth_ = uiNewWidth;
+    uiTextureHeight_ = uiNewHeight;
+    ++uiTextureRevision_;
+
+    return true;
+}
+}
+}
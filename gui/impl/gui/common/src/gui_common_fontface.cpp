@@ -0,0 +1,62 @@
+#include "lxgui/impl/gui_common_fontface.hpp"
+#include <lxgui/gui_manager.hpp>
+#include <lxgui/utils_filesystem.hpp>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+namespace gui {
+namespace common
+{
+// The FreeType library shared by all faces
+static FT_Library mLibrary = nullptr;
+static uint       uiFaceCount = 0u;
+
+font_face::font_face(const std::string& sFontFile) : sFontFile_(sFontFile), pFace_(nullptr)
+{
+    if (!utils::file_exists(sFontFile))
+        throw gui::exception("gui::common::font_face", "Cannot find file \""+sFontFile+"\".");
+
+    if (uiFaceCount == 0u && FT_Init_FreeType(&mLibrary))
+        throw gui::exception("gui::common::font_face", "Error initializing FreeType !");
+
+    // FreeType maps the file in memory when it can
+    if (FT_New_Face(mLibrary, sFontFile.c_str(), 0, &pFace_))
+    {
+        if (uiFaceCount == 0u)
+        {
+            FT_Done_FreeType(mLibrary);
+            mLibrary = nullptr;
+        }
+
+        throw gui::exception("gui::common::font_face", "Error loading font : \""+sFontFile+
+            "\" : cannot load face."
+        );
+    }
+
+    ++uiFaceCount;
+}
+
+font_face::~font_face()
+{
+    FT_Done_Face(pFace_);
+
+    --uiFaceCount;
+    if (uiFaceCount == 0u)
+    {
+        FT_Done_FreeType(mLibrary);
+        mLibrary = nullptr;
+    }
+}
+
+const std::string& font_face::get_file() const
+{
+    return sFontFile_;
+}
+
+FT_FaceRec_* font_face::get_face() const
+{
+    return pFace_;
+}
+}
+}
@@ -0,0 +1,111 @@
+#include "lxgui/impl/gui_common_png.hpp"
+#include <lxgui/utils_exception.hpp>
+
+#include <png.h>
+#include <fstream>
+#include <vector>
+
+namespace gui {
+namespace common
+{
+const uint PNGSIGSIZE = 8;
+
+void raise_error(png_struct* png, char const* message)
+{
+    throw utils::exception(message);
+}
+
+void read_data(png_structp pReadStruct, png_bytep pData, png_size_t uiLength)
+{
+    png_voidp p = png_get_io_ptr(pReadStruct);
+    ((std::ifstream*)p)->read((char*)pData, uiLength);
+}
+
+bool check_png_signature(std::ifstream& mFile)
+{
+    png_byte lSignature[PNGSIGSIZE];
+    mFile.read((char*)lSignature, PNGSIGSIZE);
+    return mFile.good() && png_sig_cmp(lSignature, 0, PNGSIGSIZE) == 0;
+}
+
+struct png_reader::png_data
+{
+    png_structp pReadStruct;
+    png_infop   pInfoStruct;
+};
+
+png_reader::png_reader(std::ifstream& mFile) : pData_(new png_data()), uiWidth_(0u), uiHeight_(0u)
+{
+    pData_->pReadStruct = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, raise_error, nullptr);
+    if (!pData_->pReadStruct)
+    {
+        delete pData_;
+        throw utils::exception("'png_create_read_struct' failed.");
+    }
+
+    pData_->pInfoStruct = png_create_info_struct(pData_->pReadStruct);
+    if (!pData_->pInfoStruct)
+    {
+        png_destroy_read_struct(&pData_->pReadStruct, nullptr, nullptr);
+        delete pData_;
+        throw utils::exception("'png_create_info_struct' failed.");
+    }
+
+    png_set_read_fn(pData_->pReadStruct, (png_voidp)(&mFile), read_data);
+    png_set_sig_bytes(pData_->pReadStruct, PNGSIGSIZE);
+}
+
+png_reader::~png_reader()
+{
+    png_destroy_read_struct(&pData_->pReadStruct, &pData_->pInfoStruct, nullptr);
+    delete pData_;
+}
+
+void png_reader::read_header()
+{
+    png_structp pReadStruct = pData_->pReadStruct;
+    png_infop pInfoStruct = pData_->pInfoStruct;
+
+    png_read_info(pReadStruct, pInfoStruct);
+
+    png_uint_32 uiDepth = png_get_bit_depth(pReadStruct, pInfoStruct);
+
+    if (uiDepth != 8)
+        throw utils::exception("only 8 bit color chanels are supported for PNG images.");
+
+    png_uint_32 uiChannels = png_get_channels(pReadStruct, pInfoStruct);
+
+    if (uiChannels != 4 && uiChannels != 3)
+        throw utils::exception("only RGB or RGBA is supported for PNG images.");
+
+    png_uint_32 uiColorType = png_get_color_type(pReadStruct, pInfoStruct);
+
+    if (uiColorType == PNG_COLOR_TYPE_RGB)
+        png_set_filler(pReadStruct, 0xff, PNG_FILLER_AFTER);
+    else if (uiColorType != PNG_COLOR_TYPE_RGBA)
+        throw utils::exception("only RGB or RGBA is supported for PNG images.");
+
+    uiWidth_  = png_get_image_width(pReadStruct, pInfoStruct);
+    uiHeight_ = png_get_image_height(pReadStruct, pInfoStruct);
+}
+
+void png_reader::read_image(uchar* pData)
+{
+    std::vector<png_bytep> lRows(uiHeight_);
+    for (uint i = 0; i < uiHeight_; ++i)
+        lRows[i] = (png_bytep)(pData + 4*i*uiWidth_);
+
+    png_read_image(pData_->pReadStruct, lRows.data());
+}
+
+uint png_reader::get_width() const
+{
+    return uiWidth_;
+}
+
+uint png_reader::get_height() const
+{
+    return uiHeight_;
+}
+}
+}
@@ -2,6 +2,8 @@
 #include "lxgui/impl/gui_gl_material.hpp"
 #include "lxgui/impl/gui_gl_rendertarget.hpp"
 #include "lxgui/impl/gui_gl_font.hpp"
+#include "lxgui/impl/gui_common_fontface.hpp"
+#include "lxgui/impl/gui_gl_scaledfont.hpp"
 #include <lxgui/gui_sprite.hpp>
 #include <lxgui/gui_out.hpp>
 #include <lxgui/utils_string.hpp>
@@ -12,26 +14,136 @@
 #include <GL/glew.h>
 #include <GL/gl.h>
 #include <cstring>
+#include <cstddef>
+#include <algorithm>
+#ifndef NO_CPP11_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
 
 namespace gui {
 namespace gl
 {
+static void set_blend_mode(blend_mode mBlend)
+{
+    // Colors are premultiplied
+    switch (mBlend)
+    {
+        case BLEND_ADD : glBlendFunc(GL_ONE, GL_ONE); break;
+        case BLEND_MUL : glBlendFunc(GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA); break;
+        default :        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA); break;
+    }
+}
+
+// The size at which distance field fonts are rendered
+const uint DISTANCE_FIELD_FONT_SIZE = 32u;
+
+// Shaders used to render distance field materials. The edge of the shapes
+// is where alpha is 0.5, and fwidth() is used to keep it one pixel wide
+// at any scale. Colors are premultiplied.
+const char* DISTANCE_FIELD_VERTEX_SHADER =
+    "#version 110\n"
+    "void main()\n"
+    "{\n"
+    "    gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+    "    gl_FrontColor = gl_Color;\n"
+    "    gl_Position = ftransform();\n"
+    "}\n";
+
+const char* DISTANCE_FIELD_FRAGMENT_SHADER =
+    "#version 110\n"
+    "uniform sampler2D mTexture;\n"
+    "uniform float fOutline;\n"
+    "void main()\n"
+    "{\n"
+    "    float fDist = texture2D(mTexture, gl_TexCoord[0].st).a;\n"
+    "    float fWidth = 0.5*fwidth(fDist);\n"
+    "    float fFill = smoothstep(0.5 - fWidth, 0.5 + fWidth, fDist);\n"
+    "    float fShape = smoothstep(0.5 - fOutline - fWidth, 0.5 - fOutline + fWidth, fDist);\n"
+    "    gl_FragColor = gl_Color*fFill + vec4(0.0, 0.0, 0.0, gl_Color.a)*(fShape - fFill);\n"
+    "}\n";
+
+struct manager::decoder
+{
+    decoder() : bStop(false) {}
+
+    std::deque<texture_job*> lQueue;
+#ifndef NO_CPP11_THREADS
+    std::vector<std::thread> lThreadList;
+    std::mutex               mMutex;
+    std::condition_variable  mCondition;
+#endif
+    bool                     bStop;
+};
+
 manager::manager(bool bInitGLEW) :
-    bUpdateViewMatrix_(true)
+    bUpdateViewMatrix_(true), bBatching_(true), bVBOSupported_(false), uiVBOHandle_(0),
+    uiBatchCount_(0), bDistanceFieldFonts_(false), uiDistanceFieldProgram_(0),
+    iOutlineLocation_(-1), bProgramActive_(false), bAsyncLoading_(false),
+    uiUploadBudget_(4u*1024u*1024u), pDecoder_(new decoder())
 {
     if (bInitGLEW)
         glewInit();
 
     render_target::check_availability();
     material::check_availability();
+
+    // The buffer functions used here (glGenBuffers(), ...) are those of
+    // OpenGL 1.5 : the ARB extension has different entry points
+    bVBOSupported_ = GLEW_VERSION_1_5;
+    if (bVBOSupported_)
+        glGenBuffers(1, &uiVBOHandle_);
+
+    // The shader functions used here (glCreateProgram(), ...) are those of
+    // OpenGL 2.0 : the ARB extensions have different entry points
+    if (GLEW_VERSION_2_0)
+        create_distance_field_program_();
 }
 
 manager::~manager()
 {
+    {
+        // Pending textures are not needed anymore
+#ifndef NO_CPP11_THREADS
+        std::unique_lock<std::mutex> mLock(pDecoder_->mMutex);
+#endif
+        pDecoder_->lQueue.clear();
+    }
+
+    stop_decoding_threads_();
+    delete pDecoder_;
+
+    // Fonts can outlive this manager
+    std::map<std::string, utils::wptr<gui::font>>::iterator iterFont;
+    foreach (iterFont, lFontList_)
+    {
+        utils::refptr<gl::font> pFont = utils::refptr<gl::font>::dyn_cast(iterFont->second.lock());
+        if (pFont)
+            pFont->set_manager(nullptr);
+    }
+
+    std::map<std::string, utils::wptr<gl::font>>::iterator iterBase;
+    foreach (iterBase, lDistanceFieldFontList_)
+    {
+        if (utils::refptr<gl::font> pFont = iterBase->second.lock())
+            pFont->set_manager(nullptr);
+    }
+
+    if (uiVBOHandle_ != 0)
+        glDeleteBuffers(1, &uiVBOHandle_);
+
+    if (uiDistanceFieldProgram_ != 0)
+        glDeleteProgram(uiDistanceFieldProgram_);
 }
 
 void manager::begin(utils::refptr<gui::render_target> pTarget) const
 {
+    flush_batches_();
+    uiBatchCount_ = 0;
+
+    glDisable(GL_SCISSOR_TEST);
+
     if (pTarget)
     {
         pCurrentTarget_ = utils::refptr<gl::render_target>::cast(pTarget);
@@ -77,6 +189,10 @@ void manager::update_view_matrix_() const
 
 void manager::end() const
 {
+    flush_batches_();
+
+    glDisable(GL_SCISSOR_TEST);
+
     if (pCurrentTarget_)
     {
         pCurrentTarget_->end();
@@ -84,92 +200,460 @@ void manager::end() const
     }
 }
 
+bool manager::set_scissor(const quad2i& mArea) const
+{
+    flush_batches_();
+
+    glEnable(GL_SCISSOR_TEST);
+
+    if (pCurrentTarget_)
+    {
+        // Render targets are not flipped
+        glScissor(mArea.left, mArea.top, mArea.width(), mArea.height());
+    }
+    else
+    {
+        glScissor(
+            mArea.left, int(pParent_->get_screen_height()) - mArea.bottom,
+            mArea.width(), mArea.height()
+        );
+    }
+
+    return true;
+}
+
+void manager::disable_scissor() const
+{
+    flush_batches_();
+
+    glDisable(GL_SCISSOR_TEST);
+}
+
 void manager::render_quad(const quad& mQuad) const
 {
-    static const std::array<uint, 6> ids = {{0, 1, 2, 2, 3, 0}};
+    if (!mQuad.mat->is_ready())
+        return;
 
-    glColor4ub(255, 255, 255, 255);
+    add_quad_(mQuad, mQuad.v, vector2f::ZERO);
+
+    if (!bBatching_)
+        flush_batches_();
+}
+
+void manager::render_quads(const quad& mQuad, const std::vector<std::array<vertex,4>>& lQuadList,
+    const vector2f& mOffset) const
+{
+    if (lQuadList.empty() || !mQuad.mat->is_ready())
+        return;
 
+    lBatchVertexList_.reserve(lBatchVertexList_.size() + 6*lQuadList.size());
+
+    std::vector<std::array<vertex,4>>::const_iterator iter;
+    foreach (iter, lQuadList)
+        add_quad_(mQuad, *iter, mOffset);
+
+    if (!bBatching_)
+        flush_batches_();
+}
+
+manager::batch& manager::get_batch_(const quad& mQuad) const
+{
     utils::refptr<gl::material> pMat = utils::refptr<gl::material>::cast(mQuad.mat);
-    if (pMat->get_type() == gl::material::TYPE_TEXTURE)
+
+    if (!lBatchList_.empty())
     {
-        pMat->bind();
+        // Plain color materials are baked in the vertex colors, so they
+        // can all share the same batch
+        batch& mLast = lBatchList_.back();
+        if (mLast.mBlend == mQuad.blend)
+        {
+            if (pMat->get_type() == gl::material::TYPE_COLOR)
+            {
+                if (mLast.pMaterial->get_type() == gl::material::TYPE_COLOR)
+                    return mLast;
+            }
+            else if (mLast.pMaterial == pMat)
+                return mLast;
+        }
+    }
+
+    batch mBatch;
+    mBatch.pMaterial = pMat;
+    mBatch.mBlend = mQuad.blend;
+    mBatch.uiFirst = lBatchVertexList_.size();
+    mBatch.uiCount = 0;
+    lBatchList_.push_back(mBatch);
+
+    return lBatchList_.back();
+}
 
-        glEnable(GL_TEXTURE_2D);
-        glBegin(GL_TRIANGLES);
+void manager::add_quad_(const quad& mQuad, const std::array<vertex,4>& lVertexList, const vector2f& mOffset) const
+{
+    static const std::array<uint, 6> ids = {{0, 1, 2, 2, 3, 0}};
+
+    batch& mBatch = get_batch_(mQuad);
+
+    batch_vertex mVertex;
+    if (mBatch.pMaterial->get_type() == gl::material::TYPE_TEXTURE)
+    {
         for (uint i = 0; i < 6; ++i)
         {
-            uint j = ids[i];
-            float a = mQuad.v[j].col.a;
-            glColor4f(mQuad.v[j].col.r*a, mQuad.v[j].col.g*a, mQuad.v[j].col.b*a, a); // Premultipled alpha
-            glTexCoord2f(mQuad.v[j].uvs.x, mQuad.v[j].uvs.y);
-            glVertex2f(mQuad.v[j].pos.x, mQuad.v[j].pos.y);
+            const vertex& v = lVertexList[ids[i]];
+            float a = v.col.a;
+            mVertex.x = v.pos.x + mOffset.x; mVertex.y = v.pos.y + mOffset.y;
+            mVertex.u = v.uvs.x; mVertex.v = v.uvs.y;
+            mVertex.r = v.col.r*a; mVertex.g = v.col.g*a; mVertex.b = v.col.b*a; mVertex.a = a; // Premultipled alpha
+            lBatchVertexList_.push_back(mVertex);
         }
-        glEnd();
     }
     else
     {
-        glDisable(GL_TEXTURE_2D);
-        glBegin(GL_TRIANGLES);
+        color mMatColor = utils::refptr<gl::material>::cast(mQuad.mat)->get_color();
         for (uint i = 0; i < 6; ++i)
         {
-            uint j = ids[i];
-            color c = mQuad.v[j].col*pMat->get_color();
-            c.r *= c.a; c.g *= c.a; c.b *= c.a;  // Premultipled alpha
-            glColor4f(c.r, c.g, c.b, c.a);
-            glVertex2f(mQuad.v[j].pos.x, mQuad.v[j].pos.y);
+            const vertex& v = lVertexList[ids[i]];
+            color c = v.col*mMatColor;
+            mVertex.x = v.pos.x + mOffset.x; mVertex.y = v.pos.y + mOffset.y;
+            mVertex.u = 0.0f; mVertex.v = 0.0f;
+            mVertex.r = c.r*c.a; mVertex.g = c.g*c.a; mVertex.b = c.b*c.a; mVertex.a = c.a; // Premultipled alpha
+            lBatchVertexList_.push_back(mVertex);
         }
-        glEnd();
     }
+
+    mBatch.uiCount += 6;
 }
 
-void manager::render_quads(const quad& mQuad, const std::vector<std::array<vertex,4>>& lQuadList) const
+void manager::flush_batches_() const
 {
-    static const std::array<uint, 6> ids = {{0, 1, 2, 2, 3, 0}};
+    if (lBatchList_.empty())
+        return;
+
+    const GLsizei uiStride = sizeof(batch_vertex);
+    const char* pData;
+
+    if (bVBOSupported_)
+    {
+        // Re-specifying the whole buffer lets the driver orphan the previous
+        // one instead of waiting for the previous draw calls to complete
+        glBindBuffer(GL_ARRAY_BUFFER, uiVBOHandle_);
+        glBufferData(GL_ARRAY_BUFFER, lBatchVertexList_.size()*uiStride, lBatchVertexList_.data(), GL_STREAM_DRAW);
+        pData = nullptr;
+    }
+    else
+        pData = reinterpret_cast<const char*>(lBatchVertexList_.data());
 
     glColor4ub(255, 255, 255, 255);
 
-    utils::refptr<gl::material> pMat = utils::refptr<gl::material>::cast(mQuad.mat);
-    if (pMat->get_type() == gl::material::TYPE_TEXTURE)
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, uiStride, pData + offsetof(batch_vertex, x));
+    glTexCoordPointer(2, GL_FLOAT, uiStride, pData + offsetof(batch_vertex, u));
+    glColorPointer(4, GL_FLOAT, uiStride, pData + offsetof(batch_vertex, r));
+
+    blend_mode mBlend = BLEND_NORMAL;
+
+    std::vector<batch>::const_iterator iter;
+    foreach (iter, lBatchList_)
     {
-        pMat->bind();
+        if (iter->mBlend != mBlend)
+        {
+            mBlend = iter->mBlend;
+            set_blend_mode(mBlend);
+        }
+
+        use_material_program_(*iter->pMaterial);
 
-        glEnable(GL_TEXTURE_2D);
-        glBegin(GL_TRIANGLES);
-        std::vector<std::array<vertex,4>>::const_iterator iter;
-        foreach (iter, lQuadList)
+        if (iter->pMaterial->get_type() == gl::material::TYPE_TEXTURE)
         {
-            const std::array<vertex,4>& v = *iter;
-            for (uint i = 0; i < 6; ++i)
-            {
-                uint j = ids[i];
-                float a = v[j].col.a;
-                glColor4f(v[j].col.r*a, v[j].col.g*a, v[j].col.b*a, a); // Premultipled alpha
-                glTexCoord2f(v[j].uvs.x, v[j].uvs.y);
-                glVertex2f(v[j].pos.x, v[j].pos.y);
-            }
+            iter->pMaterial->bind();
+            glEnable(GL_TEXTURE_2D);
+            glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        }
+        else
+        {
+            glDisable(GL_TEXTURE_2D);
+            glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        }
+
+        glDrawArrays(GL_TRIANGLES, iter->uiFirst, iter->uiCount);
+        ++uiBatchCount_;
+    }
+
+    if (bProgramActive_)
+    {
+        glUseProgram(0);
+        bProgramActive_ = false;
+    }
+
+    if (mBlend != BLEND_NORMAL)
+        set_blend_mode(BLEND_NORMAL);
+
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    if (bVBOSupported_)
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    lBatchList_.clear();
+    lBatchVertexList_.clear();
+}
+
+void manager::create_distance_field_program_()
+{
+    const char* lSourceList[2] = {DISTANCE_FIELD_VERTEX_SHADER, DISTANCE_FIELD_FRAGMENT_SHADER};
+    const GLenum lTypeList[2] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER};
+
+    uint uiProgram = glCreateProgram();
+
+    for (uint i = 0; i < 2; ++i)
+    {
+        uint uiShader = glCreateShader(lTypeList[i]);
+        glShaderSource(uiShader, 1, &lSourceList[i], nullptr);
+        glCompileShader(uiShader);
+
+        GLint iCompiled = 0;
+        glGetShaderiv(uiShader, GL_COMPILE_STATUS, &iCompiled);
+        if (!iCompiled)
+        {
+            char sLog[512];
+            glGetShaderInfoLog(uiShader, sizeof(sLog), nullptr, sLog);
+            gui::out << gui::warning << "gui::gl::manager : Cannot compile distance field shader, "
+                "distance field fonts are disabled :\n" << sLog << std::endl;
+
+            glDeleteShader(uiShader);
+            glDeleteProgram(uiProgram);
+            return;
         }
-        glEnd();
+
+        // The shader is deleted with the program
+        glAttachShader(uiProgram, uiShader);
+        glDeleteShader(uiShader);
     }
+
+    glLinkProgram(uiProgram);
+
+    GLint iLinked = 0;
+    glGetProgramiv(uiProgram, GL_LINK_STATUS, &iLinked);
+    if (!iLinked)
+    {
+        gui::out << gui::warning << "gui::gl::manager : Cannot link distance field shader, "
+            "distance field fonts are disabled." << std::endl;
+
+        glDeleteProgram(uiProgram);
+        return;
+    }
+
+    uiDistanceFieldProgram_ = uiProgram;
+    iOutlineLocation_ = glGetUniformLocation(uiProgram, "fOutline");
+
+    glUseProgram(uiProgram);
+    glUniform1i(glGetUniformLocation(uiProgram, "mTexture"), 0);
+    glUseProgram(0);
+}
+
+void manager::use_material_program_(const gl::material& mMat) const
+{
+    if (mMat.get_type() == gl::material::TYPE_TEXTURE && mMat.is_distance_field() &&
+        uiDistanceFieldProgram_ != 0)
+    {
+        if (!bProgramActive_)
+        {
+            glUseProgram(uiDistanceFieldProgram_);
+            bProgramActive_ = true;
+        }
+
+        glUniform1f(iOutlineLocation_, mMat.get_distance_field_outline());
+    }
+    else if (bProgramActive_)
+    {
+        glUseProgram(0);
+        bProgramActive_ = false;
+    }
+}
+
+void manager::enable_distance_field_fonts(bool bEnable)
+{
+    if (bEnable && uiDistanceFieldProgram_ == 0)
+    {
+        gui::out << gui::warning << "gui::gl::manager : Shaders are not supported, "
+            "cannot enable distance field fonts." << std::endl;
+        return;
+    }
+
+    bDistanceFieldFonts_ = bEnable;
+}
+
+bool manager::is_distance_field_fonts_enabled() const
+{
+    return bDistanceFieldFonts_;
+}
+
+void manager::enable_batching(bool bEnable)
+{
+    if (bBatching_ != bEnable)
+    {
+        flush_batches_();
+        bBatching_ = bEnable;
+    }
+}
+
+bool manager::is_batching_enabled() const
+{
+    return bBatching_;
+}
+
+uint manager::get_batch_count() const
+{
+    return uiBatchCount_;
+}
+
+void manager::enable_async_loading(bool bEnable)
+{
+    if (bAsyncLoading_ == bEnable)
+        return;
+
+    bAsyncLoading_ = bEnable;
+
+    if (bAsyncLoading_)
+        start_decoding_threads_();
     else
     {
-        glDisable(GL_TEXTURE_2D);
-        glBegin(GL_TRIANGLES);
-        std::vector<std::array<vertex,4>>::const_iterator iter;
-        foreach (iter, lQuadList)
+        // The threads finish decoding the queued textures before exiting
+        stop_decoding_threads_();
+
+        while (!lTextureJobList_.empty())
         {
-            const std::array<vertex,4>& v = *iter;
-            for (uint i = 0; i < 6; ++i)
-            {
-                uint j = ids[i];
-                color c = v[j].col*pMat->get_color();
-                c.r *= c.a; c.g *= c.a; c.b *= c.a; // Premultipled alpha
-                glColor4f(c.r, c.g, c.b, c.a);
-                glVertex2f(v[j].pos.x, v[j].pos.y);
-            }
+            upload_texture_(*lTextureJobList_.front());
+            lTextureJobList_.pop_front();
+        }
+    }
+}
+
+bool manager::is_async_loading_enabled() const
+{
+    return bAsyncLoading_;
+}
+
+void manager::set_texture_upload_budget(uint uiBytes)
+{
+    uiUploadBudget_ = uiBytes;
+}
+
+uint manager::get_texture_upload_budget() const
+{
+    return uiUploadBudget_;
+}
+
+void manager::update()
+{
+    uint uiUploaded = 0u;
+    while (!lTextureJobList_.empty() && (uiUploaded == 0u || uiUploaded < uiUploadBudget_))
+    {
+        texture_job& mJob = *lTextureJobList_.front();
+        if (!is_texture_job_done_(mJob))
+            break;
+
+        uiUploaded += mJob.pTexture->get_data().size()*sizeof(ub32color);
+        upload_texture_(mJob);
+        lTextureJobList_.pop_front();
+    }
+}
+
+void manager::start_decoding_threads_()
+{
+#ifndef NO_CPP11_THREADS
+    uint uiThreadCount = std::thread::hardware_concurrency();
+    uiThreadCount = (uiThreadCount > 1u ? uiThreadCount - 1u : 1u);
+
+    for (uint i = 0; i < uiThreadCount; ++i)
+        pDecoder_->lThreadList.push_back(std::thread(&manager::run_decoding_thread_, this));
+#endif
+}
+
+void manager::stop_decoding_threads_()
+{
+#ifndef NO_CPP11_THREADS
+    {
+        std::unique_lock<std::mutex> mLock(pDecoder_->mMutex);
+        pDecoder_->bStop = true;
+    }
+
+    pDecoder_->mCondition.notify_all();
+
+    std::vector<std::thread>::iterator iterThread;
+    foreach (iterThread, pDecoder_->lThreadList)
+        iterThread->join();
+
+    pDecoder_->lThreadList.clear();
+    pDecoder_->bStop = false;
+#endif
+}
+
+void manager::run_decoding_thread_() const
+{
+#ifndef NO_CPP11_THREADS
+    while (true)
+    {
+        texture_job* pJob;
+        {
+            std::unique_lock<std::mutex> mLock(pDecoder_->mMutex);
+            while (pDecoder_->lQueue.empty() && !pDecoder_->bStop)
+                pDecoder_->mCondition.wait(mLock);
+
+            if (pDecoder_->lQueue.empty())
+                return;
+
+            pJob = pDecoder_->lQueue.front();
+            pDecoder_->lQueue.pop_front();
         }
-        glEnd();
+
+        decode_png_(*pJob);
+
+        std::unique_lock<std::mutex> mLock(pDecoder_->mMutex);
+        pJob->bDone = true;
+    }
+#endif
+}
+
+void manager::queue_texture_job_(texture_job& mJob) const
+{
+#ifdef NO_CPP11_THREADS
+    // No thread to decode the texture : it is still uploaded by update()
+    decode_png_(mJob);
+    mJob.bDone = true;
+#else
+    {
+        std::unique_lock<std::mutex> mLock(pDecoder_->mMutex);
+        pDecoder_->lQueue.push_back(&mJob);
+    }
+
+    pDecoder_->mCondition.notify_one();
+#endif
+}
+
+bool manager::is_texture_job_done_(const texture_job& mJob) const
+{
+#ifndef NO_CPP11_THREADS
+    std::unique_lock<std::mutex> mLock(pDecoder_->mMutex);
+#endif
+    return mJob.bDone;
+}
+
+void manager::upload_texture_(texture_job& mJob) const
+{
+    if (!mJob.sError.empty())
+    {
+        gui::out << gui::error << "gui::gl::manager : Parsing " << mJob.sFileName << " :\n"
+            << mJob.sError << std::endl;
+
+        std::vector<ub32color>& lData = mJob.pTexture->get_data();
+        std::fill(lData.begin(), lData.end(), ub32color(0, 0, 0, 0));
     }
+
+    mJob.pTexture->update_texture();
+    mJob.pTexture->clear_cache_data_();
+    mJob.pTexture->set_ready_(true);
 }
 
 utils::refptr<gui::material> manager::create_material(const std::string& sFileName, filter mFilter) const
@@ -212,6 +696,9 @@ utils::refptr<gui::render_target> manager::create_render_target(uint uiWidth, ui
 utils::refptr<gui::font> manager::create_font(const std::string& sFontFile, uint uiSize) const
 {
     std::string sFontName = sFontFile + "|" + utils::to_string(uiSize);
+    if (bDistanceFieldFonts_)
+        sFontName += "|sdf";
+
     std::map<std::string, utils::wptr<gui::font>>::iterator iter = lFontList_.find(sFontName);
     if (iter != lFontList_.end())
     {
@@ -221,7 +708,44 @@ utils::refptr<gui::font> manager::create_font(const std::string& sFontFile, uint
             lFontList_.erase(iter);
     }
 
-    utils::refptr<gui::font> pFont(new gl::font(sFontFile, uiSize));
+    // All the sizes of a font file share the same face
+    utils::refptr<common::font_face> pFace;
+    std::map<std::string, utils::wptr<common::font_face>>::iterator iterFace = lFontFaceList_.find(sFontFile);
+    if (iterFace != lFontFaceList_.end())
+        pFace = iterFace->second.lock();
+
+    if (!pFace)
+    {
+        pFace = utils::refptr<common::font_face>(new common::font_face(sFontFile));
+        lFontFaceList_[sFontFile] = pFace;
+    }
+
+    utils::refptr<gui::font> pFont;
+    if (bDistanceFieldFonts_)
+    {
+        // All the sizes of a font file share the same distance field
+        utils::refptr<gl::font> pBaseFont;
+        std::map<std::string, utils::wptr<gl::font>>::iterator iterBase =
+            lDistanceFieldFontList_.find(sFontFile);
+        if (iterBase != lDistanceFieldFontList_.end())
+            pBaseFont = iterBase->second.lock();
+
+        if (!pBaseFont)
+        {
+            pBaseFont = utils::refptr<gl::font>(new gl::font(pFace, DISTANCE_FIELD_FONT_SIZE, true));
+            pBaseFont->set_manager(this);
+            lDistanceFieldFontList_[sFontFile] = pBaseFont;
+        }
+
+        pFont = utils::refptr<gui::font>(new scaled_font(pBaseFont, uiSize, DISTANCE_FIELD_FONT_SIZE));
+    }
+    else
+    {
+        utils::refptr<gl::font> pGLFont(new gl::font(pFace, uiSize));
+        pGLFont->set_manager(this);
+        pFont = utils::refptr<gui::font>(pGLFont);
+    }
+
     lFontList_[sFontName] = pFont;
     return pFont;
 }
@@ -32,13 +32,14 @@ ub32color::ub32color(chanel r, chanel g, chanel b, chanel a) : r(r), g(g), b(b),
 }
 
 material::material(uint uiWidth, uint uiHeight, wrap mWrap, filter mFilter, bool bGPUOnly) :
-    mType_(TYPE_TEXTURE)
+    mType_(TYPE_TEXTURE), bDistanceField_(false), fOutline_(0.0f)
 {
     pTexData_ = utils::refptr<texture_data>(new texture_data());
     pTexData_->uiWidth_ = uiWidth;
     pTexData_->uiHeight_ = uiHeight;
     pTexData_->mWrap_ = mWrap;
     pTexData_->mFilter_ = mFilter;
+    pTexData_->bReady_ = true;
 
     if (ONLY_POWER_OF_TWO)
     {
@@ -100,18 +101,27 @@ material::material(uint uiWidth, uint uiHeight, wrap mWrap, filter mFilter, bool
         pTexData_->pData_.resize(uiWidth*uiHeight);
 }
 
-material::material(const color& mColor) : mType_(TYPE_COLOR)
+material::material(const color& mColor) : mType_(TYPE_COLOR), bDistanceField_(false), fOutline_(0.0f)
 {
     pColData_ = utils::refptr<color_data>(new color_data());
     pColData_->mColor_ = mColor;
 }
 
+material::material(utils::refptr<material> pBase) : mType_(pBase->mType_),
+    pTexData_(pBase->pTexData_), pColData_(pBase->pColData_),
+    bDistanceField_(pBase->bDistanceField_), fOutline_(pBase->fOutline_)
+{
+}
+
 material::~material()
 {
     switch (mType_)
     {
     case TYPE_TEXTURE :
-        glDeleteTextures(1, &pTexData_->uiTextureHandle_); break;
+        // The texture may be shared with other materials
+        if (pTexData_.get_count() == 1u)
+            glDeleteTextures(1, &pTexData_->uiTextureHandle_);
+        break;
     case TYPE_COLOR :
         break;
     }
@@ -171,6 +181,22 @@ void material::set_filter(filter mFilter)
     glBindTexture(GL_TEXTURE_2D, iPreviousID);
 }
 
+void material::set_distance_field(bool bDistanceField, float fOutline)
+{
+    bDistanceField_ = bDistanceField;
+    fOutline_ = fOutline;
+}
+
+bool material::is_distance_field() const
+{
+    return bDistanceField_;
+}
+
+float material::get_distance_field_outline() const
+{
+    return fOutline_;
+}
+
 void material::bind() const
 {
     glBindTexture(GL_TEXTURE_2D, pTexData_->uiTextureHandle_);
@@ -266,34 +292,45 @@ float material::get_real_height() const
     return 1.0f;
 }
 
-bool material::set_dimensions(uint uiWidth, uint uiHeight)
+bool material::is_ready() const
 {
-    if (uiWidth > pTexData_->uiRealWidth_ || uiHeight > pTexData_->uiRealHeight_)
+    switch (mType_)
     {
+    case TYPE_TEXTURE :
+        return pTexData_->bReady_;
+    case TYPE_COLOR :
+        return true;
+    }
 
-        utils::refptr<texture_data> pOldData = pTexData_;
-        pTexData_ = utils::refptr<texture_data>(new texture_data());
-        pTexData_->uiWidth_  = uiWidth;
-        pTexData_->uiHeight_ = uiHeight;
-        pTexData_->mWrap_    = pOldData->mWrap_;
-        pTexData_->mFilter_  = pOldData->mFilter_;
+    return true;
+}
 
+bool material::set_dimensions(uint uiWidth, uint uiHeight)
+{
+    if (uiWidth > pTexData_->uiRealWidth_ || uiHeight > pTexData_->uiRealHeight_)
+    {
+        uint uiRealWidth, uiRealHeight;
         if (ONLY_POWER_OF_TWO)
         {
-            pTexData_->uiRealWidth_  = pow(2.0f, ceil(log2((float)uiWidth)));
-            pTexData_->uiRealHeight_ = pow(2.0f, ceil(log2((float)uiHeight)));
+            uiRealWidth  = pow(2.0f, ceil(log2((float)uiWidth)));
+            uiRealHeight = pow(2.0f, ceil(log2((float)uiHeight)));
         }
         else
         {
-            pTexData_->uiRealWidth_  = uiWidth;
-            pTexData_->uiRealHeight_ = uiHeight;
+            uiRealWidth  = uiWidth;
+            uiRealHeight = uiHeight;
         }
 
-        if (pTexData_->uiRealWidth_ > MAXIMUM_SIZE || pTexData_->uiRealHeight_ > MAXIMUM_SIZE)
-        {
-            pTexData_ = pOldData;
+        if (uiRealWidth > MAXIMUM_SIZE || uiRealHeight > MAXIMUM_SIZE)
             return false;
-        }
+
+        // The texture data is modified in place, since it can
+        // be shared with other materials
+        pTexData_->uiWidth_      = uiWidth;
+        pTexData_->uiHeight_     = uiHeight;
+        pTexData_->uiRealWidth_  = uiRealWidth;
+        pTexData_->uiRealHeight_ = uiRealHeight;
+        pTexData_->pData_.clear();
 
         glDeleteTextures(1, &pTexData_->uiTextureHandle_);
 
@@ -356,11 +393,31 @@ void material::update_texture()
     glBindTexture(GL_TEXTURE_2D, iPreviousID);
 }
 
+void material::update_texture(uint uiX, uint uiY, uint uiWidth, uint uiHeight)
+{
+    GLint iPreviousID;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &iPreviousID);
+
+    glBindTexture(GL_TEXTURE_2D, pTexData_->uiTextureHandle_);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, pTexData_->uiWidth_);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, uiX, uiY, uiWidth, uiHeight,
+        GL_RGBA, GL_UNSIGNED_BYTE, pTexData_->pData_.data() + uiX + uiY*pTexData_->uiWidth_
+    );
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    glBindTexture(GL_TEXTURE_2D, iPreviousID);
+}
+
 void material::clear_cache_data_()
 {
     pTexData_->pData_.clear();
 }
 
+void material::set_ready_(bool bReady)
+{
+    pTexData_->bReady_ = bReady;
+}
+
 uint material::get_handle_()
 {
     return pTexData_->uiTextureHandle_;
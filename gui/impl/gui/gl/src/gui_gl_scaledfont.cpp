@@ -0,0 +1,67 @@
+#include "lxgui/impl/gui_gl_scaledfont.hpp"
+#include "lxgui/impl/gui_gl_font.hpp"
+#include <lxgui/gui_material.hpp>
+
+namespace gui {
+namespace gl
+{
+scaled_font::scaled_font(utils::refptr<gl::font> pFont, uint uiSize, uint uiBaseSize) :
+    pFont_(pFont), fScale_(uiSize/float(uiBaseSize))
+{
+}
+
+scaled_font::~scaled_font()
+{
+}
+
+quad2f scaled_font::get_character_uvs(char32_t uiChar) const
+{
+    return pFont_->get_character_uvs(uiChar);
+}
+
+float scaled_font::get_character_width(char32_t uiChar) const
+{
+    return pFont_->get_character_width(uiChar)*fScale_;
+}
+
+float scaled_font::get_character_height(char32_t uiChar) const
+{
+    return pFont_->get_character_height(uiChar)*fScale_;
+}
+
+float scaled_font::get_character_kerning(char32_t uiChar1, char32_t uiChar2) const
+{
+    return pFont_->get_character_kerning(uiChar1, uiChar2)*fScale_;
+}
+
+void scaled_font::get_character_widths(const char32_t* pChars, uint uiCount, float* pWidths) const
+{
+    pFont_->get_character_widths(pChars, uiCount, pWidths);
+    for (uint i = 0; i < uiCount; ++i)
+        pWidths[i] *= fScale_;
+}
+
+void scaled_font::get_character_kernings(const char32_t* pChars, uint uiCount, float* pKernings) const
+{
+    pFont_->get_character_kernings(pChars, uiCount, pKernings);
+    for (uint i = 0; i + 1 < uiCount; ++i)
+        pKernings[i] *= fScale_;
+}
+
+utils::wptr<gui::material> scaled_font::get_texture() const
+{
+    return pFont_->get_texture();
+}
+
+uint scaled_font::get_texture_revision() const
+{
+    return pFont_->get_texture_revision();
+}
+
+utils::wptr<gui::material> scaled_font::get_outline_texture(float fThickness) const
+{
+    // The outline is drawn on the base texture
+    return pFont_->get_outline_texture(fThickness/fScale_);
+}
+}
+}
@@ -0,0 +1,68 @@
+#include "lxgui/impl/gui_soft_font.hpp"
+#include "lxgui/impl/gui_soft_material.hpp"
+#include "lxgui/impl/gui_common_fontface.hpp"
+
+namespace gui {
+namespace soft
+{
+font::font(const std::string& sFontFile, uint uiSize) :
+    common::font(utils::refptr<common::font_face>(new common::font_face(sFontFile)))
+{
+    init_(uiSize, false);
+}
+
+font::font(utils::refptr<common::font_face> pFace, uint uiSize) : common::font(pFace)
+{
+    init_(uiSize, false);
+}
+
+font::~font()
+{
+}
+
+void font::create_texture_(uint uiWidth, uint uiHeight)
+{
+    // The texture is created transparent
+    pTexture_ = utils::refptr<soft::material>(new material(uiWidth, uiHeight));
+}
+
+bool font::resize_texture_(uint uiWidth, uint uiHeight) const
+{
+    std::vector<ub32color> lOldData;
+    lOldData.swap(pTexture_->get_data());
+
+    if (!pTexture_->set_dimensions(uiWidth, uiHeight))
+    {
+        pTexture_->get_data().swap(lOldData);
+        return false;
+    }
+
+    std::vector<ub32color>& lData = pTexture_->get_data();
+    for (uint y = 0; y < uiTextureHeight_; ++y)
+    {
+        std::copy(
+            lOldData.begin() + y*uiTextureWidth_, lOldData.begin() + (y + 1)*uiTextureWidth_,
+            lData.begin() + y*uiWidth
+        );
+    }
+
+    return true;
+}
+
+void font::set_texture_alpha_(uint x, uint y, uchar ucAlpha) const
+{
+    // Premultiplied alpha
+    pTexture_->set_pixel(x, y, ub32color(ucAlpha, ucAlpha, ucAlpha, ucAlpha));
+}
+
+void font::update_texture_(const quad2i& mRect) const
+{
+    // The pixels are read directly from the material when rendering
+}
+
+utils::wptr<gui::material> font::get_texture() const
+{
+    return pTexture_;
+}
+}
+}
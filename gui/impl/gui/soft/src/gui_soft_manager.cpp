@@ -0,0 +1,430 @@
+#include "lxgui/impl/gui_soft_manager.hpp"
+#include "lxgui/impl/gui_soft_material.hpp"
+#include "lxgui/impl/gui_soft_rendertarget.hpp"
+#include "lxgui/impl/gui_soft_font.hpp"
+#include "lxgui/impl/gui_common_fontface.hpp"
+#include <lxgui/gui_sprite.hpp>
+#include <lxgui/gui_out.hpp>
+#include <lxgui/utils_string.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+namespace gui {
+namespace soft
+{
+// Blends a constant premultiplied color over a span of pixels.
+// Pixels are processed as packed 32 bit integers, two channels at
+// a time (SWAR). The loop has no branch, so the compiler can also
+// turn it into SIMD code.
+static void blend_span(ub32color* pDst, uint uiCount, const ub32color& mSrc)
+{
+    if (mSrc.a == 255u)
+    {
+        std::fill(pDst, pDst + uiCount, mSrc);
+        return;
+    }
+
+    if (mSrc.a == 0u && mSrc.r == 0u && mSrc.g == 0u && mSrc.b == 0u)
+        return;
+
+    static_assert(sizeof(ub32color) == sizeof(uint32_t), "ub32color must be packed");
+
+    uint32_t uiSrc;
+    std::memcpy(&uiSrc, &mSrc, sizeof(uint32_t));
+
+    const uint32_t uiInvA = 255u - mSrc.a;
+    uint32_t* pData = reinterpret_cast<uint32_t*>(pDst);
+
+    for (uint i = 0; i < uiCount; ++i)
+    {
+        uint32_t uiDst = pData[i];
+
+        // dst*(255 - a)/255, on channels 0 and 2, then 1 and 3
+        uint32_t uiRB = (uiDst & 0x00FF00FFu)*uiInvA + 0x00800080u;
+        uiRB = ((uiRB + ((uiRB >> 8) & 0x00FF00FFu)) >> 8) & 0x00FF00FFu;
+        uint32_t uiAG = ((uiDst >> 8) & 0x00FF00FFu)*uiInvA + 0x00800080u;
+        uiAG = (uiAG + ((uiAG >> 8) & 0x00FF00FFu)) & 0xFF00FF00u;
+
+        // Premultiplied alpha guarantees this addition cannot overflow
+        pData[i] = uiSrc + (uiRB | uiAG);
+    }
+}
+
+static inline int wrap_coord(int i, int iSize, material::wrap mWrap)
+{
+    if (iSize <= 0)
+        return 0;
+
+    if (mWrap == material::REPEAT)
+    {
+        i %= iSize;
+        return i < 0 ? i + iSize : i;
+    }
+    else
+        return i < 0 ? 0 : (i >= iSize ? iSize - 1 : i);
+}
+
+// Returns the premultiplied texel at normalized coordinates (u,v), in [0,255].
+static inline void sample(const material& mTex, float u, float v, float& r, float& g, float& b, float& a)
+{
+    const int iWidth  = mTex.get_width();
+    const int iHeight = mTex.get_height();
+    const material::wrap mWrap = mTex.get_wrap();
+
+    if (iWidth <= 0 || iHeight <= 0)
+    {
+        // Empty materials (e.g. render targets that have not been sized yet)
+        r = g = b = a = 0.0f;
+        return;
+    }
+
+    if (mTex.get_filter() == material::NONE)
+    {
+        const ub32color& c = mTex.get_pixel(
+            wrap_coord(int(std::floor(u*iWidth)),  iWidth,  mWrap),
+            wrap_coord(int(std::floor(v*iHeight)), iHeight, mWrap)
+        );
+        r = c.r; g = c.g; b = c.b; a = c.a;
+    }
+    else
+    {
+        float fX = u*iWidth  - 0.5f;
+        float fY = v*iHeight - 0.5f;
+        float fX0 = std::floor(fX);
+        float fY0 = std::floor(fY);
+        float fWX = fX - fX0;
+        float fWY = fY - fY0;
+
+        int iX0 = wrap_coord(int(fX0),     iWidth,  mWrap);
+        int iX1 = wrap_coord(int(fX0) + 1, iWidth,  mWrap);
+        int iY0 = wrap_coord(int(fY0),     iHeight, mWrap);
+        int iY1 = wrap_coord(int(fY0) + 1, iHeight, mWrap);
+
+        const ub32color& c00 = mTex.get_pixel(iX0, iY0);
+        const ub32color& c10 = mTex.get_pixel(iX1, iY0);
+        const ub32color& c01 = mTex.get_pixel(iX0, iY1);
+        const ub32color& c11 = mTex.get_pixel(iX1, iY1);
+
+        float w00 = (1.0f - fWX)*(1.0f - fWY);
+        float w10 = fWX*(1.0f - fWY);
+        float w01 = (1.0f - fWX)*fWY;
+        float w11 = fWX*fWY;
+
+        r = c00.r*w00 + c10.r*w10 + c01.r*w01 + c11.r*w11;
+        g = c00.g*w00 + c10.g*w10 + c01.g*w01 + c11.g*w11;
+        b = c00.b*w00 + c10.b*w10 + c01.b*w01 + c11.b*w11;
+        a = c00.a*w00 + c10.a*w10 + c01.a*w01 + c11.a*w11;
+    }
+}
+
+manager::manager()
+{
+}
+
+manager::~manager()
+{
+}
+
+void manager::begin(utils::refptr<gui::render_target> pTarget) const
+{
+    if (pTarget)
+        pCurrentTarget_ = utils::refptr<soft::render_target>::cast(pTarget);
+    else
+    {
+        get_screen_target();
+        pCurrentTarget_ = pScreenTarget_;
+    }
+
+    pCurrentTarget_->begin();
+}
+
+void manager::end() const
+{
+    if (pCurrentTarget_)
+    {
+        pCurrentTarget_->end();
+        pCurrentTarget_ = nullptr;
+    }
+}
+
+utils::wptr<soft::render_target> manager::get_screen_target() const
+{
+    if (!pScreenTarget_)
+    {
+        pScreenTarget_ = utils::refptr<soft::render_target>(new soft::render_target(
+            pParent_->get_screen_width(), pParent_->get_screen_height()
+        ));
+    }
+    else
+        pScreenTarget_->set_dimensions(pParent_->get_screen_width(), pParent_->get_screen_height());
+
+    return pScreenTarget_;
+}
+
+bool manager::set_scissor(const quad2i& mArea) const
+{
+    if (!pCurrentTarget_)
+        return false;
+
+    pCurrentTarget_->set_scissor(mArea);
+    return true;
+}
+
+void manager::disable_scissor() const
+{
+    if (pCurrentTarget_)
+        pCurrentTarget_->disable_scissor();
+}
+
+void manager::render_quad(const quad& mQuad) const
+{
+    if (!pCurrentTarget_)
+        return;
+
+    soft::material& mTarget = *pCurrentTarget_->get_material().lock();
+    render_quad_(mQuad, mQuad.v, vector2f::ZERO, mTarget, pCurrentTarget_->get_scissor());
+}
+
+void manager::render_quads(const quad& mQuad, const std::vector<std::array<vertex,4>>& lQuadList,
+    const vector2f& mOffset) const
+{
+    if (lQuadList.empty() || !pCurrentTarget_)
+        return;
+
+    soft::material& mTarget = *pCurrentTarget_->get_material().lock();
+    const quad2i& mClip = pCurrentTarget_->get_scissor();
+
+    std::vector<std::array<vertex,4>>::const_iterator iter;
+    foreach (iter, lQuadList)
+        render_quad_(mQuad, *iter, mOffset, mTarget, mClip);
+}
+
+void manager::render_quad_(const quad& mQuad, const std::array<vertex,4>& lVertexList,
+    const vector2f& mOffset, soft::material& mTarget, const quad2i& mClip) const
+{
+    const soft::material* pMat = static_cast<const soft::material*>(mQuad.mat.get());
+    const soft::material* pTexture = nullptr;
+    color mMatColor = color::WHITE;
+    if (pMat->get_type() == material::TYPE_TEXTURE)
+        pTexture = pMat;
+    else
+        mMatColor = pMat->get_color();
+
+    raster_vertex lRaster[4];
+    for (uint i = 0; i < 4; ++i)
+    {
+        const vertex& v = lVertexList[i];
+        color c = v.col*mMatColor;
+        raster_vertex& r = lRaster[i];
+        r.x = v.pos.x + mOffset.x; r.y = v.pos.y + mOffset.y;
+        r.u = v.uvs.x; r.v = v.uvs.y;
+        r.r = c.r*c.a; r.g = c.g*c.a; r.b = c.b*c.a; r.a = c.a; // Premultipled alpha
+    }
+
+    render_triangle_(lRaster[0], lRaster[1], lRaster[2], pTexture, mTarget, mClip);
+    render_triangle_(lRaster[2], lRaster[3], lRaster[0], pTexture, mTarget, mClip);
+}
+
+void manager::render_triangle_(const raster_vertex& v0, const raster_vertex& v1, const raster_vertex& v2,
+    const soft::material* pTexture, soft::material& mTarget, const quad2i& mClip) const
+{
+    const int iWidth = mTarget.get_width();
+
+    float fArea = (v1.x - v0.x)*(v2.y - v0.y) - (v2.x - v0.x)*(v1.y - v0.y);
+    if (std::fabs(fArea) < 1e-6f)
+        return;
+
+    // Pixels are covered when their center is inside the triangle.
+    // Rows and spans are half-open, so that the two triangles of a
+    // quad (and adjacent quads) never cover the same pixel twice.
+    int iYMin = std::ceil(std::min(v0.y, std::min(v1.y, v2.y)) - 0.5f);
+    int iYMax = std::ceil(std::max(v0.y, std::max(v1.y, v2.y)) - 0.5f);
+    iYMin = std::max(iYMin, mClip.top);
+    iYMax = std::min(iYMax, mClip.bottom);
+    if (iYMin >= iYMax)
+        return;
+
+    // Attributes are linear over the triangle : compute their gradients
+    const float fInvArea = 1.0f/fArea;
+    const float fDY1 = (v1.y - v0.y)*fInvArea, fDY2 = (v2.y - v0.y)*fInvArea;
+    const float fDX1 = (v1.x - v0.x)*fInvArea, fDX2 = (v2.x - v0.x)*fInvArea;
+
+    #define GRADIENT(attr) \
+        const float d##attr##dx = (v1.attr - v0.attr)*fDY2 - (v2.attr - v0.attr)*fDY1; \
+        const float d##attr##dy = (v2.attr - v0.attr)*fDX1 - (v1.attr - v0.attr)*fDX2;
+
+    GRADIENT(u) GRADIENT(v) GRADIENT(r) GRADIENT(g) GRADIENT(b) GRADIENT(a)
+
+    #undef GRADIENT
+
+    bool bFlatColor = !pTexture &&
+        v0.r == v1.r && v0.r == v2.r && v0.g == v1.g && v0.g == v2.g &&
+        v0.b == v1.b && v0.b == v2.b && v0.a == v1.a && v0.a == v2.a;
+
+    ub32color mFlatColor;
+    if (bFlatColor)
+    {
+        mFlatColor = ub32color(
+            std::min(v0.r, 1.0f)*255.0f + 0.5f, std::min(v0.g, 1.0f)*255.0f + 0.5f,
+            std::min(v0.b, 1.0f)*255.0f + 0.5f, std::min(v0.a, 1.0f)*255.0f + 0.5f
+        );
+    }
+
+    const raster_vertex* lEdges[3][2] = {{&v0, &v1}, {&v1, &v2}, {&v2, &v0}};
+
+    ub32color* pData = mTarget.get_data().data();
+
+    for (int y = iYMin; y < iYMax; ++y)
+    {
+        const float fY = y + 0.5f;
+
+        float fXL = 0.0f, fXR = 0.0f;
+        uint uiFound = 0;
+        for (uint i = 0; i < 3; ++i)
+        {
+            const raster_vertex& a = *lEdges[i][0];
+            const raster_vertex& b = *lEdges[i][1];
+            if ((a.y <= fY && fY < b.y) || (b.y <= fY && fY < a.y))
+            {
+                float fX = a.x + (fY - a.y)*(b.x - a.x)/(b.y - a.y);
+                if (uiFound == 0)
+                    fXL = fXR = fX;
+                else
+                {
+                    fXL = std::min(fXL, fX);
+                    fXR = std::max(fXR, fX);
+                }
+                ++uiFound;
+            }
+        }
+
+        if (uiFound < 2)
+            continue;
+
+        int iXMin = std::max(int(std::ceil(fXL - 0.5f)), mClip.left);
+        int iXMax = std::min(int(std::ceil(fXR - 0.5f)), mClip.right);
+        if (iXMin >= iXMax)
+            continue;
+
+        ub32color* pRow = pData + y*iWidth;
+
+        if (bFlatColor)
+        {
+            blend_span(pRow + iXMin, iXMax - iXMin, mFlatColor);
+            continue;
+        }
+
+        const float fOX = iXMin + 0.5f - v0.x;
+        const float fOY = fY - v0.y;
+        float u = v0.u + dudx*fOX + dudy*fOY;
+        float v = v0.v + dvdx*fOX + dvdy*fOY;
+        float r = v0.r + drdx*fOX + drdy*fOY;
+        float g = v0.g + dgdx*fOX + dgdy*fOY;
+        float b = v0.b + dbdx*fOX + dbdy*fOY;
+        float a = v0.a + dadx*fOX + dady*fOY;
+
+        for (int x = iXMin; x < iXMax; ++x)
+        {
+            float sr = r, sg = g, sb = b, sa = a;
+            if (pTexture)
+            {
+                float tr, tg, tb, ta;
+                sample(*pTexture, u, v, tr, tg, tb, ta);
+                const float fNorm = 1.0f/255.0f;
+                sr *= tr*fNorm; sg *= tg*fNorm; sb *= tb*fNorm; sa *= ta*fNorm;
+            }
+
+            sr = std::min(std::max(sr, 0.0f), 1.0f);
+            sg = std::min(std::max(sg, 0.0f), 1.0f);
+            sb = std::min(std::max(sb, 0.0f), 1.0f);
+            sa = std::min(std::max(sa, 0.0f), 1.0f);
+
+            ub32color& d = pRow[x];
+            const float fInvA = 1.0f - sa;
+            d.r = std::min(sr*255.0f + d.r*fInvA + 0.5f, 255.0f);
+            d.g = std::min(sg*255.0f + d.g*fInvA + 0.5f, 255.0f);
+            d.b = std::min(sb*255.0f + d.b*fInvA + 0.5f, 255.0f);
+            d.a = std::min(sa*255.0f + d.a*fInvA + 0.5f, 255.0f);
+
+            u += dudx; v += dvdx;
+            r += drdx; g += dgdx; b += dbdx; a += dadx;
+        }
+    }
+}
+
+utils::refptr<gui::material> manager::create_material(const std::string& sFileName, filter mFilter) const
+{
+    std::string sBackedName = utils::to_string((int)mFilter) + '|' + sFileName;
+    std::map<std::string, utils::wptr<gui::material>>::iterator iter = lTextureList_.find(sBackedName);
+    if (iter != lTextureList_.end())
+    {
+        if (utils::refptr<gui::material> pLock = iter->second.lock())
+            return pLock;
+        else
+            lTextureList_.erase(iter);
+    }
+
+    if (utils::ends_with(sFileName, ".png"))
+    {
+        utils::refptr<gui::material> pMat = create_material_png(sFileName, mFilter);
+        if (pMat)
+            lTextureList_[sBackedName] = pMat;
+
+        return pMat;
+    }
+    else
+    {
+        gui::out << gui::warning << "gui::soft::manager : Unsupported texture format '"
+            << sFileName << "'." << std::endl;
+        return nullptr;
+    }
+}
+
+utils::refptr<gui::material> manager::create_material(const color& mColor) const
+{
+    return utils::refptr<material>(new material(mColor));
+}
+
+utils::refptr<gui::material> manager::create_material(utils::refptr<gui::render_target> pRenderTarget) const
+{
+    return utils::refptr<soft::render_target>::cast(pRenderTarget)->get_material().lock();
+}
+
+utils::refptr<gui::render_target> manager::create_render_target(uint uiWidth, uint uiHeight) const
+{
+    return utils::refptr<gui::render_target>(new soft::render_target(uiWidth, uiHeight));
+}
+
+utils::refptr<gui::font> manager::create_font(const std::string& sFontFile, uint uiSize) const
+{
+    std::string sFontName = sFontFile + "|" + utils::to_string(uiSize);
+    std::map<std::string, utils::wptr<gui::font>>::iterator iter = lFontList_.find(sFontName);
+    if (iter != lFontList_.end())
+    {
+        if (utils::refptr<gui::font> pLock = iter->second.lock())
+            return pLock;
+        else
+            lFontList_.erase(iter);
+    }
+
+    // All the sizes of a font file share the same face
+    utils::refptr<common::font_face> pFace;
+    std::map<std::string, utils::wptr<common::font_face>>::iterator iterFace = lFontFaceList_.find(sFontFile);
+    if (iterFace != lFontFaceList_.end())
+        pFace = iterFace->second.lock();
+
+    if (!pFace)
+    {
+        pFace = utils::refptr<common::font_face>(new common::font_face(sFontFile));
+        lFontFaceList_[sFontFile] = pFace;
+    }
+
+    utils::refptr<gui::font> pFont(new soft::font(pFace, uiSize));
+    lFontList_[sFontName] = pFont;
+    return pFont;
+}
+}
+}
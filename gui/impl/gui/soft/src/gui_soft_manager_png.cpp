@@ -0,0 +1,52 @@
+#include "lxgui/impl/gui_soft_manager.hpp"
+#include "lxgui/impl/gui_soft_material.hpp"
+#include "lxgui/impl/gui_common_png.hpp"
+#include <lxgui/gui_out.hpp>
+
+#include <fstream>
+
+namespace gui {
+namespace soft
+{
+utils::refptr<gui::material> manager::create_material_png(const std::string& sFileName, filter mFilter) const
+{
+    std::ifstream mFile(sFileName, std::ios::binary);
+    if (!mFile.is_open())
+    {
+        gui::out << gui::warning << "gui::soft::manager : Cannot find file '" << sFileName << "'." << std::endl;
+        return nullptr;
+    }
+
+    if (!common::check_png_signature(mFile))
+    {
+        gui::out << gui::warning << "gui::soft::manager : '" << sFileName <<
+            "' is not a valid PNG image." << std::endl;
+        return nullptr;
+    }
+
+    try
+    {
+        common::png_reader mReader(mFile);
+        mReader.read_header();
+
+        utils::refptr<material> pTex(new gui::soft::material(
+            mReader.get_width(), mReader.get_height(), gui::soft::material::REPEAT,
+            (mFilter == FILTER_LINEAR ? gui::soft::material::LINEAR : gui::soft::material::NONE)
+        ));
+
+        mReader.read_image((uchar*)pTex->get_data().data());
+
+        pTex->premultiply_alpha();
+
+        return pTex;
+    }
+    catch (utils::exception& e)
+    {
+        gui::out << gui::error << "gui::soft::manager : Parsing " << sFileName << " :\n"
+            << e.get_description() << std::endl;
+
+        return nullptr;
+    }
+}
+}
+}
@@ -0,0 +1,138 @@
+#include "lxgui/impl/gui_soft_material.hpp"
+
+#include <algorithm>
+
+namespace gui {
+namespace soft
+{
+ub32color::ub32color()
+{
+}
+
+ub32color::ub32color(chanel r, chanel g, chanel b, chanel a) : r(r), g(g), b(b), a(a)
+{
+}
+
+material::material(uint uiWidth, uint uiHeight, wrap mWrap, filter mFilter) :
+    mType_(TYPE_TEXTURE), uiWidth_(uiWidth), uiHeight_(uiHeight), mWrap_(mWrap),
+    mFilter_(mFilter), mColor_(color::WHITE)
+{
+    lData_.resize(uiWidth_*uiHeight_, ub32color(0, 0, 0, 0));
+}
+
+material::material(const color& mColor) :
+    mType_(TYPE_COLOR), uiWidth_(1u), uiHeight_(1u), mWrap_(REPEAT), mFilter_(NONE),
+    mColor_(mColor)
+{
+}
+
+material::~material()
+{
+}
+
+material::type material::get_type() const
+{
+    return mType_;
+}
+
+color material::get_color() const
+{
+    return mColor_;
+}
+
+void material::set_wrap(wrap mWrap)
+{
+    mWrap_ = mWrap;
+}
+
+material::wrap material::get_wrap() const
+{
+    return mWrap_;
+}
+
+void material::set_filter(filter mFilter)
+{
+    mFilter_ = mFilter;
+}
+
+material::filter material::get_filter() const
+{
+    return mFilter_;
+}
+
+const std::vector<ub32color>& material::get_data() const
+{
+    return lData_;
+}
+
+std::vector<ub32color>& material::get_data()
+{
+    return lData_;
+}
+
+void material::set_pixel(uint x, uint y, const ub32color& mColor)
+{
+    lData_[x + y*uiWidth_] = mColor;
+}
+
+const ub32color& material::get_pixel(uint x, uint y) const
+{
+    return lData_[x + y*uiWidth_];
+}
+
+ub32color& material::get_pixel(uint x, uint y)
+{
+    return lData_[x + y*uiWidth_];
+}
+
+void material::premultiply_alpha()
+{
+    std::vector<ub32color>::iterator iter;
+    foreach (iter, lData_)
+    {
+        ub32color& c = *iter;
+        float a = c.a/255.0f;
+        c.r *= a;
+        c.g *= a;
+        c.b *= a;
+    }
+}
+
+float material::get_width() const
+{
+    return uiWidth_;
+}
+
+float material::get_height() const
+{
+    return uiHeight_;
+}
+
+float material::get_real_width() const
+{
+    return uiWidth_;
+}
+
+float material::get_real_height() const
+{
+    return uiHeight_;
+}
+
+bool material::set_dimensions(uint uiWidth, uint uiHeight)
+{
+    if (mType_ != TYPE_TEXTURE)
+        return false;
+
+    if (uiWidth == uiWidth_ && uiHeight == uiHeight_)
+        return false;
+
+    uiWidth_  = uiWidth;
+    uiHeight_ = uiHeight;
+
+    lData_.clear();
+    lData_.resize(uiWidth_*uiHeight_, ub32color(0, 0, 0, 0));
+
+    return true;
+}
+}
+}
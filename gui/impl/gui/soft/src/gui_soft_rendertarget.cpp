@@ -0,0 +1,95 @@
+#include "lxgui/impl/gui_soft_rendertarget.hpp"
+
+#include <algorithm>
+
+namespace gui {
+namespace soft
+{
+render_target::render_target(uint uiWidth, uint uiHeight)
+{
+    pTexture_ = utils::refptr<soft::material>(new soft::material(
+        uiWidth, uiHeight, soft::material::REPEAT, soft::material::NONE
+    ));
+
+    disable_scissor();
+}
+
+render_target::~render_target()
+{
+}
+
+void render_target::begin()
+{
+    disable_scissor();
+}
+
+void render_target::end()
+{
+    disable_scissor();
+}
+
+void render_target::set_scissor(const quad2i& mArea)
+{
+    mScissor_ = mArea;
+    mScissor_.clip(quad2i(0, pTexture_->get_width(), 0, pTexture_->get_height()));
+}
+
+void render_target::disable_scissor()
+{
+    mScissor_ = quad2i(0, pTexture_->get_width(), 0, pTexture_->get_height());
+}
+
+const quad2i& render_target::get_scissor() const
+{
+    return mScissor_;
+}
+
+void render_target::clear(const color& mColor)
+{
+    ub32color mClear(
+        mColor.r*mColor.a*255.0f, mColor.g*mColor.a*255.0f, mColor.b*mColor.a*255.0f, // Premultiplied alpha
+        mColor.a*255.0f
+    );
+
+    if (mScissor_.is_empty())
+        return;
+
+    uint uiWidth = pTexture_->get_width();
+    std::vector<ub32color>::iterator iterRow = pTexture_->get_data().begin() + mScissor_.top*uiWidth;
+    for (int y = mScissor_.top; y < mScissor_.bottom; ++y, iterRow += uiWidth)
+        std::fill(iterRow + mScissor_.left, iterRow + mScissor_.right, mClear);
+}
+
+uint render_target::get_width() const
+{
+    return pTexture_->get_width();
+}
+
+uint render_target::get_height() const
+{
+    return pTexture_->get_height();
+}
+
+uint render_target::get_real_width() const
+{
+    return pTexture_->get_real_width();
+}
+
+uint render_target::get_real_height() const
+{
+    return pTexture_->get_real_height();
+}
+
+bool render_target::set_dimensions(uint uiWidth, uint uiHeight)
+{
+    bool bResized = pTexture_->set_dimensions(uiWidth, uiHeight);
+    disable_scissor();
+    return bResized;
+}
+
+utils::wptr<soft::material> render_target::get_material()
+{
+    return pTexture_;
+}
+}
+}
@@ -43,9 +43,14 @@ void backdrop::set_background(const std::string& sBackgroundFile)
         std::string sFile = pParent_->get_manager()->parse_file_name(sBackgroundFile);
         if (utils::file_exists(sFile))
         {
-            pBackground_ = pParent_->get_manager()->create_sprite(
-                pParent_->get_manager()->create_material(sFile)
-            );
+            utils::refptr<material> pMat = pParent_->get_manager()->create_material(sFile);
+            if (pMat && !pMat->is_ready())
+            {
+                pPendingBackground_ = pMat;
+                pParent_->fire_update();
+            }
+
+            pBackground_ = pParent_->get_manager()->create_sprite(pMat);
             uiTileSize_ = uiOriginalTileSize_ = pBackground_->get_width();
             mBackgroundColor_ = color::EMPTY;
         }
@@ -148,6 +153,11 @@ void backdrop::set_edge(const std::string& sEdgeFile)
         if (utils::file_exists(sFile))
         {
             utils::refptr<material> pMat = pParent_->get_manager()->create_material(sFile);
+            if (pMat && !pMat->is_ready())
+            {
+                pPendingEdge_ = pMat;
+                pParent_->fire_update();
+            }
 
             if (pMat->get_width()/pMat->get_height() == 8.0f)
             {
@@ -393,4 +403,28 @@ void backdrop::render() const
         }
     }
 }
+
+void backdrop::update()
+{
+    bool bReady = false;
+
+    if (pPendingBackground_ && pPendingBackground_.lock()->is_ready())
+    {
+        pPendingBackground_ = nullptr;
+        bReady = true;
+    }
+
+    if (pPendingEdge_ && pPendingEdge_.lock()->is_ready())
+    {
+        pPendingEdge_ = nullptr;
+        bReady = true;
+    }
+
+    if (bReady)
+        pParent_->notify_renderer_need_redraw();
+
+    // Keep checking until the textures are loaded
+    if (pPendingBackground_ || pPendingEdge_)
+        pParent_->fire_update();
+}
 }
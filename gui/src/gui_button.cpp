@@ -65,7 +65,7 @@ bool button::can_use_script(const std::string& sScriptName) const
         return false;
 }
 
-void button::on(const std::string& sScriptName, event* pEvent)
+void button::on(const std::string& sScriptName, const event* pEvent)
 {
     frame::on(sScriptName, pEvent);
 
@@ -15,7 +15,7 @@ namespace gui
 const char* edit_box::CLASS_NAME = "EditBox";
 #endif
 
-edit_box::edit_box(manager* pManager) : focus_frame(pManager),
+edit_box::edit_box(manager* pManager) : focus_frame(pManager), bUpdateText_(false),
     uiDisplayPos_(0), uiNumLetters_(0), uiMaxLetters_(-1), bNumericOnly_(false),
     bPositiveOnly_(false), bIntegerOnly_(false), bPasswordMode_(false),
     bMultiLine_(false), bArrowsIgnored_(false),
@@ -166,6 +166,10 @@ void edit_box::update(float fDelta)
         if (mKeyRepeatTimer_.ticks())
             process_key_(uiLastKeyPressed_);
     }
+
+    // The carret blinks, and the selection follows the mouse
+    if (bFocus_ || bMouseDragged_)
+        fire_update();
 }
 
 void edit_box::on_event(const event& mEvent)
@@ -279,12 +283,13 @@ void edit_box::enable_keyboard(bool bIsKeyboardEnabled)
     frame::enable_keyboard(bIsKeyboardEnabled);
 }
 
-void edit_box::on(const std::string& sScriptName, event* pEvent)
+void edit_box::on(const std::string& sScriptName, const event* pEvent)
 {
     if (bFocus_ && (sScriptName == "KeyUp" || sScriptName == "KeyDown"))
         return;
 
-    if (lDefinedScriptList_.find(sScriptName) != lDefinedScriptList_.end())
+    if (pManager_->is_legacy_script_globals_enabled() &&
+        lDefinedScriptList_.find(sScriptName) != lDefinedScriptList_.end())
     {
         utils::wptr<lua::state> pLua = pManager_->get_lua();
 
@@ -334,10 +339,11 @@ void edit_box::create_glue()
 
 void edit_box::set_text(const std::string& sText)
 {
-    if (sText != sText_)
+    if (sText != get_text())
     {
         unlight_text();
         sText_ = sText;
+        bUpdateText_ = false;
         check_text_();
         update_displayed_text_();
         iterCarretPos_ = sUnicodeText_.end();
@@ -350,6 +356,12 @@ void edit_box::set_text(const std::string& sText)
 
 const std::string& edit_box::get_text() const
 {
+    if (bUpdateText_)
+    {
+        sText_ = utils::unicode_to_UTF8(sUnicodeText_);
+        bUpdateText_ = false;
+    }
+
     return sText_;
 }
 
@@ -392,20 +404,11 @@ void edit_box::highlight_text(uint uiStart, uint uiEnd, bool bForceUpdate)
             utils::wptr<text> pText = pFontString_->get_text_object();
             const std::vector<text::letter>& lLetters = pText->get_letter_cache();
 
-            std::vector<text::letter>::const_iterator iter;
-            foreach (iter, lLetters)
-            {
-                uint uiPos = iter - lLetters.begin() + uiDisplayPos_;
+            if (uiLeft >= uiDisplayPos_ && uiLeft - uiDisplayPos_ < lLetters.size())
+                iLeftPos = int(lLetters[uiLeft - uiDisplayPos_].mQuad.left) + lTextInsets_.left;
 
-                if (uiPos == uiLeft)
-                    iLeftPos = int(iter->mQuad.left) + lTextInsets_.left;
-
-                if (uiPos == uiRight - 1)
-                {
-                    iRightPos = int(iter->mQuad.right) + lTextInsets_.left;
-                    break;
-                }
-            }
+            if (uiRight - 1 >= uiDisplayPos_ && uiRight - 1 - uiDisplayPos_ < lLetters.size())
+                iRightPos = int(lLetters[uiRight - 1 - uiDisplayPos_].mQuad.right) + lTextInsets_.left;
 
             pHighlight_->set_abs_point(ANCHOR_LEFT,  sName_, ANCHOR_LEFT, iLeftPos,  0);
             pHighlight_->set_abs_point(ANCHOR_RIGHT, sName_, ANCHOR_LEFT, iRightPos, 0);
@@ -445,7 +448,7 @@ void edit_box::insert_after_cursor(const std::string& sText)
             unlight_text();
             sUnicodeText_.insert(iterCarretPos_, sUStr.begin(), sUStr.end());
             iterCarretPos_ += sUStr.size();
-            sText_ = utils::unicode_to_UTF8(sUnicodeText_);
+            bUpdateText_ = true;
             uiNumLetters_ = sUnicodeText_.size();
 
             update_displayed_text_();
@@ -693,14 +696,14 @@ void edit_box::notify_focus(bool bFocus)
 
             mCarretTimer_.zero();
 
-            lQueuedEventList_.push_back("EditFocusGained");
+            queue_event_("EditFocusGained");
         }
         else
         {
             if (pCarret_)
                 pCarret_->hide();
 
-            lQueuedEventList_.push_back("EditFocusLost");
+            queue_event_("EditFocusLost");
         }
     }
 }
@@ -735,6 +738,7 @@ void edit_box::set_font_string(font_string* pFont)
         );
 
         pFontString_->enable_formatting(false);
+        pFontString_->enable_layout_sharing(false);
     }
 }
 
@@ -812,7 +816,7 @@ void edit_box::create_carret_()
 
 void edit_box::check_text_()
 {
-    sUnicodeText_ = utils::UTF8_to_unicode(sText_);
+    sUnicodeText_ = utils::UTF8_to_unicode(get_text());
 
     if (!utils::is_number(sText_) && bNumericOnly_)
         sUnicodeText_.clear();
@@ -831,22 +835,46 @@ void edit_box::update_displayed_text_()
 {
     if (pFontString_ && pFontString_->get_text_object())
     {
-        if (bPasswordMode_)
-            sDisplayedText_ = utils::ustring(utils::UTF8_to_unicode('*'), sUnicodeText_.size());
-        else
-            sDisplayedText_ = sUnicodeText_;
+        utils::wptr<text> pTextObject = pFontString_->get_text_object();
 
-        if (!bMultiLine_)
+        if (!bMultiLine_ && !math::isinf(pTextObject->get_box_width()))
         {
-            utils::wptr<text> pTextObject = pFontString_->get_text_object();
-
-            if (!math::isinf(pTextObject->get_box_width()))
+            // Only keep the letters that fit in the box : their widths are
+            // summed one after the other, so the cost does not depend on
+            // the length of the whole text
+            float fBoxWidth = pTextObject->get_box_width();
+            float fTracking = pTextObject->get_tracking();
+            float fWidth = 0.0f;
+            char32_t uiPrevChar = 0;
+
+            uint uiStart = std::min<uint>(uiDisplayPos_, sUnicodeText_.size());
+            uint uiEnd = uiStart;
+            for (; uiEnd < sUnicodeText_.size(); ++uiEnd)
             {
-                sDisplayedText_.erase(0, uiDisplayPos_);
+                char32_t uiChar = bPasswordMode_ ? TO_U('*') : sUnicodeText_[uiEnd];
+
+                fWidth += pTextObject->get_character_width(uiChar) + fTracking;
+                if (uiPrevChar != 0 && uiPrevChar != TO_U(' ') && uiPrevChar != TO_U('\t') &&
+                    uiChar != TO_U(' ') && uiChar != TO_U('\n'))
+                    fWidth += pTextObject->get_character_kerning(uiPrevChar, uiChar);
 
-                while (pTextObject->get_string_width(sDisplayedText_) > pTextObject->get_box_width())
-                    sDisplayedText_.erase(sDisplayedText_.size()-2, 1);
+                if (fWidth > fBoxWidth)
+                    break;
+
+                uiPrevChar = uiChar;
             }
+
+            if (bPasswordMode_)
+                sDisplayedText_.assign(uiEnd - uiStart, TO_U('*'));
+            else
+                sDisplayedText_.assign(sUnicodeText_, uiStart, uiEnd - uiStart);
+        }
+        else
+        {
+            if (bPasswordMode_)
+                sDisplayedText_.assign(sUnicodeText_.size(), TO_U('*'));
+            else
+                sDisplayedText_ = sUnicodeText_;
         }
     }
 }
@@ -856,7 +884,7 @@ void edit_box::update_font_string_()
     if (!pFontString_)
         return;
 
-    pFontString_->set_text(utils::unicode_to_UTF8(sDisplayedText_));
+    pFontString_->set_unicode_text(sDisplayedText_);
 
     if (bSelectedText_)
         highlight_text(uiSelectionStartPos_, uiSelectionEndPos_, true);
@@ -892,89 +920,50 @@ void edit_box::update_carret_position_()
         }
 
         utils::wptr<text> pText = pFontString_->get_text_object();
-        utils::ustring::iterator iterDisplayCarret;
+        uint uiGlobalPos = iterCarretPos_ - sUnicodeText_.begin();
 
         if (!bMultiLine_)
         {
-            uint uiGlobalPos = iterCarretPos_ - sUnicodeText_.begin();
-
             if (uiDisplayPos_ > uiGlobalPos)
             {
                 // The carret has been positioned before the start of the displayed string
-                float fBoxWidth = pText->get_box_width();
-                float fLeftStringMaxSize = fBoxWidth*0.25f;
-                float fLeftStringSize = 0.0f;
-                utils::ustring sLeftString;
-
-                utils::ustring::iterator iter = iterCarretPos_;
-                while ((iter != sUnicodeText_.begin()) && (fLeftStringSize < fLeftStringMaxSize))
-                {
-                    --iter;
-                    sLeftString.insert(sLeftString.begin(), *iter);
-                    fLeftStringSize = pText->get_string_width(sLeftString);
-                }
-
-                uiDisplayPos_ = iter - sUnicodeText_.begin();
+                uiDisplayPos_ = get_letter_id_before_carret_(pText->get_box_width()*0.25f);
                 update_displayed_text_();
                 update_font_string_();
             }
 
-            uint uiCarretPos = uiGlobalPos - uiDisplayPos_;
-            if (uiCarretPos > sDisplayedText_.size())
+            if (uiGlobalPos - uiDisplayPos_ > sDisplayedText_.size())
             {
                 // The carret has been positioned after the end of the displayed string
-                float fBoxWidth = pText->get_box_width();
-                float fLeftStringMaxSize = fBoxWidth*0.75f;
-                float fLeftStringSize = 0.0f;
-                utils::ustring sLeftString;
-
-                utils::ustring::iterator iter = iterCarretPos_;
-                while ((iterCarretPos_ != sUnicodeText_.begin()) && (fLeftStringSize < fLeftStringMaxSize))
-                {
-                    --iter;
-                    sLeftString.insert(sLeftString.begin(), *iter);
-                    fLeftStringSize = pText->get_string_width(sLeftString);
-                }
-
-                uiDisplayPos_ = iter - sUnicodeText_.begin();
+                uiDisplayPos_ = get_letter_id_before_carret_(pText->get_box_width()*0.75f);
                 update_displayed_text_();
                 update_font_string_();
-
-                uiCarretPos = uiGlobalPos - uiDisplayPos_;
             }
-
-            iterDisplayCarret = sDisplayedText_.begin() + uiCarretPos;
         }
-        else
-            iterDisplayCarret = sDisplayedText_.begin() + (iterCarretPos_ - sUnicodeText_.begin()) - uiDisplayPos_;
 
         const std::vector<text::letter>& lLetters = pText->get_letter_cache();
-        std::vector<text::letter>::const_iterator iterLetter = lLetters.begin();
+        if (lLetters.empty())
+            return;
 
-        float fYOffset = 0.0f;
+        uint uiCarretPos = std::min<uint>(uiGlobalPos - uiDisplayPos_, lLetters.size());
 
-        utils::ustring::const_iterator iter;
-        for (iter = sDisplayedText_.begin(); iter != iterDisplayCarret; ++iter)
-        {
-            float fLastY = iterLetter->mQuad.top;
-            ++iterLetter;
-            if (iterLetter != lLetters.end() && fLastY != iterLetter->mQuad.top)
-                fYOffset += iterLetter->mQuad.top - fLastY;
-        }
+        // Letters are stored line after line : the carret is placed on the
+        // line of the letter that precedes it, without walking the text
+        uint uiLine = pText->get_letter_line(std::min<uint>(uiCarretPos, lLetters.size() - 1));
+        float fYOffset = uiLine*pText->get_line_height()*pText->get_line_spacing();
 
-        if (iterLetter == lLetters.begin())
+        if (uiCarretPos == 0)
         {
             pCarret_->set_abs_point(
                 ANCHOR_CENTER, sName_, ANCHOR_LEFT,
-                lTextInsets_.left + int(iterLetter->mQuad.left) - 1, int(fYOffset)
+                lTextInsets_.left + int(lLetters[0].mQuad.left) - 1, int(fYOffset)
             );
         }
         else
         {
-            --iterLetter;
             pCarret_->set_abs_point(
                 ANCHOR_CENTER, sName_, ANCHOR_LEFT,
-                lTextInsets_.left + int(iterLetter->mQuad.right) - 1, int(fYOffset)
+                lTextInsets_.left + int(lLetters[uiCarretPos - 1].mQuad.right) - 1, int(fYOffset)
             );
         }
 
@@ -1017,7 +1006,7 @@ bool edit_box::add_char_(char32_t sUnicode)
     iterCarretPos_ = sUnicodeText_.insert(iterCarretPos_, sUnicode) + 1;
     ++uiNumLetters_;
 
-    sText_ = utils::unicode_to_UTF8(sUnicodeText_);
+    bUpdateText_ = true;
 
     update_displayed_text_();
     update_font_string_();
@@ -1043,7 +1032,7 @@ bool edit_box::remove_char_()
             uint uiRight = std::max(uiSelectionStartPos_, uiSelectionEndPos_);
 
             sUnicodeText_.erase(uiLeft, uiRight - uiLeft);
-            sText_ = utils::unicode_to_UTF8(sUnicodeText_);
+            bUpdateText_ = true;
             uiNumLetters_ = sUnicodeText_.size();
 
             iterCarretPos_ = sUnicodeText_.begin() + uiLeft;
@@ -1058,7 +1047,7 @@ bool edit_box::remove_char_()
             return false;
 
         iterCarretPos_ = sUnicodeText_.erase(iterCarretPos_);
-        sText_ = utils::unicode_to_UTF8(sUnicodeText_);
+        bUpdateText_ = true;
         --uiNumLetters_;
         on("TextChanged");
     }
@@ -1086,7 +1075,6 @@ uint edit_box::get_letter_id_at_(int iX, int iY)
             return uiDisplayPos_;
 
         float fX = float(iX - lBorderList_.left - lTextInsets_.left);
-        //float fY = float(iY - lBorderList_.top  - lTextInsets_.top);
 
         if (!bMultiLine_)
         {
@@ -1095,19 +1083,26 @@ uint edit_box::get_letter_id_at_(int iX, int iY)
             else if (iX > lBorderList_.right - lTextInsets_.right)
                 return lLetters.size() + uiDisplayPos_;
 
-            std::vector<text::letter>::const_iterator iter;
-            foreach (iter, lLetters)
-            {
-                if (fX < iter->mQuad.center().x)
-                    return (iter - lLetters.begin()) + uiDisplayPos_;
-            }
-
-            return lLetters.size() + uiDisplayPos_;
+            return pText->get_letter_id_at(fX, lLetters[0].mQuad.top) + uiDisplayPos_;
         }
         else
         {
-            // TODO : Implement for multi line edit_box
-            return uiDisplayPos_;
+            // Same vertical origin as in font_string::render()
+            float fY = 0.0f;
+            switch (pFontString_->get_justify_v())
+            {
+                case text::ALIGN_TOP :
+                    fY = float(iY - pFontString_->get_top());
+                    break;
+                case text::ALIGN_MIDDLE :
+                    fY = float(iY) - (pFontString_->get_top() + pFontString_->get_bottom())/2;
+                    break;
+                case text::ALIGN_BOTTOM :
+                    fY = float(iY - pFontString_->get_bottom());
+                    break;
+            }
+
+            return pText->get_letter_id_at(fX, fY) + uiDisplayPos_;
         }
 
     }
@@ -1115,6 +1110,32 @@ uint edit_box::get_letter_id_at_(int iX, int iY)
     return uint(-1);
 }
 
+uint edit_box::get_letter_id_before_carret_(float fWidth) const
+{
+    // Walk back from the carret, summing the width of each letter
+    // as text::get_string_width() would
+    utils::wptr<text> pText = pFontString_->get_text_object();
+    float fTracking = pText->get_tracking();
+    float fLeftWidth = 0.0f;
+    char32_t uiNextChar = 0;
+
+    utils::ustring::const_iterator iter = iterCarretPos_;
+    while (iter != sUnicodeText_.begin() && fLeftWidth < fWidth)
+    {
+        --iter;
+        char32_t uiChar = bPasswordMode_ ? TO_U('*') : *iter;
+
+        fLeftWidth += pText->get_character_width(uiChar) + fTracking;
+        if (uiNextChar != 0 && uiChar != TO_U(' ') && uiChar != TO_U('\t') &&
+            uiNextChar != TO_U(' ') && uiNextChar != TO_U('\n'))
+            fLeftWidth += pText->get_character_kerning(uiChar, uiNextChar);
+
+        uiNextChar = uiChar;
+    }
+
+    return iter - sUnicodeText_.begin();
+}
+
 bool edit_box::move_carret_at_(int iX, int iY)
 {
     uint uiPos = get_letter_id_at_(iX, iY);
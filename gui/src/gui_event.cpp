@@ -1,19 +1,31 @@
 #include "lxgui/gui_event.hpp"
+
+#include <unordered_map>
 
 namespace gui
 {
-event::event() : bOncePerFrame_(false)
+std::unordered_map<std::string, uint>& get_event_id_list()
+{
+    static std::unordered_map<std::string, uint> lIDList;
+    return lIDList;
+}
+
+event::event() : uiID_(find_id("")), bOncePerFrame_(false)
 {
 }
 
 event::event(const std::string& sName, bool bOncePerFrame) :
-    sName_(sName), bOncePerFrame_(bOncePerFrame)
+    sName_(sName), uiID_(get_id(sName)), bOncePerFrame_(bOncePerFrame)
 {
 }
 
 void event::set_name(const std::string& sName)
 {
-    sName_ = sName;
+    if (sName_ != sName)
+    {
+        sName_ = sName;
+        uiID_ = get_id(sName_);
+    }
 }
 
 void event::set_once_per_frame(bool bOncePerFrame)
@@ -41,6 +53,35 @@ const std::string& event::get_name() const
     return sName_;
 }
 
+uint event::get_id() const
+{
+    return uiID_;
+}
+
+uint event::get_id(const std::string& sName)
+{
+    std::unordered_map<std::string, uint>& lIDList = get_event_id_list();
+
+    std::unordered_map<std::string, uint>::iterator iter = lIDList.find(sName);
+    if (iter != lIDList.end())
+        return iter->second;
+
+    uint uiID = lIDList.size();
+    lIDList[sName] = uiID;
+    return uiID;
+}
+
+uint event::find_id(const std::string& sName)
+{
+    const std::unordered_map<std::string, uint>& lIDList = get_event_id_list();
+
+    std::unordered_map<std::string, uint>::const_iterator iter = lIDList.find(sName);
+    if (iter != lIDList.end())
+        return iter->second;
+
+    return uint(-1);
+}
+
 bool event::is_once_per_frame() const
 {
     return bOncePerFrame_;
@@ -5,45 +5,46 @@
 
 #include <lxgui/utils_string.hpp>
 
+#include <algorithm>
+
 //#define DEBUG_LOG(msg) gui::out << (msg) << std::endl
 #define DEBUG_LOG(msg)
 
 namespace gui
 {
-typedef std::multimap<std::string, event_receiver*>::iterator iterator;
+event_manager::event_manager() : uiFireDepth_(0u)
+{
+}
 
 void event_manager::register_event(event_receiver* pReceiver, const std::string& sEventName)
 {
-    if (lReceiverList_.find(sEventName) != lReceiverList_.end())
+    uint uiID = event::get_id(sEventName);
+    if (uiID >= lReceiverList_.size())
+        lReceiverList_.resize(uiID + 1);
+
+    // Check the provided event_receiver isn't already registered
+    std::vector<event_receiver*>& lReceivers = lReceiverList_[uiID];
+    if (utils::find(lReceivers, pReceiver) != lReceivers.end())
     {
-        // This event is already registered to one or more event_receivers.
-        // Check the provided event_receiver isn't one of them :
-        auto mRange = lReceiverList_.equal_range(sEventName);
-        for (iterator iterReceiver = mRange.first; iterReceiver != mRange.second; ++iterReceiver)
-        {
-            if (iterReceiver->second == pReceiver)
-            {
-                gui::out << gui::warning << "event_manager : "
-                    << "Event \"" << sEventName << "\" is already registered to this event_receiver "
-                    << "(event_receiver : " << pReceiver << ")." << std::endl;
-                return;
-            }
-        }
+        gui::out << gui::warning << "event_manager : "
+            << "Event \"" << sEventName << "\" is already registered to this event_receiver "
+            << "(event_receiver : " << pReceiver << ")." << std::endl;
+        return;
     }
 
-    lReceiverList_.insert(std::make_pair(sEventName, pReceiver));
+    lReceivers.push_back(pReceiver);
 }
 
 void event_manager::unregister_event(event_receiver* pReceiver, const std::string& sEventName)
 {
-    // This event is registered to one or more event_receivers.
-    // Check the provided event_receiver is one of them :
-    auto mRange = lReceiverList_.equal_range(sEventName);
-    for (iterator iterReceiver = mRange.first; iterReceiver != mRange.second; ++iterReceiver)
+    uint uiID = event::find_id(sEventName);
+    if (uiID < lReceiverList_.size())
     {
-        if (iterReceiver->second == pReceiver)
+        std::vector<event_receiver*>& lReceivers = lReceiverList_[uiID];
+        std::vector<event_receiver*>::iterator iterReceiver = utils::find(lReceivers, pReceiver);
+        if (iterReceiver != lReceivers.end())
         {
-            lReceiverList_.erase(iterReceiver);
+            remove_receiver_(uiID, iterReceiver);
             return;
         }
     }
@@ -55,44 +56,97 @@ void event_manager::unregister_event(event_receiver* pReceiver, const std::strin
 
 void event_manager::unregister_receiver(event_receiver* pReceiver)
 {
-    iterator iterReceiver = lReceiverList_.begin();
-    while (iterReceiver != lReceiverList_.end())
+    for (uint uiID = 0; uiID < lReceiverList_.size(); ++uiID)
     {
-        if (iterReceiver->second == pReceiver)
-            iterReceiver = lReceiverList_.erase(iterReceiver);
-        else
-            ++iterReceiver;
+        std::vector<event_receiver*>& lReceivers = lReceiverList_[uiID];
+        std::vector<event_receiver*>::iterator iterReceiver = utils::find(lReceivers, pReceiver);
+        if (iterReceiver != lReceivers.end())
+            remove_receiver_(uiID, iterReceiver);
     }
 }
 
+void event_manager::remove_receiver_(uint uiID, std::vector<event_receiver*>::iterator iterReceiver)
+{
+    if (uiFireDepth_ != 0)
+    {
+        // An event is being fired : erasing the receiver would shift the
+        // next ones, which would then be skipped. It is removed later.
+        *iterReceiver = nullptr;
+        lNullReceiverIDList_.push_back(uiID);
+    }
+    else
+        lReceiverList_[uiID].erase(iterReceiver);
+}
+
+void event_manager::remove_null_receivers_()
+{
+    std::vector<uint>::iterator iterID;
+    foreach (iterID, lNullReceiverIDList_)
+    {
+        std::vector<event_receiver*>& lReceivers = lReceiverList_[*iterID];
+        lReceivers.erase(std::remove(lReceivers.begin(), lReceivers.end(),
+            static_cast<event_receiver*>(nullptr)), lReceivers.end());
+    }
+
+    lNullReceiverIDList_.clear();
+}
+
 void event_manager::fire_event(const event& mEvent)
 {
     DEBUG_LOG(mEvent.get_name());
-    if (lReceiverList_.find(mEvent.get_name()) != lReceiverList_.end())
+    uint uiID = mEvent.get_id();
+    if (uiID >= lReceiverList_.size() || lReceiverList_[uiID].empty())
+        return;
+
+    DEBUG_LOG(mEvent.get_name()+"!");
+    // This event is registered to one or more event_receivers.
+    // Check if this event should only be fired once per frame.
+    if (uiID < lFiredEventList_.size() && lFiredEventList_[uiID])
+        return;
+
+    // Now, tell all these event_receivers that this Event has occured.
+    // Receivers can register events while being told, so the lists
+    // must be accessed by index. Unregistered receivers are set to
+    // null, and only removed once all the events have been fired.
+    ++uiFireDepth_;
+    try
     {
-        DEBUG_LOG(mEvent.get_name()+"!");
-        // This event is registered to one or more event_receivers.
-        // Check if this event should only be fired once per frame.
-        if (utils::find(lFiredEventList_, mEvent.get_name()) == lFiredEventList_.end())
+        for (uint i = 0; i < lReceiverList_[uiID].size(); ++i)
         {
-            std::pair<iterator, iterator> mRange = lReceiverList_.equal_range(mEvent.get_name());
+            event_receiver* pReceiver = lReceiverList_[uiID][i];
+            if (!pReceiver)
+                continue;
+
+            DEBUG_LOG(std::string(" ") + utils::to_string(pReceiver));
+            pReceiver->on_event(mEvent);
+        }
+    }
+    catch (...)
+    {
+        --uiFireDepth_;
+        throw;
+    }
+    --uiFireDepth_;
 
-            // Now, tell all these event_receivers that this Event has occured.
-            for (iterator iterReceiver = mRange.first; iterReceiver != mRange.second; ++iterReceiver)
-            {
-                DEBUG_LOG(std::string(" ") + utils::to_string(iterReceiver->second));
-                iterReceiver->second->on_event(mEvent);
-            }
+    if (uiFireDepth_ == 0 && !lNullReceiverIDList_.empty())
+        remove_null_receivers_();
 
+    if (mEvent.is_once_per_frame())
+    {
+        if (uiID >= lFiredEventList_.size())
+            lFiredEventList_.resize(uiID + 1, false);
 
-            if (mEvent.is_once_per_frame())
-                lFiredEventList_.push_back(mEvent.get_name());
-        }
+        lFiredEventList_[uiID] = true;
+        lFiredIDList_.push_back(uiID);
     }
 }
 
 void event_manager::frame_ended()
 {
-    lFiredEventList_.clear();
+    std::vector<uint>::iterator iterID;
+    foreach (iterID, lFiredIDList_)
+        lFiredEventList_[*iterID] = false;
+
+    lFiredIDList_.clear();
 }
 }
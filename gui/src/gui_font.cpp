@@ -1,4 +1,5 @@
 #include "lxgui/gui_font.hpp"
+#include "lxgui/gui_material.hpp"
 
 namespace gui
 {
@@ -9,4 +10,31 @@ font::font()
 font::~font()
 {
 }
+
+float font::get_character_height(char32_t uiChar) const
+{
+    return get_character_uvs(uiChar).height()*get_texture()->get_height();
+}
+
+void font::get_character_widths(const char32_t* pChars, uint uiCount, float* pWidths) const
+{
+    for (uint i = 0; i < uiCount; ++i)
+        pWidths[i] = get_character_width(pChars[i]);
+}
+
+void font::get_character_kernings(const char32_t* pChars, uint uiCount, float* pKernings) const
+{
+    for (uint i = 0; i + 1 < uiCount; ++i)
+        pKernings[i] = get_character_kerning(pChars[i], pChars[i+1]);
+}
+
+uint font::get_texture_revision() const
+{
+    return 0u;
+}
+
+utils::wptr<material> font::get_outline_texture(float fThickness) const
+{
+    return nullptr;
+}
 }
@@ -16,10 +16,11 @@ const uint  OUTLINE_QUALITY   = 10;
 const float OUTLINE_THICKNESS = 2.0f;
 
 font_string::font_string(manager* pManager) : layered_region(pManager),
-    uiHeight_(0), fSpacing_(0.0f), mJustifyH_(text::ALIGN_CENTER),
+    bUpdateText_(false), uiHeight_(0), fSpacing_(0.0f), mJustifyH_(text::ALIGN_CENTER),
     mJustifyV_(text::ALIGN_MIDDLE), iXOffset_(0), iYOffset_(0),
     bIsOutlined_(false), bCanNonSpaceWrap_(false), bCanWordWrap_(true),
-    bAddEllipsis_(true), bFormattingEnabled_(true), mTextColor_(color::WHITE),
+    bAddEllipsis_(true), bFormattingEnabled_(true), bLayoutSharingEnabled_(true),
+    mTextColor_(color::WHITE),
     bHasShadow_(false), mShadowColor_(color::BLACK), iShadowXOffset_(0),
     iShadowYOffset_(0)
 {
@@ -63,31 +64,78 @@ void font_string::render()
         fX += iXOffset_;
         fY += iYOffset_;
 
+        pText_->set_color(mTextColor_);
+
+        if (!bHasShadow_ && !bIsOutlined_)
+        {
+            pText_->render(fX, fY);
+            return;
+        }
+
+        // Distance field fonts render the text and its outline at once
+        bool bSinglePassOutline = bIsOutlined_ && pText_->is_outline_supported(OUTLINE_THICKNESS);
+
+        // Shadow, outline and text are rendered in a single batch,
+        // from copies of the same letter quads
+        lCopyList_.clear();
+
         if (bHasShadow_)
+            lCopyList_.push_back(text::copy(vector2f(iShadowXOffset_, iShadowYOffset_), mShadowColor_));
+
+        if (bSinglePassOutline)
         {
-            pText_->set_color(mShadowColor_, true);
-            pText_->render(fX + iShadowXOffset_, fY + iShadowYOffset_);
+            if (!lCopyList_.empty())
+                pText_->render_copies(fX, fY, lCopyList_);
+
+            pText_->render_outlined(fX, fY, OUTLINE_THICKNESS);
+            return;
         }
 
         if (bIsOutlined_)
         {
-            pText_->set_color(color(0, 0, 0, mTextColor_.a), true);
+            static const float PI2 = 2.0f*acos(-1.0f);
+
+            color mOutlineColor(0, 0, 0, mTextColor_.a);
             for (uint i = 0; i < OUTLINE_QUALITY; ++i)
             {
-                static const float PI2 = 2.0f*acos(-1.0f);
-
-                pText_->render(
-                    fX + OUTLINE_THICKNESS*cos(PI2*float(i)/OUTLINE_QUALITY),
-                    fY + OUTLINE_THICKNESS*sin(PI2*float(i)/OUTLINE_QUALITY)
-                );
+                lCopyList_.push_back(text::copy(vector2f(
+                    OUTLINE_THICKNESS*cos(PI2*float(i)/OUTLINE_QUALITY),
+                    OUTLINE_THICKNESS*sin(PI2*float(i)/OUTLINE_QUALITY)
+                ), mOutlineColor));
             }
         }
 
-        pText_->set_color(mTextColor_);
-        pText_->render(fX, fY);
+        lCopyList_.push_back(text::copy(vector2f::ZERO));
+        pText_->render_copies(fX, fY, lCopyList_);
     }
 }
 
+quad2i font_string::get_render_area() const
+{
+    quad2i mArea = layered_region::get_render_area();
+    if (!pText_)
+        return mArea;
+
+    // The text is drawn with an offset, its outline around
+    // it, and its shadow is an offset copy of the text
+    quad2i mTextArea = mArea + vector2i(iXOffset_, iYOffset_);
+    mArea.extend(mTextArea);
+
+    if (bIsOutlined_)
+    {
+        int iThickness = ceil(OUTLINE_THICKNESS);
+        mArea.extend(quad2i(
+            mTextArea.left - iThickness, mTextArea.right + iThickness,
+            mTextArea.top - iThickness,  mTextArea.bottom + iThickness
+        ));
+    }
+
+    if (bHasShadow_)
+        mArea.extend(mTextArea + vector2i(iShadowXOffset_, iShadowYOffset_));
+
+    return mArea;
+}
+
 void font_string::update(float fDelta)
 {
     //#define DEBUG_LOG(msg) gui::out << (msg) << std::endl
@@ -113,7 +161,7 @@ std::string font_string::serialize(const std::string& sTab) const
     sStr << sTab << "  # Font name   : " << sFontName_ << "\n";
     sStr << sTab << "  # Font height : " << uiHeight_ << "\n";
     sStr << sTab << "  # Text ready  : " << (pText_ != nullptr) << "\n";
-    sStr << sTab << "  # Text        : \"" << sText_ << "\"\n";
+    sStr << sTab << "  # Text        : \"" << get_text() << "\"\n";
     sStr << sTab << "  # Outlined    : " << bIsOutlined_ << "\n";
     sStr << sTab << "  # Text color  : " << mTextColor_ << "\n";
     sStr << sTab << "  # Spacing     : " << fSpacing_ << "\n";
@@ -258,6 +306,9 @@ void font_string::set_font(const std::string& sFontName, uint uiHeight)
     sFontName_ = sFontName;
     uiHeight_ = uiHeight;
 
+    // Read the text before its current owner is destroyed
+    get_text();
+
     pText_ = utils::refptr<text>(new text(pManager_, sFontName, uiHeight));
     pText_->set_remove_starting_spaces(true);
     pText_->set_text(sText_);
@@ -266,6 +317,7 @@ void font_string::set_font(const std::string& sFontName, uint uiHeight)
     pText_->set_tracking(fSpacing_);
     pText_->enable_word_wrap(bCanWordWrap_, bAddEllipsis_);
     pText_->enable_formatting(bFormattingEnabled_);
+    pText_->enable_layout_sharing(bLayoutSharingEnabled_);
 
     fire_update_borders();
     notify_renderer_need_redraw();
@@ -394,6 +446,12 @@ float font_string::get_string_width() const
 
 const std::string& font_string::get_text() const
 {
+    if (bUpdateText_)
+    {
+        sText_ = pText_->get_text();
+        bUpdateText_ = false;
+    }
+
     return sText_;
 }
 
@@ -454,9 +512,16 @@ bool font_string::is_formatting_enabled() const
     return bFormattingEnabled_;
 }
 
+void font_string::enable_layout_sharing(bool bShare)
+{
+    bLayoutSharingEnabled_ = bShare;
+    if (pText_)
+        pText_->enable_layout_sharing(bLayoutSharingEnabled_);
+}
+
 void font_string::set_text(const std::string& sText)
 {
-    if (sText_ != sText)
+    if (get_text() != sText)
     {
         sText_ = sText;
         if (pText_)
@@ -467,6 +532,18 @@ void font_string::set_text(const std::string& sText)
     }
 }
 
+void font_string::set_unicode_text(const utils::ustring& sText)
+{
+    if (pText_)
+    {
+        pText_->set_unicode_text(sText);
+        bUpdateText_ = true;
+        fire_update_borders();
+    }
+    else
+        set_text(utils::unicode_to_UTF8(sText));
+}
+
 utils::wptr<text> font_string::get_text_object()
 {
     return pText_;
@@ -557,6 +634,8 @@ void font_string::update_borders_() const
     else
         bReady_ = false;
 
+    notify_borders_updated();
+
     if (bReady_ || (!bReady_ && bOldReady))
     {
         DEBUG_LOG("  Fire redraw");
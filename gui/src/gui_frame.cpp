@@ -10,6 +10,7 @@
 #include "lxgui/gui_backdrop.hpp"
 #include "lxgui/gui_event.hpp"
 #include "lxgui/gui_eventmanager.hpp"
+#include "lxgui/gui_framegrid.hpp"
 #include "lxgui/gui_out.hpp"
 
 #include <lxgui/utils_string.hpp>
@@ -18,8 +19,6 @@
 
 namespace gui
 {
-int l_xml_error(lua_State*);
-
 #ifdef NO_CPP11_CONSTEXPR
 const char* frame::CLASS_NAME = "Frame";
 #endif
@@ -37,13 +36,30 @@ frame::frame(manager* pManager) : event_receiver(pManager->get_event_manager().l
     lRelHitRectInsetList_(quad2f::ZERO), uiMinWidth_(0u), uiMaxWidth_(uint(-1)),
     uiMinHeight_(0u), uiMaxHeight_(uint(-1)), fScale_(1.0f), bMouseInFrame_(false),
     bMouseInTitleRegion_(false), iMousePosX_(0), iMousePosY_(0), pTitleRegion_(nullptr),
-    pParentFrame_(nullptr), bMouseDragged_(false)
+    pParentFrame_(nullptr), bMouseDragged_(false), lLastRenderArea_(quad2i::ZERO),
+    pFrameGrid_(nullptr), iLuaSelfRef_(LUA_NOREF)
 {
     lType_.push_back(CLASS_NAME);
 }
 
 frame::~frame()
 {
+    if (pFrameGrid_)
+        pFrameGrid_->remove_frame(this);
+
+    if (!lScriptRefList_.empty() || iLuaSelfRef_ != LUA_NOREF)
+    {
+        utils::wptr<lua::state> pLua = pManager_->get_lua();
+        if (pLua)
+        {
+            std::map<std::string, int>::iterator iterRef;
+            foreach (iterRef, lScriptRefList_)
+                pLua->unref(iterRef->second);
+
+            pLua->unref(iLuaSelfRef_);
+        }
+    }
+
     std::map<uint, layered_region*>::iterator iterRegion;
     foreach (iterRegion, lRegionList_)
         delete iterRegion->second;
@@ -59,6 +75,8 @@ void frame::render()
 {
     if (bIsVisible_ && bReady_)
     {
+        lLastRenderArea_ = get_render_area();
+
         if (pBackdrop_)
             pBackdrop_->render();
 
@@ -79,6 +97,37 @@ void frame::render()
             }
         }
     }
+    else
+        lLastRenderArea_ = quad2i::ZERO;
+}
+
+quad2i frame::get_render_area() const
+{
+    if (!bReady_)
+        return quad2i::ZERO;
+
+    quad2i mArea = lBorderList_;
+
+    if (pBackdrop_)
+    {
+        // Negative insets draw the backdrop outside of the frame
+        const quad2i& lEdgeInsets = pBackdrop_->get_edge_insets();
+        const quad2i& lBackgroundInsets = pBackdrop_->get_background_insets();
+        mArea.left   += std::min(0, std::min(lEdgeInsets.left,   lBackgroundInsets.left));
+        mArea.right  -= std::min(0, std::min(lEdgeInsets.right,  lBackgroundInsets.right));
+        mArea.top    += std::min(0, std::min(lEdgeInsets.top,    lBackgroundInsets.top));
+        mArea.bottom -= std::min(0, std::min(lEdgeInsets.bottom, lBackgroundInsets.bottom));
+    }
+
+    std::map<uint, layered_region*>::const_iterator iterRegion;
+    foreach (iterRegion, lRegionList_)
+    {
+        const layered_region* pRegion = iterRegion->second;
+        if (pRegion->is_shown() && !pRegion->is_manually_rendered())
+            mArea.extend(pRegion->get_render_area());
+    }
+
+    return mArea;
 }
 
 void frame::create_glue()
@@ -381,7 +430,7 @@ void frame::copy_from(uiobject* pObj)
             }
         }
 
-        bBuildLayerList_ = true;
+        fire_build_layer_list();
     }
 }
 
@@ -643,6 +692,13 @@ void frame::notify_loaded()
 void frame::fire_build_layer_list()
 {
     bBuildLayerList_ = true;
+    fire_update();
+}
+
+void frame::queue_event_(const std::string& sScriptName)
+{
+    lQueuedEventList_.push_back(sScriptName);
+    fire_update();
 }
 
 bool frame::has_script(const std::string& sScriptName) const
@@ -931,6 +987,19 @@ bool frame::is_in_frame(int iX, int iY) const
         return bInFrame;
 }
 
+quad2i frame::get_hit_area() const
+{
+    quad2i mArea(
+        lBorderList_.left + lAbsHitRectInsetList_.left, lBorderList_.right  - lAbsHitRectInsetList_.right,
+        lBorderList_.top  + lAbsHitRectInsetList_.top,  lBorderList_.bottom - lAbsHitRectInsetList_.bottom
+    );
+
+    if (pTitleRegion_)
+        mArea.extend(pTitleRegion_->get_borders());
+
+    return mArea;
+}
+
 bool frame::is_keyboard_enabled() const
 {
     return bIsKeyboardEnabled_;
@@ -992,24 +1061,31 @@ void frame::define_script(const std::string& sScriptName, const std::string& sCo
         }
     }
 
-    std::string sStr;
-    sStr += "function " + sLuaName_ + ":" + sAdjustedName + "() " + sContent + " end";
-
-    // Use XML specific error handling
-    utils::wptr<lua::state> pLua = pManager_->get_lua();
+    // Offset the script so that Lua reports the actual line numbers in the XML file
+    std::string sStr(uiLineNbr > 0 ? uiLineNbr - 1 : 0, '\n');
 
-    std::string     sOldFile     = pLua->get_global_string("_xml_file_name", false, "");
-    uint            uiOldLineNbr = pLua->get_global_int("_xml_line_nbr", false, 0);
-    lua::c_function pErrorFunc   = pLua->get_lua_error_function();
+    // The arguments are received as parameters, and copied into local
+    // variables named as the legacy globals (see manager::enable_legacy_script_globals())
+    sStr += "function " + sLuaName_ + ":" + sAdjustedName;
+    if (sCutScriptName == "Event")
+        sStr += "(event, ...) ";
+    else
+        sStr += "(...) ";
+    sStr += "local arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9 = ...; ";
+    sStr += sContent + " end";
 
-    pLua->push_string(sFile);     pLua->set_global("_xml_file_name");
-    pLua->push_number(uiLineNbr); pLua->set_global("_xml_line_nbr");
-    pLua->set_lua_error_function(l_xml_error);
+    utils::wptr<lua::state> pLua = pManager_->get_lua();
 
     // Actually register the function
     try
     {
-        pLua->do_string(sStr);
+        if (sFile.empty())
+            pLua->do_string(sStr);
+        else
+            pLua->do_string(sStr, "@" + sFile);
+
+        pLua->push_global(sLuaName_ + ":" + sAdjustedName);
+        set_script_ref_(sCutScriptName, pLua->ref());
         lDefinedScriptList_[sCutScriptName] = sContent;
         lXMLScriptInfoList_[sCutScriptName].sFile = sFile;
         lXMLScriptInfoList_[sCutScriptName].uiLineNbr = uiLineNbr;
@@ -1018,33 +1094,12 @@ void frame::define_script(const std::string& sScriptName, const std::string& sCo
     {
         std::string sError = e.get_description();
 
-        // There is no way (at least in lua 5.1) to use a custom error
-        // function for syntax error checking (lua_load)...
-        // Here we hack the error string to recover the necessary informations
-        // and output a better error message.
-        if (sError[0] == '[')
-        {
-            size_t pos = sError.find("]");
-            sError.erase(0, pos+2);
-
-            pos = sError.find(":");
-            uint uiLuaLineNbr = utils::string_to_uint(sError.substr(0, pos));
-
-            sError.erase(0, pos+1);
-
-            sError = sFile + ":" + utils::to_string(uiLineNbr + uiLuaLineNbr - 1) + ":" + sError;
-        }
-
         gui::out << gui::error << sError << std::endl;
 
         event mEvent("LUA_ERROR");
         mEvent.add(sError);
         pManager_->get_event_manager()->fire_event(mEvent);
     }
-
-    pLua->push_string(sOldFile);     pLua->set_global("_xml_file_name");
-    pLua->push_number(uiOldLineNbr); pLua->set_global("_xml_line_nbr");
-    pLua->set_lua_error_function(pErrorFunc);
 }
 
 void frame::define_script(const std::string& sScriptName, handler mHandler)
@@ -1056,7 +1111,10 @@ void frame::define_script(const std::string& sScriptName, handler mHandler)
     if (iter != lDefinedScriptList_.end())
         lDefinedScriptList_.erase(iter);
 
+    remove_script_ref_(sCutScriptName);
+
     lDefinedHandlerList_[sCutScriptName] = mHandler;
+    fire_update();
 }
 
 void frame::notify_script_defined(const std::string& sScriptName, bool bDefined)
@@ -1064,19 +1122,52 @@ void frame::notify_script_defined(const std::string& sScriptName, bool bDefined)
     std::string sCutScriptName = sScriptName;
     sCutScriptName.erase(0, 2);
 
-    std::map<std::string, script_info>::iterator iter = lXMLScriptInfoList_.find(sScriptName);
+    std::map<std::string, script_info>::iterator iter = lXMLScriptInfoList_.find(sCutScriptName);
     if (iter != lXMLScriptInfoList_.end())
         lXMLScriptInfoList_.erase(iter);
 
     if (bDefined)
     {
-        std::map<std::string, handler>::iterator iter2 = lDefinedHandlerList_.find(sScriptName);
+        std::map<std::string, handler>::iterator iter2 = lDefinedHandlerList_.find(sCutScriptName);
         if (iter2 != lDefinedHandlerList_.end())
             lDefinedHandlerList_.erase(iter2);
 
+        // The function has just been stored in this frame's Lua object
+        utils::wptr<lua::state> pLua = pManager_->get_lua();
+        pLua->push_global(sName_ + ":" + sScriptName);
+        set_script_ref_(sCutScriptName, pLua->ref());
+
         lDefinedScriptList_[sCutScriptName] = "";
-    } else
+    }
+    else
+    {
+        remove_script_ref_(sCutScriptName);
         lDefinedScriptList_.erase(sCutScriptName);
+    }
+}
+
+void frame::set_script_ref_(const std::string& sScriptName, int iRef)
+{
+    std::map<std::string, int>::iterator iter = lScriptRefList_.find(sScriptName);
+    if (iter != lScriptRefList_.end())
+    {
+        pManager_->get_lua()->unref(iter->second);
+        iter->second = iRef;
+    }
+    else
+        lScriptRefList_[sScriptName] = iRef;
+
+    fire_update();
+}
+
+void frame::remove_script_ref_(const std::string& sScriptName)
+{
+    std::map<std::string, int>::iterator iter = lScriptRefList_.find(sScriptName);
+    if (iter != lScriptRefList_.end())
+    {
+        pManager_->get_lua()->unref(iter->second);
+        lScriptRefList_.erase(iter);
+    }
 }
 
 void frame::on_event(const event& mEvent)
@@ -1091,8 +1182,7 @@ void frame::on_event(const event& mEvent)
                 return;
         }
 
-        event mTemp = mEvent;
-        on("Event", &mTemp);
+        on("Event", &mEvent);
     }
 
     if (!pManager_->is_input_enabled())
@@ -1113,6 +1203,7 @@ void frame::on_event(const event& mEvent)
                     {
                         on("DragStart");
                         bMouseDragged_ = true;
+                        fire_update();
                         break;
                     }
                 }
@@ -1210,42 +1301,7 @@ void frame::on_event(const event& mEvent)
     }
 }
 
-int l_xml_error(lua_State* pLua)
-{
-    if (!lua_isstring(pLua, -1))
-    return 0;
-
-    lua_Debug d;
-
-    lua_getstack(pLua, 1, &d);
-    lua_getinfo(pLua, "Sl", &d);
-
-    if (d.short_src[0] == '[')
-    {
-        lua_getglobal(pLua, "_xml_file_name");
-        std::string sFile = lua_tostring(pLua, -1);
-        lua_pop(pLua, 1);
-        lua_getglobal(pLua, "_xml_line_nbr");
-        uint uiLineNbr = lua_tonumber(pLua, -1);
-        lua_pop(pLua, 1);
-
-        std::string sError = sFile + ":" + utils::to_string(uiLineNbr + d.currentline - 1) + ": "
-            + std::string(lua_tostring(pLua, -1));
-
-        lua_pushstring(pLua, sError.c_str());
-    }
-    else
-    {
-        std::string sError = std::string(d.short_src) + ":" + utils::to_string(int(d.currentline)) + ": "
-            + std::string(lua_tostring(pLua, -1));
-
-        lua_pushstring(pLua, sError.c_str());
-    }
-
-    return 1;
-}
-
-void frame::on(const std::string& sScriptName, event* pEvent)
+void frame::on(const std::string& sScriptName, const event* pEvent)
 {
     std::map<std::string, handler>::const_iterator iterH = lDefinedHandlerList_.find(sScriptName);
     if (iterH != lDefinedHandlerList_.end())
@@ -1254,98 +1310,44 @@ void frame::on(const std::string& sScriptName, event* pEvent)
             iterH->second(this, pEvent);
     }
 
-    std::map<std::string, std::string>::const_iterator iter = lDefinedScriptList_.find(sScriptName);
-    if (iter != lDefinedScriptList_.end())
+    std::map<std::string, int>::const_iterator iter = lScriptRefList_.find(sScriptName);
+    if (iter != lScriptRefList_.end())
     {
+        // Keep a copy : the script may redefine itself
+        int iRef = iter->second;
+
         utils::wptr<lua::state> pLua = pManager_->get_lua();
 
-        if ((sScriptName == "KeyDown") ||
-            (sScriptName == "KeyUp"))
-        {
-            // Set key name
-            if (pEvent)
-            {
-                pLua->push_number(pEvent->get<uint>(0));
-                pLua->set_global("arg1");
-                pLua->push_string(pEvent->get<std::string>(1));
-                pLua->set_global("arg2");
-            }
-        }
-        else if (sScriptName == "MouseDown")
-        {
-            // Set mouse button
-            pLua->push_string(pEvent->get<std::string>(0));
-            pLua->set_global("arg1");
-        }
-        else if (sScriptName == "MouseUp")
-        {
-            // Set mouse button
-            pLua->push_string(pEvent->get<std::string>(0));
-            pLua->set_global("arg1");
-        }
-        else if (sScriptName == "MouseWheel")
-        {
-            pLua->push_number(pEvent->get<float>(0));
-            pLua->set_global("arg1");
-        }
-        else if (sScriptName == "Update")
-        {
-            // Set delta time
-            pLua->push_number(pEvent->get<float>(0));
-            pLua->set_global("arg1");
-        }
-        else if (sScriptName == "Event")
-        {
-            // Set event name
-            pLua->push_string(pEvent->get_name());
-            pLua->set_global("event");
+        if (pManager_->is_legacy_script_globals_enabled())
+            set_legacy_script_globals_(sScriptName, pEvent);
 
-            // Set arguments
-            for (uint i = 0; i < pEvent->get_num_param(); ++i)
-            {
-                const lua::var* pArg = pEvent->get(i);
-                pLua->push(*pArg);
-                pLua->set_global("arg"+utils::to_string(i+1));
-            }
-        }
+        pManager_->set_current_addon(pAddOn_);
 
-        std::string sAdjustedName = sScriptName;
-        std::string::iterator iterStr;
-        foreach (iterStr, sAdjustedName)
+        if (iLuaSelfRef_ == LUA_NOREF)
         {
-            if ('A' <= *iterStr && *iterStr <= 'Z')
-            {
-                *iterStr = tolower(*iterStr);
-                iterStr  = sAdjustedName.insert(iterStr, '_');
-            }
+            pLua->push_global(sName_);
+            iLuaSelfRef_ = pLua->ref();
         }
 
-        lua::c_function pErrorFunc = nullptr;
-        std::string     sFile = "";
-        uint            uiLineNbr = 0;
+        // Arguments : self, the event name (OnEvent only), then the event parameters
+        pLua->push_ref(iLuaSelfRef_);
+        uint uiNumArgs = 1;
 
-        if (!iter->second.empty())
+        if (pEvent)
         {
-            // The script comes from an XML file, use another lua error function
-            // that will print the actual line numbers in the XML file.
-            pErrorFunc = pLua->get_lua_error_function();
-
-            std::map<std::string, script_info>::const_iterator iter2 = lXMLScriptInfoList_.find(sScriptName);
-            if (iter2 != lXMLScriptInfoList_.end())
+            if (sScriptName == "Event")
             {
-                sFile     = pLua->get_global_string("_xml_file_name", false, "");
-                uiLineNbr = pLua->get_global_int("_xml_line_nbr", false, 0);
+                pLua->push_string(pEvent->get_name());
+                ++uiNumArgs;
+            }
 
-                pLua->push_string(iter2->second.sFile);     pLua->set_global("_xml_file_name");
-                pLua->push_number(iter2->second.uiLineNbr); pLua->set_global("_xml_line_nbr");
+            for (uint i = 0; i < pEvent->get_num_param(); ++i)
+                pLua->push(*pEvent->get(i));
 
-                pLua->set_lua_error_function(l_xml_error);
-            }
+            uiNumArgs += pEvent->get_num_param();
         }
 
-        pManager_->set_current_addon(pAddOn_);
-
-        try { pLua->call_function(sName_+":on"+sAdjustedName); }
+        try { pLua->call_ref(iRef, uiNumArgs); }
         catch (lua::exception& e)
         {
             std::string sError = e.get_description();
@@ -1356,13 +1358,60 @@ void frame::on(const std::string& sScriptName, event* pEvent)
             mEvent.add(sError);
             pManager_->get_event_manager()->fire_event(mEvent);
         }
+    }
+}
 
-        if (!iter->second.empty())
+void frame::set_legacy_script_globals_(const std::string& sScriptName, const event* pEvent)
+{
+    utils::wptr<lua::state> pLua = pManager_->get_lua();
+
+    if ((sScriptName == "KeyDown") ||
+        (sScriptName == "KeyUp"))
+    {
+        // Set key name
+        if (pEvent)
         {
-            pLua->push_string(sFile);     pLua->set_global("_xml_file_name");
-            pLua->push_number(uiLineNbr); pLua->set_global("_xml_line_nbr");
+            pLua->push_number(pEvent->get<uint>(0));
+            pLua->set_global("arg1");
+            pLua->push_string(pEvent->get<std::string>(1));
+            pLua->set_global("arg2");
+        }
+    }
+    else if (sScriptName == "MouseDown")
+    {
+        // Set mouse button
+        pLua->push_string(pEvent->get<std::string>(0));
+        pLua->set_global("arg1");
+    }
+    else if (sScriptName == "MouseUp")
+    {
+        // Set mouse button
+        pLua->push_string(pEvent->get<std::string>(0));
+        pLua->set_global("arg1");
+    }
+    else if (sScriptName == "MouseWheel")
+    {
+        pLua->push_number(pEvent->get<float>(0));
+        pLua->set_global("arg1");
+    }
+    else if (sScriptName == "Update")
+    {
+        // Set delta time
+        pLua->push_number(pEvent->get<float>(0));
+        pLua->set_global("arg1");
+    }
+    else if (sScriptName == "Event")
+    {
+        // Set event name
+        pLua->push_string(pEvent->get_name());
+        pLua->set_global("event");
 
-            pLua->set_lua_error_function(pErrorFunc);
+        // Set arguments
+        for (uint i = 0; i < pEvent->get_num_param(); ++i)
+        {
+            const lua::var* pArg = pEvent->get(i);
+            pLua->push(*pArg);
+            pLua->set_global("arg"+utils::to_string(i+1));
         }
     }
 }
@@ -1461,11 +1510,13 @@ void frame::set_backdrop(utils::refptr<backdrop> pBackdrop)
 void frame::set_abs_hit_rect_insets(int iLeft, int iRight, int iTop, int iBottom)
 {
     lAbsHitRectInsetList_ = quad2i(iLeft, iRight, iTop, iBottom);
+    notify_borders_updated();
 }
 
 void frame::set_abs_hit_rect_insets(const quad2i& lInsets)
 {
     lAbsHitRectInsetList_ = lInsets;
+    notify_borders_updated();
 }
 
 void frame::set_rel_hit_rect_insets(float fLeft, float fRight, float fTop, float fBottom)
@@ -1677,21 +1728,23 @@ void frame::notify_child_strata_changed(frame* pChild)
 {
     if (pParentFrame_)
         pParentFrame_->notify_child_strata_changed(this);
-    else
-        pManager_->fire_build_strata_list();
 }
 
 void frame::notify_strata_changed_()
 {
     if (pParentFrame_)
         pParentFrame_->notify_child_strata_changed(this);
-    else
-        pManager_->fire_build_strata_list();
+
+    pManager_->notify_frame_strata_changed(this);
 }
 
 void frame::notify_visible_(bool bTriggerEvents)
 {
     bIsVisible_ = true;
+
+    // Resume OnUpdate
+    fire_update();
+
     std::map<uint, frame*>::iterator iterChild;
     foreach (iterChild, lChildList_)
     {
@@ -1701,7 +1754,7 @@ void frame::notify_visible_(bool bTriggerEvents)
 
     if (bTriggerEvents)
     {
-        lQueuedEventList_.push_back("Show");
+        queue_event_("Show");
         notify_renderer_need_redraw();
     }
 }
@@ -1718,7 +1771,7 @@ void frame::notify_invisible_(bool bTriggerEvents)
 
     if (bTriggerEvents)
     {
-        lQueuedEventList_.push_back("Hide");
+        queue_event_("Hide");
         notify_renderer_need_redraw();
     }
 }
@@ -1742,10 +1795,21 @@ void frame::notify_renderer_need_redraw() const
         if (pRenderer_)
             pRenderer_->fire_redraw();
         else
-            pManager_->fire_redraw(mStrata_);
+        {
+            // Redraw where the frame was last rendered, and where it is now
+            quad2i mArea = get_render_area();
+            mArea.extend(lLastRenderArea_);
+            pManager_->fire_redraw(mStrata_, mArea);
+        }
     }
 }
 
+void frame::notify_borders_updated() const
+{
+    if (pFrameGrid_)
+        pFrameGrid_->notify_frame_moved(this);
+}
+
 void frame::show()
 {
     if (!bIsShown_)
@@ -1884,28 +1948,37 @@ void frame::update(float fDelta)
         bBuildLayerList_ = false;
     }
 
-    if (is_visible())
+    if (is_visible() && has_script("Update"))
     {
         DEBUG_LOG("   On update");
         event mEvent;
         mEvent.add(fDelta);
         on("Update", &mEvent);
+
+        // Keep updating this frame while OnUpdate is defined
+        fire_update();
     }
 
     if (pTitleRegion_)
         pTitleRegion_->update(fDelta);
 
+    if (pBackdrop_)
+        pBackdrop_->update();
+
     // Update regions
     DEBUG_LOG("   Update regions");
     std::map<uint, layered_region*>::iterator iterRegion;
     foreach (iterRegion, lRegionList_)
         iterRegion->second->update(fDelta);
 
-    // Update children
+    // Update children (only those that need it)
     DEBUG_LOG("   Update children");
     std::map<uint, frame*>::iterator iterChild;
     foreach (iterChild, lChildList_)
-        iterChild->second->update(fDelta);
+    {
+        if (iterChild->second->is_update_needed())
+            iterChild->second->update(fDelta);
+    }
 
     if (uiOldWidth != uiAbsWidth_ || uiOldHeight != uiAbsHeight_)
     {
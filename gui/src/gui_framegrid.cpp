@@ -0,0 +1,223 @@
+#include "lxgui/gui_framegrid.hpp"
+#include "lxgui/gui_frame.hpp"
+
+#include <algorithm>
+
+namespace gui
+{
+// Frames that cover more cells than this are not split into cells,
+// but stored in a separate list that is checked on every query.
+const uint MAX_FRAME_CELLS = 64u;
+
+bool is_frame_above(const frame* pFrame1, const frame* pFrame2)
+{
+    if (pFrame1->get_frame_strata() != pFrame2->get_frame_strata())
+        return pFrame1->get_frame_strata() > pFrame2->get_frame_strata();
+
+    if (pFrame1->get_frame_level() != pFrame2->get_frame_level())
+        return pFrame1->get_frame_level() > pFrame2->get_frame_level();
+
+    return pFrame1->get_id() < pFrame2->get_id();
+}
+
+void insert_sorted(std::vector<frame*>& lList, frame* pFrame)
+{
+    lList.insert(std::upper_bound(lList.begin(), lList.end(), pFrame, &is_frame_above), pFrame);
+}
+
+void erase_frame(std::vector<frame*>& lList, frame* pFrame)
+{
+    std::vector<frame*>::iterator iter = std::find(lList.begin(), lList.end(), pFrame);
+    if (iter != lList.end())
+        lList.erase(iter);
+}
+
+frame_grid::frame_grid(uint uiCellSize) : uiCellSize_(uiCellSize)
+{
+}
+
+frame_grid::~frame_grid()
+{
+    clear();
+}
+
+void frame_grid::add_frame(frame* pFrame)
+{
+    if (pFrame->pFrameGrid_)
+        pFrame->pFrameGrid_->remove_frame(pFrame);
+
+    entry mEntry;
+    mEntry.pFrame = pFrame;
+    mEntry.mCells = quad2i::ZERO;
+    mEntry.bLarge = false;
+    mEntry.bDirty = true;
+
+    lEntryList_[pFrame] = mEntry;
+    lDirtyFrameList_.push_back(pFrame);
+    pFrame->pFrameGrid_ = this;
+}
+
+void frame_grid::remove_frame(frame* pFrame)
+{
+    std::map<const frame*, entry>::iterator iter = lEntryList_.find(pFrame);
+    if (iter == lEntryList_.end())
+        return;
+
+    erase_(iter->second);
+
+    if (iter->second.bDirty)
+    {
+        lDirtyFrameList_.erase(
+            std::remove(lDirtyFrameList_.begin(), lDirtyFrameList_.end(), pFrame),
+            lDirtyFrameList_.end()
+        );
+    }
+
+    lEntryList_.erase(iter);
+    pFrame->pFrameGrid_ = nullptr;
+}
+
+void frame_grid::clear()
+{
+    std::map<const frame*, entry>::iterator iter;
+    foreach (iter, lEntryList_)
+        iter->second.pFrame->pFrameGrid_ = nullptr;
+
+    lEntryList_.clear();
+    lCellList_.clear();
+    lLargeFrameList_.clear();
+    lDirtyFrameList_.clear();
+}
+
+void frame_grid::notify_frame_moved(const frame* pFrame)
+{
+    std::map<const frame*, entry>::iterator iter = lEntryList_.find(pFrame);
+    if (iter == lEntryList_.end() || iter->second.bDirty)
+        return;
+
+    iter->second.bDirty = true;
+    lDirtyFrameList_.push_back(pFrame);
+}
+
+frame* frame_grid::find_frame(int iX, int iY) const
+{
+    update_();
+
+    static const std::vector<frame*> lEmptyList;
+    const std::vector<frame*>* pCell = &lEmptyList;
+
+    std::unordered_map<unsigned long long, std::vector<frame*>>::const_iterator iterCell =
+        lCellList_.find(get_cell_key_(get_cell_coord_(iX), get_cell_coord_(iY)));
+    if (iterCell != lCellList_.end())
+        pCell = &iterCell->second;
+
+    // Both lists are sorted from top to bottom : merge them
+    std::vector<frame*>::const_iterator iterFrame = pCell->begin();
+    std::vector<frame*>::const_iterator iterLarge = lLargeFrameList_.begin();
+    while (iterFrame != pCell->end() || iterLarge != lLargeFrameList_.end())
+    {
+        frame* pFrame;
+        if (iterLarge == lLargeFrameList_.end() ||
+            (iterFrame != pCell->end() && is_frame_above(*iterFrame, *iterLarge)))
+        {
+            pFrame = *iterFrame;
+            ++iterFrame;
+        }
+        else
+        {
+            pFrame = *iterLarge;
+            ++iterLarge;
+        }
+
+        if (pFrame->is_mouse_enabled() && pFrame->is_visible() && pFrame->is_in_frame(iX, iY))
+            return pFrame;
+    }
+
+    return nullptr;
+}
+
+unsigned long long frame_grid::get_cell_key_(int iCellX, int iCellY) const
+{
+    return (static_cast<unsigned long long>(static_cast<uint>(iCellX)) << 32) |
+        static_cast<uint>(iCellY);
+}
+
+int frame_grid::get_cell_coord_(int iCoord) const
+{
+    if (iCoord >= 0)
+        return iCoord/int(uiCellSize_);
+    else
+        return -((-iCoord - 1)/int(uiCellSize_)) - 1;
+}
+
+void frame_grid::insert_(entry& mEntry) const
+{
+    quad2i mArea = mEntry.pFrame->get_hit_area();
+    if (mArea.is_empty())
+    {
+        mEntry.mCells = quad2i::ZERO;
+        mEntry.bLarge = false;
+        return;
+    }
+
+    mEntry.mCells = quad2i(
+        get_cell_coord_(mArea.left), get_cell_coord_(mArea.right - 1) + 1,
+        get_cell_coord_(mArea.top),  get_cell_coord_(mArea.bottom - 1) + 1
+    );
+
+    unsigned long long uiCellCount =
+        static_cast<unsigned long long>(mEntry.mCells.right - mEntry.mCells.left)*
+        static_cast<unsigned long long>(mEntry.mCells.bottom - mEntry.mCells.top);
+
+    mEntry.bLarge = uiCellCount > MAX_FRAME_CELLS;
+    if (mEntry.bLarge)
+    {
+        insert_sorted(lLargeFrameList_, mEntry.pFrame);
+        return;
+    }
+
+    for (int y = mEntry.mCells.top; y < mEntry.mCells.bottom; ++y)
+    for (int x = mEntry.mCells.left; x < mEntry.mCells.right; ++x)
+        insert_sorted(lCellList_[get_cell_key_(x, y)], mEntry.pFrame);
+}
+
+void frame_grid::erase_(const entry& mEntry) const
+{
+    if (mEntry.bLarge)
+    {
+        erase_frame(lLargeFrameList_, mEntry.pFrame);
+        return;
+    }
+
+    for (int y = mEntry.mCells.top; y < mEntry.mCells.bottom; ++y)
+    for (int x = mEntry.mCells.left; x < mEntry.mCells.right; ++x)
+    {
+        std::unordered_map<unsigned long long, std::vector<frame*>>::iterator iterCell =
+            lCellList_.find(get_cell_key_(x, y));
+        if (iterCell == lCellList_.end())
+            continue;
+
+        erase_frame(iterCell->second, mEntry.pFrame);
+        if (iterCell->second.empty())
+            lCellList_.erase(iterCell);
+    }
+}
+
+void frame_grid::update_() const
+{
+    std::vector<const frame*>::iterator iterFrame;
+    foreach (iterFrame, lDirtyFrameList_)
+    {
+        std::map<const frame*, entry>::iterator iter = lEntryList_.find(*iterFrame);
+        if (iter == lEntryList_.end())
+            continue;
+
+        entry& mEntry = iter->second;
+        erase_(mEntry);
+        insert_(mEntry);
+        mEntry.bDirty = false;
+    }
+
+    lDirtyFrameList_.clear();
+}
+}
@@ -125,6 +125,11 @@ void layered_region::set_draw_layer(const std::string& sLayer)
     }
 }
 
+quad2i layered_region::get_render_area() const
+{
+    return get_borders();
+}
+
 void layered_region::notify_renderer_need_redraw() const
 {
     if (!bVirtual_)
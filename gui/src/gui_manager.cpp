@@ -15,10 +15,12 @@
 #include "lxgui/input.hpp"
 
 #include <lxgui/luapp_state.hpp>
+#include <lxgui/xml_document.hpp>
 #include <lxgui/utils_string.hpp>
 #include <lxgui/utils_filesystem.hpp>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 
 namespace gui
 {
@@ -28,12 +30,45 @@ int l_delete_frame(lua_State* pLua);
 int l_get_locale(lua_State* pLua);
 int l_log(lua_State* pLua);
 
+// Maximum number of damaged areas tracked per strata before they are
+// merged into a single bounding area
+const uint MAX_DAMAGE_AREA = 8;
+
+void add_damage_area(std::vector<quad2i>& lList, quad2i mArea)
+{
+    // Merge overlapping areas so that the list stays disjoint : each
+    // pixel is then rendered at most once
+    std::vector<quad2i>::iterator iter = lList.begin();
+    while (iter != lList.end())
+    {
+        if (iter->overlaps(mArea))
+        {
+            mArea.extend(*iter);
+            lList.erase(iter);
+            iter = lList.begin();
+        }
+        else
+            ++iter;
+    }
+
+    if (lList.size() >= MAX_DAMAGE_AREA)
+    {
+        foreach (iter, lList)
+            mArea.extend(*iter);
+
+        lList.clear();
+    }
+
+    lList.push_back(mArea);
+}
+
 manager::manager(const input::handler& mInputHandler, const std::string& sLocale,
     uint uiScreenWidth, uint uiScreenHeight, utils::refptr<manager_impl> pImpl) :
     event_receiver(nullptr), sUIVersion_("0001"),
     uiScreenWidth_(uiScreenWidth), uiScreenHeight_(uiScreenHeight),
     bClearFontsOnClose_(true), pLua_(nullptr), pLuaRegs_(nullptr), bClosed_(true),
-    bLoadingUI_(false), bFirstIteration_(true), bInputEnabled_(true),
+    bLoadingUI_(false), bFirstIteration_(true),
+    uiLoadingThreadCount_(0), bInputEnabled_(true),
     pInputManager_(new input::manager(mInputHandler)),
     pCurrentAddOn_(nullptr), bBuildStrataList_(false), bObjectMoved_(false),
     pOveredFrame_(nullptr), bUpdateOveredFrame_(false), pFocusedFrame_(nullptr),
@@ -42,6 +77,7 @@ manager::manager(const input::handler& mInputHandler, const std::string& sLocale
     iMovementStartPositionY_(0), mConstraint_(CONSTRAINT_NONE), uiResizeStartW_(0),
     uiResizeStartH_(0), bResizeWidth_(false), bResizeHeight_(false), bResizeFromRight_(false),
     bResizeFromBottom_(false), uiFrameNumber_(0), bEnableCaching_(true),
+    bEnableLegacyScriptGlobals_(true),
     pRenderTarget_(nullptr), sLocale_(sLocale), pImpl_(pImpl)
 {
     pEventManager_ = utils::refptr<event_manager>(new event_manager());
@@ -85,6 +121,41 @@ void manager::clear_addon_directory_list()
     lGUIDirectoryList_.clear();
 }
 
+void manager::set_layout_cache_directory(const std::string& sDirectory)
+{
+    sLayoutCacheDirectory_ = sDirectory;
+}
+
+const std::string& manager::get_layout_cache_directory() const
+{
+    return sLayoutCacheDirectory_;
+}
+
+void manager::set_loading_thread_count(uint uiCount)
+{
+    uiLoadingThreadCount_ = uiCount;
+}
+
+uint manager::get_loading_thread_count() const
+{
+    return uiLoadingThreadCount_;
+}
+
+void manager::set_text_layout_cache_size(uint uiSize)
+{
+    mTextLayoutCache_.set_max_size(uiSize);
+}
+
+uint manager::get_text_layout_cache_size() const
+{
+    return mTextLayoutCache_.get_max_size();
+}
+
+text_layout_cache& manager::get_text_layout_cache()
+{
+    return mTextLayoutCache_;
+}
+
 bool manager::check_uiobject_name(const std::string& sName) const
 {
     if (utils::is_number(sName[0]))
@@ -335,14 +406,17 @@ bool manager::add_uiobject(uiobject* pObj)
             if (!pObj->is_virtual())
             {
                 if (!pObj->get_parent())
-                {
                     lMainObjectList_[i] = pObj;
-                    fire_build_strata_list();
-                }
+
+                // Anchors may have been set before the object got its ID
+                lAnchorChangedList_.push_back(i);
 
                 frame* pFrame = dynamic_cast<frame*>(pObj);
                 if (pFrame)
+                {
                     lFrameList_[i] = pFrame;
+                    notify_frame_strata_changed(pFrame);
+                }
             }
 
             return true;
@@ -378,14 +452,14 @@ void manager::remove_uiobject(uiobject* pObj)
 
         frame* pFrame = dynamic_cast<frame*>(pObj);
         if (pFrame)
+        {
             lFrameList_.erase(pObj->get_id());
+            notify_frame_strata_changed(pFrame);
+        }
     }
     else
         lNamedVirtualObjectList_.erase(pObj->get_name());
 
-    if (!pObj->is_manually_rendered())
-        fire_build_strata_list();
-
     if (pMovedObject_ == pObj)
         stop_moving(pObj);
 
@@ -408,6 +482,12 @@ void manager::notify_object_has_parent(uiobject* pObj)
     lMainObjectList_.erase(pObj->get_id());
 }
 
+void manager::notify_object_anchors_changed(uiobject* pObj)
+{
+    if (!pObj->is_virtual() && pObj->get_id() != uint(-1))
+        lAnchorChangedList_.push_back(pObj->get_id());
+}
+
 const uiobject* manager::get_uiobject(uint uiID) const
 {
     std::map<uint, uiobject*>::const_iterator iter = lObjectList_.find(uiID);
@@ -660,19 +740,40 @@ void manager::load_addon_directory_(const std::string& sDirectory)
         mFile.close();
     }
 
+    // The definition file is only parsed once, and shared by all files
+    if (!pXMLDefinition_)
+        pXMLDefinition_ = utils::refptr<xml::definition>(new xml::definition("interface/ui.def", gui::out));
+
+    mXMLLoader_.set_definition(pXMLDefinition_);
+    mXMLLoader_.set_cache_directory(sLayoutCacheDirectory_);
+
+    // Start parsing all XML files in the background
+    std::vector<addon*> lLoadedAddOnStack = lCoreAddOnStack;
+    lLoadedAddOnStack.insert(lLoadedAddOnStack.end(), lAddOnStack.begin(), lAddOnStack.end());
+
     std::vector<addon*>::iterator iterAddon;
-    foreach (iterAddon, lCoreAddOnStack)
+    foreach (iterAddon, lLoadedAddOnStack)
     {
-        if ((*iterAddon)->bEnabled)
-            this->load_addon_files_(*iterAddon);
+        if (!(*iterAddon)->bEnabled)
+            continue;
+
+        std::vector<std::string>::iterator iterFile;
+        foreach (iterFile, (*iterAddon)->lFileList)
+        {
+            if (iterFile->find(".lua") == iterFile->npos && iterFile->find(".xml") != iterFile->npos)
+                mXMLLoader_.add_file(*iterFile);
+        }
     }
 
-    foreach (iterAddon, lAddOnStack)
+    mXMLLoader_.start(uiLoadingThreadCount_);
+
+    foreach (iterAddon, lLoadedAddOnStack)
     {
         if ((*iterAddon)->bEnabled)
             this->load_addon_files_(*iterAddon);
     }
 
+    mXMLLoader_.clear();
     pCurrentAddOn_ = nullptr;
 }
 
@@ -786,6 +887,7 @@ void manager::close_ui()
 
         lMainObjectList_.clear();
         lObjectList_.clear();
+        lAnchorChangedList_.clear();
         lNamedObjectList_.clear();
 
         std::vector<uiobject*>::iterator iterRemoved;
@@ -812,9 +914,14 @@ void manager::close_ui()
         lAddOnList_.clear();
 
         lStrataList_.clear();
+        lStrataSlotList_.clear();
+        lStrataChangedList_.clear();
+        mFrameGrid_.clear();
+        mTextLayoutCache_.clear();
         bBuildStrataList_ = true;
 
         pLua_ = nullptr;
+        pXMLDefinition_ = nullptr;
 
         pOveredFrame_ = nullptr;
         bUpdateOveredFrame_ = false;
@@ -872,19 +979,7 @@ void manager::render_ui() const
         foreach (iterStrata, lStrataList_)
         {
             const strata& mStrata = iterStrata->second;
-            std::map<int, level>::const_iterator iterLevel;
-            foreach (iterLevel, mStrata.lLevelList)
-            {
-                const level& mLevel = iterLevel->second;
-
-                std::vector<frame*>::const_iterator iterFrame;
-                foreach (iterFrame, mLevel.lFrameList)
-                {
-                    frame* pFrame = *iterFrame;
-                    if (!pFrame->is_newly_created())
-                        pFrame->render();
-                }
-            }
+            render_strata_frames_(mStrata);
 
             ++mStrata.uiRedrawCount;
         }
@@ -897,9 +992,10 @@ void manager::render_quad(const quad& mQuad) const
     pImpl_->render_quad(mQuad);
 }
 
-void manager::render_quads(const quad& mQuad, const std::vector<std::array<vertex,4>>& lQuadList) const
+void manager::render_quads(const quad& mQuad, const std::vector<std::array<vertex,4>>& lQuadList,
+    const vector2f& mOffset) const
 {
-    pImpl_->render_quads(mQuad, lQuadList);
+    pImpl_->render_quads(mQuad, lQuadList, mOffset);
 }
 
 void manager::create_strata_render_target(frame_strata mframe_strata)
@@ -955,20 +1051,27 @@ void manager::render_strata_(strata& mStrata)
     if (mStrata.pRenderTarget)
     {
         begin(mStrata.pRenderTarget);
-        mStrata.pRenderTarget->clear(color::EMPTY);
 
-        std::map<int, level>::const_iterator iterLevel;
-        foreach (iterLevel, mStrata.lLevelList)
+        if (mStrata.bRedraw || mStrata.lDamageList.empty() ||
+            !pImpl_->set_scissor(mStrata.lDamageList.front()))
         {
-            const level& mLevel = iterLevel->second;
-
-            std::vector<frame*>::const_iterator iterFrame;
-            foreach (iterFrame, mLevel.lFrameList)
+            mStrata.pRenderTarget->clear(color::EMPTY);
+            render_strata_frames_(mStrata);
+        }
+        else
+        {
+            // Only render the frames that intersect the damaged areas
+            std::vector<quad2i>::const_iterator iterArea;
+            foreach (iterArea, mStrata.lDamageList)
             {
-                frame* pFrame = *iterFrame;
-                if (!pFrame->is_newly_created())
-                    pFrame->render();
+                if (iterArea != mStrata.lDamageList.begin())
+                    pImpl_->set_scissor(*iterArea);
+
+                mStrata.pRenderTarget->clear(color::EMPTY);
+                render_strata_frames_(mStrata, &(*iterArea));
             }
+
+            pImpl_->disable_scissor();
         }
 
         end();
@@ -977,6 +1080,28 @@ void manager::render_strata_(strata& mStrata)
     }
 }
 
+void manager::render_strata_frames_(const strata& mStrata, const quad2i* pArea) const
+{
+    std::vector<level>::const_iterator iterLevel;
+    foreach (iterLevel, mStrata.lLevelList)
+    {
+        const level& mLevel = *iterLevel;
+
+        std::vector<frame*>::const_iterator iterFrame;
+        foreach (iterFrame, mLevel.lFrameList)
+        {
+            frame* pFrame = *iterFrame;
+            if (pFrame->is_newly_created())
+                continue;
+
+            if (pArea && !pFrame->get_render_area().overlaps(*pArea))
+                continue;
+
+            pFrame->render();
+        }
+    }
+}
+
 bool manager::is_loading_ui() const
 {
     return bLoadingUI_;
@@ -987,6 +1112,61 @@ void manager::fire_build_strata_list()
     bBuildStrataList_ = true;
 }
 
+void manager::notify_frame_strata_changed(frame* pFrame)
+{
+    if (!pFrame->is_virtual())
+        lStrataChangedList_.push_back(pFrame->get_id());
+}
+
+void manager::add_to_strata_list_(frame* pFrame)
+{
+    if (pFrame->is_manually_rendered())
+        return;
+
+    strata& mStrata = lStrataList_[pFrame->get_frame_strata()];
+    mStrata.uiID = pFrame->get_frame_strata();
+    mStrata.add_frame(pFrame, pFrame->get_frame_level());
+    mStrata.bRedraw = true;
+
+    strata_slot& mSlot = lStrataSlotList_[pFrame->get_id()];
+    mSlot.pFrame  = pFrame;
+    mSlot.mStrata = pFrame->get_frame_strata();
+    mSlot.iLevel  = pFrame->get_frame_level();
+
+    mFrameGrid_.add_frame(pFrame);
+}
+
+void manager::update_strata_list_()
+{
+    // First remove the modified frames from where they were registered.
+    // Some of them may already have been deleted : only use their ID.
+    std::vector<uint>::iterator iterID;
+    foreach (iterID, lStrataChangedList_)
+    {
+        std::map<uint, strata_slot>::iterator iterSlot = lStrataSlotList_.find(*iterID);
+        if (iterSlot == lStrataSlotList_.end())
+            continue;
+
+        const strata_slot& mSlot = iterSlot->second;
+        std::map<frame_strata, strata>::iterator iterStrata = lStrataList_.find(mSlot.mStrata);
+        if (iterStrata != lStrataList_.end() && iterStrata->second.remove_frame(mSlot.pFrame, mSlot.iLevel))
+            iterStrata->second.bRedraw = true;
+
+        mFrameGrid_.remove_frame(mSlot.pFrame);
+        lStrataSlotList_.erase(iterSlot);
+    }
+
+    // ... then add them back where they now belong
+    foreach (iterID, lStrataChangedList_)
+    {
+        std::map<uint, frame*>::iterator iterFrame = lFrameList_.find(*iterID);
+        if (iterFrame != lFrameList_.end() && lStrataSlotList_.find(*iterID) == lStrataSlotList_.end())
+            add_to_strata_list_(iterFrame->second);
+    }
+
+    lStrataChangedList_.clear();
+}
+
 void manager::update(float fDelta)
 {
     //#define DEBUG_LOG(msg) gui::out << (msg) << std::endl
@@ -1002,6 +1182,9 @@ void manager::update(float fDelta)
         lRemovedObjectList_.clear();
     }
 
+    DEBUG_LOG(" Implementation...");
+    pImpl_->update();
+
     DEBUG_LOG(" Input...");
     pInputManager_->update(fDelta);
 
@@ -1083,22 +1266,34 @@ void manager::update(float fDelta)
     }
 
     DEBUG_LOG(" Update anchors...");
-    // update anchors for all widgets
-    std::map<uint, uiobject*>::iterator iterObj;
-    foreach (iterObj, lObjectList_)
+    // update anchors for the widgets that have changed
+    if (!lAnchorChangedList_.empty())
     {
-        if (!iterObj->second->is_virtual())
-            iterObj->second->update_anchors();
+        std::vector<uint> lChangedList;
+        lChangedList.swap(lAnchorChangedList_);
+        std::sort(lChangedList.begin(), lChangedList.end());
+
+        std::vector<uint>::iterator iterID;
+        foreach (iterID, lChangedList)
+        {
+            std::map<uint, uiobject*>::iterator iterObj = lObjectList_.find(*iterID);
+            if (iterObj != lObjectList_.end() && !iterObj->second->is_virtual())
+                iterObj->second->update_anchors();
+        }
     }
 
     DEBUG_LOG(" Update widgets...");
-    // ... then update logics on main widgets from parent to children.
+    // ... then update logics on main widgets from parent to children,
+    // skipping those that have nothing to do (see uiobject::fire_update()).
+    std::map<uint, uiobject*>::iterator iterObj;
     foreach (iterObj, lMainObjectList_)
     {
-        if (!iterObj->second->is_virtual())
+        if (!iterObj->second->is_virtual() && iterObj->second->is_update_needed())
             iterObj->second->update(fDelta);
     }
 
+    bool bStrataListUpdated = bBuildStrataList_ || !lStrataChangedList_.empty();
+
     if (bBuildStrataList_)
     {
         DEBUG_LOG(" Build strata...");
@@ -1109,24 +1304,26 @@ void manager::update(float fDelta)
             iterStrata->second.bRedraw = true;
         }
 
+        lStrataSlotList_.clear();
+        lStrataChangedList_.clear();
+        mFrameGrid_.clear();
+
         std::map<uint, frame*>::iterator iterFrame;
         foreach (iterFrame, lFrameList_)
-        {
-            frame* pFrame = iterFrame->second;
-            if (!pFrame->is_manually_rendered())
-            {
-                strata& mStrata = lStrataList_[pFrame->get_frame_strata()];
-                mStrata.lLevelList[pFrame->get_frame_level()].lFrameList.push_back(pFrame);
-
-                mStrata.uiID = pFrame->get_frame_strata();
-            }
-        }
+            add_to_strata_list_(iterFrame->second);
+    }
+    else if (!lStrataChangedList_.empty())
+    {
+        DEBUG_LOG(" Update strata...");
+        update_strata_list_();
     }
 
     if (bEnableCaching_)
     {
         DEBUG_LOG(" Redraw strata...");
-        bool bRedraw = false;
+        const quad2i mScreen(0, uiScreenWidth_, 0, uiScreenHeight_);
+        std::vector<quad2i> lScreenDamageList;
+
         std::map<frame_strata, strata>::iterator iterStrata;
         foreach (iterStrata, lStrataList_)
         {
@@ -1135,28 +1332,48 @@ void manager::update(float fDelta)
             if (mStrata.bRedraw)
             {
                 render_strata_(mStrata);
-                bRedraw = true;
+                add_damage_area(lScreenDamageList, mScreen);
+            }
+            else if (!mStrata.lDamageList.empty())
+            {
+                render_strata_(mStrata);
+
+                std::vector<quad2i>::const_iterator iterArea;
+                foreach (iterArea, mStrata.lDamageList)
+                    add_damage_area(lScreenDamageList, *iterArea);
             }
 
             mStrata.bRedraw = false;
+            mStrata.lDamageList.clear();
         }
 
-        if (bRedraw && pRenderTarget_)
+        if (!lScreenDamageList.empty() && pRenderTarget_)
         {
             begin(pRenderTarget_);
-            pRenderTarget_->clear(color::EMPTY);
 
-            foreach (iterStrata, lStrataList_)
+            // Only copy the damaged areas of each strata to the screen
+            std::vector<quad2i>::const_iterator iterArea;
+            foreach (iterArea, lScreenDamageList)
             {
-                if (iterStrata->second.pSprite)
-                    iterStrata->second.pSprite->render(0, 0);
+                bool bScissor = pImpl_->set_scissor(*iterArea);
+
+                pRenderTarget_->clear(color::EMPTY);
+
+                foreach (iterStrata, lStrataList_)
+                {
+                    if (iterStrata->second.pSprite)
+                        iterStrata->second.pSprite->render(0, 0);
+                }
+
+                if (!bScissor)
+                    break;
             }
 
             end();
         }
     }
 
-    if (bBuildStrataList_ || bObjectMoved_ ||
+    if (bStrataListUpdated || bObjectMoved_ ||
         (pInputManager_->get_mouse_raw_dx() != 0.0f) ||
         (pInputManager_->get_mouse_raw_dy() != 0.0f))
         bUpdateOveredFrame_ = true;
@@ -1167,32 +1384,7 @@ void manager::update(float fDelta)
         int iX = pInputManager_->get_mouse_x();
         int iY = pInputManager_->get_mouse_y();
 
-        frame* pOveredFrame = nullptr;
-
-        std::map<frame_strata, strata>::const_iterator iterStrata = lStrataList_.end();
-        while (iterStrata != lStrataList_.begin() && !pOveredFrame)
-        {
-            --iterStrata;
-            const strata& mStrata = iterStrata->second;
-
-            std::map<int, level>::const_iterator iterLevel = mStrata.lLevelList.end();
-            while (iterLevel != mStrata.lLevelList.begin() && !pOveredFrame)
-            {
-                --iterLevel;
-                const level& mLevel = iterLevel->second;
-
-                std::vector<frame*>::const_iterator iterFrame;
-                foreach (iterFrame, mLevel.lFrameList)
-                {
-                    frame* pFrame = *iterFrame;
-                    if (pFrame->is_mouse_enabled() && pFrame->is_visible() && pFrame->is_in_frame(iX, iY))
-                    {
-                        pOveredFrame = pFrame;
-                        break;
-                    }
-                }
-            }
-        }
+        frame* pOveredFrame = mFrameGrid_.find_frame(iX, iY);
 
         set_overed_frame_(pOveredFrame, iX, iY);
 
@@ -1384,6 +1576,20 @@ void manager::fire_redraw(frame_strata mStrata) const
         iter->second.bRedraw = true;
 }
 
+void manager::fire_redraw(frame_strata mStrata, const quad2i& mArea) const
+{
+    std::map<frame_strata, strata>::const_iterator iter = lStrataList_.find(mStrata);
+    if (iter == lStrataList_.end() || iter->second.bRedraw)
+        return;
+
+    quad2i mClipped = mArea;
+    mClipped.clip(quad2i(0, uiScreenWidth_, 0, uiScreenHeight_));
+    if (mClipped.is_empty())
+        return;
+
+    add_damage_area(iter->second.lDamageList, mClipped);
+}
+
 void manager::toggle_caching()
 {
     bEnableCaching_ = !bEnableCaching_;
@@ -1407,6 +1613,16 @@ bool manager::is_caching_enabled() const
     return bEnableCaching_;
 }
 
+void manager::enable_legacy_script_globals(bool bEnable)
+{
+    bEnableLegacyScriptGlobals_ = bEnable;
+}
+
+bool manager::is_legacy_script_globals_enabled() const
+{
+    return bEnableLegacyScriptGlobals_;
+}
+
 void manager::enable_input(bool bEnable)
 {
     if (bInputEnabled_ != bEnable)
@@ -1557,11 +1773,7 @@ int manager::get_highest_level(frame_strata mFrameStrata) const
     if (iterStrata != lStrataList_.end())
     {
         if (!iterStrata->second.lLevelList.empty())
-        {
-            std::map<int, level>::const_iterator iterLevel = iterStrata->second.lLevelList.end();
-            --iterLevel;
-            return iterLevel->first;
-        }
+            return iterStrata->second.lLevelList.back().iLevel;
     }
 
     return 0;
@@ -1765,6 +1977,19 @@ utils::refptr<sprite> manager_impl::create_sprite(utils::refptr<material> pMat,
     return nullptr;
 }
 
+bool manager_impl::set_scissor(const quad2i& mArea) const
+{
+    return false;
+}
+
+void manager_impl::disable_scissor() const
+{
+}
+
+void manager_impl::update()
+{
+}
+
 void manager_impl::set_parent(manager* pParent)
 {
     pParent_ = pParent;
@@ -1777,4 +2002,52 @@ strata::strata() : uiID(uint(-1)), bRedraw(true), uiRedrawCount(0u)
 strata::~strata()
 {
 }
+
+bool is_level_lower(const level& mLevel, int iLevel)
+{
+    return mLevel.iLevel < iLevel;
+}
+
+bool is_frame_id_lower(const frame* pFrame1, const frame* pFrame2)
+{
+    return pFrame1->get_id() < pFrame2->get_id();
+}
+
+void strata::add_frame(frame* pFrame, int iLevel)
+{
+    std::vector<level>::iterator iterLevel = std::lower_bound(
+        lLevelList.begin(), lLevelList.end(), iLevel, &is_level_lower
+    );
+
+    if (iterLevel == lLevelList.end() || iterLevel->iLevel != iLevel)
+    {
+        level mLevel;
+        mLevel.iLevel = iLevel;
+        iterLevel = lLevelList.insert(iterLevel, mLevel);
+    }
+
+    std::vector<frame*>& lFrameList = iterLevel->lFrameList;
+    lFrameList.insert(std::upper_bound(lFrameList.begin(), lFrameList.end(), pFrame, &is_frame_id_lower), pFrame);
+}
+
+bool strata::remove_frame(frame* pFrame, int iLevel)
+{
+    std::vector<level>::iterator iterLevel = std::lower_bound(
+        lLevelList.begin(), lLevelList.end(), iLevel, &is_level_lower
+    );
+
+    if (iterLevel == lLevelList.end() || iterLevel->iLevel != iLevel)
+        return false;
+
+    std::vector<frame*>& lFrameList = iterLevel->lFrameList;
+    std::vector<frame*>::iterator iterFrame = std::find(lFrameList.begin(), lFrameList.end(), pFrame);
+    if (iterFrame == lFrameList.end())
+        return false;
+
+    lFrameList.erase(iterFrame);
+    if (lFrameList.empty())
+        lLevelList.erase(iterLevel);
+
+    return true;
+}
 }
@@ -13,11 +13,12 @@ namespace gui
 {
 void manager::parse_xml_file_(const std::string& sFile, addon* pAddOn)
 {
-    xml::document mDoc(sFile, "interface/ui.def", gui::out);
-    if (mDoc.check())
+    bool bValid;
+    utils::refptr<xml::document> pDoc = mXMLLoader_.load_file(sFile, bValid);
+    if (bValid)
     {
         xml::block* pElemBlock;
-        foreach_block (pElemBlock, mDoc.get_main_block())
+        foreach_block (pElemBlock, pDoc->get_main_block())
         {
             if (pElemBlock->get_name() == "Script")
             {
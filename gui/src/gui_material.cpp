@@ -9,5 +9,10 @@ material::material()
 material::~material()
 {
 }
+
+bool material::is_ready() const
+{
+    return true;
+}
 }
 
@@ -33,4 +33,10 @@ bool region::is_in_region(int iX, int iY) const
     return ((lBorderList_.left <= iX && iX <= lBorderList_.right  - 1) &&
             (lBorderList_.top  <= iY && iY <= lBorderList_.bottom - 1));
 }
+
+void region::notify_borders_updated() const
+{
+    if (pParent_)
+        pParent_->notify_borders_updated();
+}
 }
@@ -39,7 +39,7 @@ bool scroll_frame::can_use_script(const std::string& sScriptName) const
         return false;
 }
 
-void scroll_frame::on(const std::string& sScriptName, event* pEvent)
+void scroll_frame::on(const std::string& sScriptName, const event* pEvent)
 {
     frame::on(sScriptName, pEvent);
 
@@ -99,6 +99,7 @@ void scroll_frame::set_scroll_child(frame* pFrame)
 
         lScrollChildList_.clear();
         lScrollStrataList_.clear();
+        mScrollFrameGrid_.clear();
     }
     else if (!is_virtual() && !pScrollTexture_)
     {
@@ -172,7 +173,7 @@ void scroll_frame::set_horizontal_scroll(int iHorizontalScroll)
     if (iHorizontalScroll_ != iHorizontalScroll)
     {
         iHorizontalScroll_ = iHorizontalScroll;
-        lQueuedEventList_.push_back("HorizontalScroll");
+        queue_event_("HorizontalScroll");
 
         pScrollChild_->modify_point(ANCHOR_TOPLEFT)->set_abs_offset(-iHorizontalScroll_, -iVerticalScroll_);
         fire_redraw();
@@ -194,7 +195,7 @@ void scroll_frame::set_vertical_scroll(int iVerticalScroll)
     if (iVerticalScroll_ != iVerticalScroll)
     {
         iVerticalScroll_ = iVerticalScroll;
-        lQueuedEventList_.push_back("VerticalScroll");
+        queue_event_("VerticalScroll");
 
         pScrollChild_->modify_point(ANCHOR_TOPLEFT)->set_abs_offset(-iHorizontalScroll_, -iVerticalScroll_);
         fire_redraw();
@@ -261,6 +262,9 @@ void scroll_frame::update(float fDelta)
             render_scroll_strata_list_();
             bRedrawScrollRenderTarget_ = false;
         }
+
+        // The scroll child's input and rendering are checked on each update
+        fire_update();
     }
 }
 
@@ -282,32 +286,7 @@ void scroll_frame::update_scroll_child_input_()
 
     if (bMouseInScrollTexture_)
     {
-        frame* pOveredFrame = nullptr;
-
-        std::map<frame_strata, strata>::const_iterator iterStrata = lScrollStrataList_.end();
-        while (iterStrata != lScrollStrataList_.begin() && !pOveredFrame)
-        {
-            --iterStrata;
-            const strata& mStrata = iterStrata->second;
-
-            std::map<int, level>::const_iterator iterLevel = mStrata.lLevelList.end();
-            while (iterLevel != mStrata.lLevelList.begin() && !pOveredFrame)
-            {
-                --iterLevel;
-                const level& mLevel = iterLevel->second;
-
-                std::vector<frame*>::const_iterator iterFrame;
-                foreach (iterFrame, mLevel.lFrameList)
-                {
-                    frame* pFrame = *iterFrame;
-                    if (pFrame->is_mouse_enabled() && pFrame->is_visible() && pFrame->is_in_frame(iX, iY))
-                    {
-                        pOveredFrame = pFrame;
-                        break;
-                    }
-                }
-            }
-        }
+        frame* pOveredFrame = mScrollFrameGrid_.find_frame(iX, iY);
 
         if (pOveredFrame != pOveredScrollChild_)
         {
@@ -354,14 +333,15 @@ void scroll_frame::rebuild_scroll_render_target_()
 void scroll_frame::rebuild_scroll_strata_list_()
 {
     lScrollStrataList_.clear();
+    mScrollFrameGrid_.clear();
 
     std::map<uint, frame*>::iterator iterFrame;
     foreach (iterFrame, lScrollChildList_)
     {
         frame* pFrame = iterFrame->second;
-        lScrollStrataList_[pFrame->get_frame_strata()].
-            lLevelList[pFrame->get_frame_level()].
-                lFrameList.push_back(pFrame);
+        lScrollStrataList_[pFrame->get_frame_strata()].add_frame(pFrame, pFrame->get_frame_level());
+
+        mScrollFrameGrid_.add_frame(pFrame);
     }
 }
 
@@ -375,10 +355,10 @@ void scroll_frame::render_scroll_strata_list_()
     {
         const strata& mStrata = iterStrata->second;
 
-        std::map<int, level>::const_iterator iterLevel;
+        std::vector<level>::const_iterator iterLevel;
         foreach (iterLevel, mStrata.lLevelList)
         {
-            const level& mLevel = iterLevel->second;
+            const level& mLevel = *iterLevel;
 
             std::vector<frame*>::const_iterator iterFrame;
             foreach (iterFrame, mLevel.lFrameList)
@@ -401,6 +381,15 @@ bool scroll_frame::is_in_frame(int iX, int iY) const
         return frame::is_in_frame(iX, iY);
 }
 
+quad2i scroll_frame::get_hit_area() const
+{
+    quad2i mArea = frame::get_hit_area();
+    if (pScrollTexture_)
+        mArea.extend(pScrollTexture_->get_borders());
+
+    return mArea;
+}
+
 void scroll_frame::notify_mouse_in_frame(bool bMouseInFrame, int iX, int iY)
 {
     frame::notify_mouse_in_frame(bMouseInFrame, iX, iY);
@@ -417,13 +406,8 @@ void scroll_frame::notify_child_strata_changed(frame* pChild)
 {
     if (pChild == pScrollChild_)
         bRebuildScrollStrataList_ = true;
-    else
-    {
-        if (pParentFrame_)
-            pParentFrame_->notify_child_strata_changed(this);
-        else
-            pManager_->fire_build_strata_list();
-    }
+    else if (pParentFrame_)
+        pParentFrame_->notify_child_strata_changed(this);
 }
 
 void scroll_frame::create_glue()
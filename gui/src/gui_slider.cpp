@@ -165,6 +165,7 @@ void slider::on_event(const event& mEvent)
                     std::bind(&slider::constrain_thumb_, this)
                 );
                 bThumbMoved_ = true;
+                fire_update();
             }
             else if (bMouseInFrame_ && bAllowClicksOutsideThumb_)
             {
@@ -197,6 +198,7 @@ void slider::on_event(const event& mEvent)
                         mOrientation_ == ORIENT_HORIZONTAL ? CONSTRAINT_X : CONSTRAINT_Y
                     );
                     bThumbMoved_ = true;
+                    fire_update();
                 }
             }
         }
@@ -222,7 +224,7 @@ void slider::set_min_value(float fMin)
         if (fValue_ < fMinValue_)
         {
             fValue_ = fMinValue_;
-            lQueuedEventList_.push_back("ValueChanged");
+            queue_event_("ValueChanged");
         }
 
         fire_update_thumb_texture_();
@@ -240,7 +242,7 @@ void slider::set_max_value(float fMax)
         if (fValue_ > fMaxValue_)
         {
             fValue_ = fMaxValue_;
-            lQueuedEventList_.push_back("ValueChanged");
+            queue_event_("ValueChanged");
         }
 
         fire_update_thumb_texture_();
@@ -259,7 +261,7 @@ void slider::set_min_max_values(float fMin, float fMax)
         if (fValue_ > fMaxValue_ || fValue_ < fMinValue_)
         {
             fValue_ = fValue_ > fMaxValue_ ? fMaxValue_ : (fValue_ < fMinValue_ ? fMinValue_ : fValue_);
-            lQueuedEventList_.push_back("ValueChanged");
+            queue_event_("ValueChanged");
         }
 
         fire_update_thumb_texture_();
@@ -275,7 +277,7 @@ void slider::set_value(float fValue, bool bSilent)
         step_value(fValue_, fValueStep_);
 
         if (!bSilent)
-            lQueuedEventList_.push_back("ValueChanged");
+            queue_event_("ValueChanged");
 
         fire_update_thumb_texture_();
     }
@@ -295,7 +297,7 @@ void slider::set_value_step(float fValueStep)
         fValue_ = fValue_ > fMaxValue_ ? fMaxValue_ : (fValue_ < fMinValue_ ? fMinValue_ : fValue_);
 
         if (fValue_ != fOldValue)
-            lQueuedEventList_.push_back("ValueChanged");
+            queue_event_("ValueChanged");
 
         fire_update_thumb_texture_();
     }
@@ -436,6 +438,15 @@ bool slider::is_in_frame(int iX, int iY) const
     }
 }
 
+quad2i slider::get_hit_area() const
+{
+    quad2i mArea = frame::get_hit_area();
+    if (pThumbTexture_)
+        mArea.extend(pThumbTexture_->get_borders());
+
+    return mArea;
+}
+
 void slider::notify_mouse_in_frame(bool bMouseInFrame, int iX, int iY)
 {
     if (bAllowClicksOutsideThumb_)
@@ -476,7 +487,7 @@ void slider::update(float fDelta)
                 step_value(fValue_, fValueStep_);
 
                 if (fValue_ != fOldValue)
-                    lQueuedEventList_.push_back("ValueChanged");
+                    queue_event_("ValueChanged");
             }
 
             float fCoef = (fValue_ - fMinValue_)/(fMaxValue_ - fMinValue_);
@@ -529,5 +540,6 @@ void slider::create_glue()
 void slider::fire_update_thumb_texture_() const
 {
     bUpdateThumbTexture_ = true;
+    fire_update();
 }
 }
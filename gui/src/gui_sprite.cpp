@@ -143,9 +143,10 @@ void sprite::render_4v(float fX1, float fY1,
     pManager_->render_quad(mQuad_);
 }
 
-void sprite::render_quads(const std::vector<std::array<vertex,4>>& lQuadsArray) const
+void sprite::render_quads(const std::vector<std::array<vertex,4>>& lQuadsArray,
+    const vector2f& mOffset) const
 {
-    pManager_->render_quads(mQuad_, lQuadsArray);
+    pManager_->render_quads(mQuad_, lQuadsArray, mOffset);
 }
 
 void sprite::render_static() const
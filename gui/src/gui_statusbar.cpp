@@ -371,5 +371,6 @@ void status_bar::update(float fDelta)
 void status_bar::fire_update_bar_texture_()
 {
     bUpdateBarTexture_ = true;
+    fire_update();
 }
 }
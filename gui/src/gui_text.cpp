@@ -1,4 +1,5 @@
 #include "lxgui/gui_text.hpp"
+#include "lxgui/gui_textlayoutcache.hpp"
 #include "lxgui/gui_font.hpp"
 #include "lxgui/gui_sprite.hpp"
 #include "lxgui/gui_material.hpp"
@@ -13,10 +14,13 @@ text::text(manager* pManager, const std::string& sFileName, float fSize) :
     pManager_(pManager), sFileName_(sFileName), bReady_(false), fSize_(fSize), fTracking_(0.0f),
     fLineSpacing_(1.5f), fSpaceWidth_(0.0f), bRemoveStartingSpaces_(false), bWordWrap_(true),
     bAddEllipsis_(false), mColor_(color::WHITE), bForceColor_(false), bFormattingEnabled_(false),
-    fW_(0.0f), fH_(0.0f), fX_(std::numeric_limits<float>::infinity()),
-    fY_(std::numeric_limits<float>::infinity()), fBoxW_(std::numeric_limits<float>::infinity()),
-    fBoxH_(std::numeric_limits<float>::infinity()), mAlign_(ALIGN_LEFT), mVertAlign_(ALIGN_MIDDLE),
-    bUpdateCache_(false), bUpdateQuads_(false)
+    bLayoutSharingEnabled_(true),
+    fBoxW_(std::numeric_limits<float>::infinity()), fBoxH_(std::numeric_limits<float>::infinity()),
+    bUpdateText_(false), mAlign_(ALIGN_LEFT), mVertAlign_(ALIGN_MIDDLE),
+    uiEditStart_(uint(-1)), uiEditTail_(uint(-1)), bUpdateCache_(false),
+    bRebuildLayout_(true), bLayoutComplete_(false), uiFontRevision_(0u),
+    pLayout_(new layout()), bUpdateQuads_(false), bUpdateOutlineQuads_(false),
+    fOutlineThickness_(0.0f), bUpdateCopyQuads_(false)
 
 {
     pFont_ = pManager_->create_font(sFileName_, fSize_);
@@ -54,16 +58,47 @@ float text::get_line_height() const
 
 void text::set_text(const std::string& sText)
 {
-    if (sText_ != sText)
+    if (get_text() != sText)
     {
+        set_unicode_text(utils::UTF8_to_unicode(sText));
         sText_ = sText;
-        sUnicodeText_ = utils::UTF8_to_unicode(sText_);
-        bUpdateCache_ = true;
+        bUpdateText_ = false;
     }
 }
 
+void text::set_unicode_text(const utils::ustring& sText)
+{
+    // Only the characters between the common prefix
+    // and the common suffix have been edited
+    uint uiMinSize = std::min(sUnicodeText_.size(), sText.size());
+    uint uiPrefix = std::mismatch(
+        sUnicodeText_.begin(), sUnicodeText_.begin() + uiMinSize, sText.begin()
+    ).first - sUnicodeText_.begin();
+
+    if (uiPrefix == uiMinSize && sUnicodeText_.size() == sText.size())
+        return;
+
+    uint uiSuffix = std::mismatch(
+        sUnicodeText_.rbegin(), sUnicodeText_.rbegin() + (uiMinSize - uiPrefix), sText.rbegin()
+    ).first - sUnicodeText_.rbegin();
+
+    uiEditStart_ = std::min(uiEditStart_, uiPrefix);
+    uiEditTail_  = std::min(uiEditTail_, uiSuffix);
+
+    sUnicodeText_ = sText;
+    bUpdateText_ = true;
+    bUpdateCache_ = true;
+}
+
 const std::string& text::get_text() const
 {
+    // The UTF-8 string is only built when needed
+    if (bUpdateText_)
+    {
+        sText_ = utils::unicode_to_UTF8(sUnicodeText_);
+        bUpdateText_ = false;
+    }
+
     return sText_;
 }
 
@@ -92,7 +127,9 @@ void text::set_dimensions(float fW, float fH)
     if (fBoxW_ != fW && fBoxH_ != fH)
     {
         fBoxW_ = fW; fBoxH_ = fH;
+        lParagraphList_.clear();
         bUpdateCache_ = true;
+        bRebuildLayout_ = true;
     }
 }
 
@@ -101,7 +138,9 @@ void text::set_box_width(float fBoxW)
     if (fBoxW_ != fBoxW)
     {
         fBoxW_ = fBoxW;
+        lParagraphList_.clear();
         bUpdateCache_ = true;
+        bRebuildLayout_ = true;
     }
 }
 
@@ -111,6 +150,7 @@ void text::set_box_height(float fBoxH)
     {
         fBoxH_ = fBoxH;
         bUpdateCache_ = true;
+        bRebuildLayout_ = true;
     }
 }
 
@@ -118,14 +158,14 @@ float text::get_width()
 {
     update();
 
-    return fW_;
+    return pLayout_->fW;
 }
 
 float text::get_height()
 {
     update();
 
-    return fH_;
+    return pLayout_->fH;
 }
 
 float text::get_box_width() const
@@ -175,9 +215,9 @@ float text::get_text_height() const
     if (bReady_)
     {
         uint count = 0;
-        size_t pos = sText_.find("\n");
-        while (pos != sText_.npos)
-            pos = sText_.find("\n", pos+1);
+        size_t pos = sUnicodeText_.find(TO_U('\n'));
+        while (pos != sUnicodeText_.npos)
+            pos = sUnicodeText_.find(TO_U('\n'), pos+1);
 
         fHeight = (1.0f + count*fLineSpacing_)*get_line_height();
     }
@@ -192,36 +232,80 @@ float text::get_string_width(const std::string& sString) const
 
 float text::get_string_width(const utils::ustring& sString) const
 {
-    float fWidth = 0.0f;
-    float fMaxWidth = std::numeric_limits<float>::infinity();
+    float fMaxWidth = 0.0f;
     if (bReady_)
     {
-        utils::ustring::const_iterator iterChar, iterNext;
-        foreach (iterChar, sString)
+        // Each line is measured separately, the widest one gives the width
+        utils::ustring::size_type uiStart = 0;
+        while (true)
         {
-            iterNext = iterChar + 1;
-            if (*iterChar == ' ')
-                fWidth += fSpaceWidth_ + fTracking_;
-            else if (*iterChar == '\t')
-                fWidth += 4*fSpaceWidth_ + fTracking_;
-            else if (*iterChar == '\n')
-            {
-                if (fWidth > fMaxWidth)
-                    fMaxWidth = fWidth;
-                fWidth = 0.0f;
-            }
-            else
-            {
-                fWidth += get_character_width(*iterChar) + fTracking_;
-                if (iterNext != sString.end())
-                {
-                    if (*iterNext != TO_U(' ') && *iterNext != TO_U('\n'))
-                        fWidth += get_character_kerning(*iterChar, *iterNext);
-                }
-            }
+            utils::ustring::size_type uiEnd = sString.find(TO_U('\n'), uiStart);
+            if (uiEnd == sString.npos)
+                uiEnd = sString.size();
+
+            fMaxWidth = std::max(fMaxWidth, get_line_width_(sString.data() + uiStart, uiEnd - uiStart));
+
+            if (uiEnd == sString.size())
+                break;
+
+            uiStart = uiEnd + 1;
         }
     }
 
+    return fMaxWidth;
+}
+
+void text::get_string_widths(const std::vector<utils::ustring>& lStringList, std::vector<float>& lWidthList) const
+{
+    lWidthList.resize(lStringList.size());
+
+    std::vector<utils::ustring>::const_iterator iterString;
+    foreach (iterString, lStringList)
+        lWidthList[iterString - lStringList.begin()] = get_string_width(*iterString);
+}
+
+float text::get_line_width_(const char32_t* pChars, uint uiCount) const
+{
+    if (uiCount == 0)
+        return 0.0f;
+
+    // Gather the widths and kernings of all the characters from the font
+    // at once, then sum them : this avoids a virtual call and a lookup
+    // for each character
+    if (lWidthBuffer_.size() < uiCount)
+    {
+        lWidthBuffer_.resize(uiCount);
+        lKerningBuffer_.resize(uiCount);
+    }
+
+    float* pWidths = &lWidthBuffer_[0];
+    float* pKernings = &lKerningBuffer_[0];
+
+    pFont_->get_character_widths(pChars, uiCount, pWidths);
+    pFont_->get_character_kernings(pChars, uiCount, pKernings);
+    pKernings[uiCount-1] = 0.0f;
+
+    // Spaces and tabs use the text's space width, and are not kerned
+    for (uint i = 0; i < uiCount; ++i)
+    {
+        if (pChars[i] == TO_U(' '))
+        {
+            pWidths[i] = fSpaceWidth_;
+            pKernings[i] = 0.0f;
+            if (i != 0)
+                pKernings[i-1] = 0.0f;
+        }
+        else if (pChars[i] == TO_U('\t'))
+        {
+            pWidths[i] = 4*fSpaceWidth_;
+            pKernings[i] = 0.0f;
+        }
+    }
+
+    float fWidth = uiCount*fTracking_;
+    for (uint i = 0; i < uiCount; ++i)
+        fWidth += pWidths[i] + pKernings[i];
+
     return fWidth;
 }
 
@@ -251,6 +335,7 @@ void text::set_alignment(const text::alignment& mAlign)
     {
         mAlign_ = mAlign;
         bUpdateCache_ = true;
+        bRebuildLayout_ = true;
     }
 }
 
@@ -260,6 +345,7 @@ void text::set_vertical_alignment(const text::vertical_alignment& mVertAlign)
     {
         mVertAlign_ = mVertAlign;
         bUpdateCache_ = true;
+        bRebuildLayout_ = true;
     }
 }
 
@@ -278,7 +364,9 @@ void text::set_tracking(float fTracking)
     if (fTracking_ != fTracking)
     {
         fTracking_ = fTracking;
+        lParagraphList_.clear();
         bUpdateCache_ = true;
+        bRebuildLayout_ = true;
     }
 }
 
@@ -293,6 +381,7 @@ void text::set_line_spacing(float fLineSpacing)
     {
         fLineSpacing_ = fLineSpacing;
         bUpdateCache_ = true;
+        bRebuildLayout_ = true;
     }
 }
 
@@ -306,7 +395,9 @@ void text::set_remove_starting_spaces(bool bRemoveStartingSpaces)
     if (bRemoveStartingSpaces_ != bRemoveStartingSpaces)
     {
         bRemoveStartingSpaces_ = bRemoveStartingSpaces;
+        lParagraphList_.clear();
         bUpdateCache_ = true;
+        bRebuildLayout_ = true;
     }
 }
 
@@ -321,7 +412,9 @@ void text::enable_word_wrap(bool bWrap, bool bAddEllipsis)
     {
         bWordWrap_ = bWrap;
         bAddEllipsis_ = bAddEllipsis;
+        lParagraphList_.clear();
         bUpdateCache_ = true;
+        bRebuildLayout_ = true;
     }
 }
 
@@ -335,7 +428,19 @@ void text::enable_formatting(bool bFormatting)
     if (bFormattingEnabled_ != bFormatting)
     {
         bFormattingEnabled_ = bFormatting;
+        lParagraphList_.clear();
+        bUpdateCache_ = true;
+        bRebuildLayout_ = true;
+    }
+}
+
+void text::enable_layout_sharing(bool bShare)
+{
+    if (bLayoutSharingEnabled_ != bShare)
+    {
+        bLayoutSharingEnabled_ = bShare;
         bUpdateCache_ = true;
+        bRebuildLayout_ = true;
     }
 }
 
@@ -345,63 +450,58 @@ void text::render(float fX, float fY)
     {
         update();
 
-        if (fX != fX_ || fY != fY_)
-            bUpdateQuads_ = true;
-
         if (bUpdateQuads_)
-        {
-            fX_ = fX;
-            fY_ = fY;
+            update_quads_();
 
-            lQuadList_.clear();
+        pSprite_->render_quads(lQuadList_, vector2f(fX, fY));
+    }
+}
 
-            std::array<vertex,4> lVertexList;
+bool text::render_outlined(float fX, float fY, float fThickness)
+{
+    if (!bReady_)
+        return false;
 
-            if (!bFormattingEnabled_)
-            {
-                for (uint i = 0; i < 4; ++i)
-                    lVertexList[i].col = mColor_;
-            }
+    utils::refptr<material> pMaterial = pFont_->get_outline_texture(fThickness).lock();
+    if (!pMaterial)
+        return false;
 
-            std::vector<letter>::iterator iterLetter;
-            foreach (iterLetter, lLetterCache_)
-            {
-                if (iterLetter->bNoRender)
-                    continue;
+    if (pMaterial != pOutlineMaterial_)
+    {
+        pOutlineMaterial_ = pMaterial;
+        pOutlineSprite_ = pManager_->create_sprite(pOutlineMaterial_);
+    }
 
-                quad2f mQuad = iterLetter->mQuad + vector2f(fX, fY);
+    update();
 
-                lVertexList[0].pos = mQuad.top_left();
-                lVertexList[1].pos = mQuad.top_right();
-                lVertexList[2].pos = mQuad.bottom_right();
-                lVertexList[3].pos = mQuad.bottom_left();
+    if (bUpdateQuads_)
+        update_quads_();
 
-                lVertexList[0].uvs = iterLetter->mUVs.top_left();
-                lVertexList[1].uvs = iterLetter->mUVs.top_right();
-                lVertexList[2].uvs = iterLetter->mUVs.bottom_right();
-                lVertexList[3].uvs = iterLetter->mUVs.bottom_left();
+    if (bUpdateOutlineQuads_ || fThickness != fOutlineThickness_)
+        update_outline_quads_(fThickness);
 
-                if (bFormattingEnabled_)
-                {
-                    if (iterLetter->mColor != color::EMPTY && !bForceColor_)
-                    {
-                        for (uint i = 0; i < 4; ++i)
-                            lVertexList[i].col = iterLetter->mColor;
-                    }
-                    else
-                    {
-                        for (uint i = 0; i < 4; ++i)
-                            lVertexList[i].col = mColor_;
-                    }
-                }
+    pOutlineSprite_->render_quads(lOutlineQuadList_, vector2f(fX, fY));
+    return true;
+}
 
-                lQuadList_.push_back(lVertexList);
-            }
+bool text::is_outline_supported(float fThickness) const
+{
+    return bReady_ && pFont_->get_outline_texture(fThickness);
+}
 
-            bUpdateQuads_ = false;
-        }
+void text::render_copies(float fX, float fY, const std::vector<copy>& lCopyList)
+{
+    if (bReady_)
+    {
+        update();
+
+        if (bUpdateQuads_)
+            update_quads_();
+
+        if (bUpdateCopyQuads_ || lCopyList != lCopyList_)
+            update_copy_quads_(lCopyList);
 
-        pSprite_->render_quads(lQuadList_);
+        pSprite_->render_quads(lCopyQuadList_, vector2f(fX, fY));
     }
 }
 
@@ -410,19 +510,80 @@ void text::update()
     //#define DEBUG_LOG(msg) gui::out << (msg) << std::endl
     #define DEBUG_LOG(msg)
 
+    // The font texture may grow while new characters are loaded,
+    // which changes the uv coordinates of the previous ones
+    if (bReady_ && uiFontRevision_ != pFont_->get_texture_revision())
+    {
+        bUpdateCache_ = true;
+        bRebuildLayout_ = true;
+    }
+
     if (bReady_ && bUpdateCache_)
     {
-        DEBUG_LOG("    Update lines");
-        update_lines_();
-        DEBUG_LOG("    Update cache");
-        update_cache_();
-        DEBUG_LOG("    .");
+        // When only the text of an unshared layout has changed,
+        // the edited paragraphs are updated in place
+        if (!bRebuildLayout_ && !bLayoutSharingEnabled_ && update_edited_lines_())
+        {
+            bUpdateCache_ = false;
+            return;
+        }
+
+        text_layout_cache::key mKey;
+        mKey.pFont        = pFont_.get();
+        mKey.fSize        = fSize_;
+        mKey.fBoxW        = fBoxW_;
+        mKey.fBoxH        = fBoxH_;
+        mKey.iAlign       = mAlign_;
+        mKey.iVertAlign   = mVertAlign_;
+        mKey.fTracking    = fTracking_;
+        mKey.fLineSpacing = fLineSpacing_;
+        mKey.fSpaceWidth  = fSpaceWidth_;
+        mKey.uiFlags      = (bRemoveStartingSpaces_ ? 1u : 0u) | (bWordWrap_ ? 2u : 0u) |
+                            (bAddEllipsis_ ? 4u : 0u) | (bFormattingEnabled_ ? 8u : 0u);
+
+        // Texts with the same parameters share the same layout
+        text_layout_cache& mCache = pManager_->get_text_layout_cache();
+        if (bLayoutSharingEnabled_)
+        {
+            mKey.sText = sUnicodeText_;
+            pLayout_ = mCache.find(mKey, pFont_->get_texture_revision());
+        }
+        else
+            pLayout_ = nullptr;
+
+        pEditableLayout_ = nullptr;
+
+        if (!pLayout_)
+        {
+            utils::refptr<layout> pLayout(new layout());
+
+            DEBUG_LOG("    Update lines");
+            update_lines_(*pLayout);
+            do
+            {
+                DEBUG_LOG("    Update cache");
+                pLayout->uiFontRevision = pFont_->get_texture_revision();
+                update_cache_(*pLayout);
+            }
+            while (pLayout->uiFontRevision != pFont_->get_texture_revision());
+            DEBUG_LOG("    .");
+
+            if (bLayoutSharingEnabled_)
+                mCache.insert(mKey, pFont_, pLayout);
+            else
+                pEditableLayout_ = pLayout;
+
+            pLayout_ = pLayout;
+        }
+
+        uiFontRevision_ = pLayout_->uiFontRevision;
         bUpdateCache_ = false;
+        bRebuildLayout_ = false;
         bUpdateQuads_ = true;
     }
 }
 
-void get_format(utils::ustring::iterator& iterChar, text::format& mFormat)
+void get_format(utils::ustring::const_iterator& iterChar, text::format& mFormat)
 {
     if (*iterChar == 'r')
     {
@@ -453,11 +614,77 @@ void get_format(utils::ustring::iterator& iterChar, text::format& mFormat)
     }
 }
 
-void text::update_lines_()
+void text::split_paragraphs_(uint& uiFirst, uint& uiOldLineCount, uint& uiNewCount)
+{
+    // Paragraphs that have not been edited since the last update keep
+    // their wrapped lines : only the edited ones are split again
+    uiFirst = 0; uiOldLineCount = 0; uiNewCount = 0;
+    uint uiLast = lParagraphList_.size();
+    uint uiStart = 0, uiEnd = sUnicodeText_.size();
+
+    if (!lParagraphList_.empty())
+    {
+        if (uiEditStart_ == uint(-1))
+            return;
+
+        // First paragraph that contains the start of the edit
+        uint uiOffset = 0;
+        while (uiOffset + lParagraphList_[uiFirst].uiLength < uiEditStart_)
+        {
+            uiOffset += lParagraphList_[uiFirst].uiLength + 1;
+            ++uiFirst;
+        }
+        uiStart = uiOffset;
+
+        // Last paragraph that contains the end of the edit
+        uint uiTail = 0;
+        while (uiTail + lParagraphList_[uiLast-1].uiLength < uiEditTail_)
+        {
+            uiTail += lParagraphList_[uiLast-1].uiLength + 1;
+            --uiLast;
+        }
+        uiEnd -= uiTail;
+    }
+
+    std::vector<paragraph> lNewParagraphList;
+    utils::ustring::const_iterator iterStart = sUnicodeText_.begin() + uiStart;
+    utils::ustring::const_iterator iterEnd   = sUnicodeText_.begin() + uiEnd;
+    while (true)
+    {
+        utils::ustring::const_iterator iterNext = std::find(iterStart, iterEnd, TO_U('\n'));
+
+        paragraph mParagraph;
+        mParagraph.uiLength = iterNext - iterStart;
+        lNewParagraphList.push_back(mParagraph);
+
+        if (iterNext == iterEnd)
+            break;
+
+        iterStart = iterNext + 1;
+    }
+
+    for (uint i = uiFirst; i < uiLast; ++i)
+        uiOldLineCount += lParagraphList_[i].lLineList.size();
+
+    uiNewCount = lNewParagraphList.size();
+
+    lParagraphList_.erase(lParagraphList_.begin() + uiFirst, lParagraphList_.begin() + uiLast);
+    lParagraphList_.insert(lParagraphList_.begin() + uiFirst,
+        lNewParagraphList.begin(), lNewParagraphList.end());
+
+    uiEditStart_ = uiEditTail_ = uint(-1);
+}
+
+void text::update_lines_(layout& mLayout)
 {
     // Update the line list, read format tags, do word wrapping, ...
-    lLineList_.clear();
+    mLayout.lLineList.clear();
     lFormatList_.clear();
+    bLayoutComplete_ = false;
+
+    DEBUG_LOG("     Split paragraphs");
+    uint uiFirst, uiOldLineCount, uiNewCount;
+    split_paragraphs_(uiFirst, uiOldLineCount, uiNewCount);
 
     DEBUG_LOG("     Get max line nbr");
     uint uiMaxLineNbr, uiCounter = 0;
@@ -479,427 +706,750 @@ void text::update_lines_()
 
     if (uiMaxLineNbr != 0)
     {
-        std::vector<utils::ustring> lManualLineList = utils::cut_each(sUnicodeText_, TO_U("\n"));
-        std::vector<utils::ustring>::iterator iterManual;
-        foreach (iterManual, lManualLineList)
+        uint uiOffset = 0;
+        std::vector<paragraph>::iterator iterParagraph;
+        foreach (iterParagraph, lParagraphList_)
         {
-            DEBUG_LOG("     Line : '" + utils::unicode_to_UTF8(*iterManual) + "'");
-            // Make a temporary line array
-            std::vector<line> lLines;
-            line mLine; mLine.fWidth = 0.0f;
-            std::map<uint, format> lTempFormatList;
-
-            DEBUG_LOG("     Read chars");
-            utils::ustring::iterator iterChar1;
-            foreach (iterChar1, *iterManual)
+            paragraph& mParagraph = *iterParagraph;
+
+            // Paragraphs are wrapped when they are first displayed
+            if (!mParagraph.bWrapped)
+                wrap_paragraph_(sUnicodeText_.substr(uiOffset, mParagraph.uiLength), mParagraph);
+
+            uiOffset += mParagraph.uiLength + 1;
+
+            // Format tags are stored relative to the start of the paragraph
+            std::map<uint, format>::const_iterator iterFormat;
+            foreach (iterFormat, mParagraph.lFormatList)
+                lFormatList_[uiCounter + iterFormat->first] = iterFormat->second;
+
+            uiCounter += mParagraph.uiLetterCount;
+
+            // Add the maximum number of line to this text
+            std::vector<line>::const_iterator iterLine;
+            foreach (iterLine, mParagraph.lLineList)
             {
-                DEBUG_LOG("      char '" + utils::to_string(*iterChar1) + "'");
-                DEBUG_LOG("      Read format");
-                // Read format tags
-                if (*iterChar1 == TO_U('|') && bFormattingEnabled_)
+                mLayout.lLineList.push_back(*iterLine);
+                if (mParagraph.bTruncated)
+                    return;
+
+                if (iterLine + 1 == mParagraph.lLineList.end() && iterParagraph + 1 != lParagraphList_.end())
+                    mLayout.lLineList.back().sCaption += TO_U("\n");
+
+                if (mLayout.lLineList.size() == uiMaxLineNbr)
+                    return;
+            }
+            DEBUG_LOG("     .");
+        }
+
+        bLayoutComplete_ = true;
+    }
+}
+
+void text::wrap_paragraph_(const utils::ustring& sText, paragraph& mParagraph) const
+{
+    DEBUG_LOG("     Line : '" + utils::unicode_to_UTF8(sText) + "'");
+    mParagraph.lLineList.clear();
+    mParagraph.lFormatList.clear();
+    mParagraph.uiLetterCount = 0;
+    mParagraph.bTruncated = false;
+    mParagraph.bWrapped = true;
+
+    uint uiCounter = 0;
+    line mLine; mLine.fWidth = 0.0f;
+    std::map<uint, format> lTempFormatList;
+
+    DEBUG_LOG("     Read chars");
+    utils::ustring::const_iterator iterChar1;
+    foreach (iterChar1, sText)
+    {
+        DEBUG_LOG("      char '" + utils::to_string(*iterChar1) + "'");
+        DEBUG_LOG("      Read format");
+        // Read format tags
+        if (*iterChar1 == TO_U('|') && bFormattingEnabled_)
+        {
+            ++iterChar1;
+            if (iterChar1 != sText.end())
+            {
+                if (*iterChar1 != TO_U('|'))
                 {
-                    ++iterChar1;
-                    if (iterChar1 != iterManual->end())
+                    get_format(iterChar1, lTempFormatList[uiCounter+mLine.sCaption.size()]);
+                    continue;
+                }
+            }
+            else
+                break;
+        }
+
+        DEBUG_LOG("      Get width");
+        if (*iterChar1 == TO_U(' '))
+            mLine.fWidth += fSpaceWidth_ + fTracking_;
+        else if (*iterChar1 == TO_U('\t'))
+            mLine.fWidth += 4*fSpaceWidth_ + fTracking_;
+        else
+        {
+            mLine.fWidth += get_character_width(*iterChar1) + fTracking_;
+            utils::ustring::const_iterator iterNext = iterChar1 + 1;
+            if (iterNext != sText.end())
+            {
+                if (*iterNext != TO_U(' '))
+                    mLine.fWidth += get_character_kerning(*iterChar1, *iterNext);
+            }
+        }
+
+        mLine.sCaption += *iterChar1;
+
+        if (mLine.fWidth > fBoxW_)
+        {
+            DEBUG_LOG("      Box break " + utils::to_string(mLine.fWidth) + " > " + utils::to_string(fBoxW_));
+            // Whoops, the line is too long...
+            if (mLine.sCaption.find(TO_U(" ")) != mLine.sCaption.npos && bWordWrap_)
+            {
+                DEBUG_LOG("       Spaced");
+                // There are several words on this line, we'll
+                // be able to put the last one on the next line
+                utils::ustring::iterator iterChar2 = mLine.sCaption.end();
+                utils::ustring sErasedString;
+                uint uiCharToErase = 0;
+                float fErasedWidth = 0.0f;
+                bool bLastWasWord = false;
+                while (mLine.fWidth > fBoxW_ && iterChar2 != mLine.sCaption.begin())
+                {
+                    --iterChar2;
+                    if (*iterChar2 == TO_U(' '))
                     {
-                        if (*iterChar1 != TO_U('|'))
+                        if (!bLastWasWord || bRemoveStartingSpaces_ || mLine.fWidth - fErasedWidth > fBoxW_)
                         {
-                            get_format(iterChar1, lTempFormatList[uiCounter+mLine.sCaption.size()]);
-                            continue;
+                            mLine.fWidth -= fErasedWidth + fSpaceWidth_ + fTracking_;
+                            sErasedString.insert(sErasedString.begin(), *iterChar2);
+                            fErasedWidth = 0.0f;
+                            ++uiCharToErase;
                         }
+                        else
+                            break;
                     }
                     else
-                        break;
+                    {
+                        fErasedWidth += get_character_width(*iterChar2) + fTracking_;
+                        sErasedString.insert(sErasedString.begin(), *iterChar2);
+                        ++uiCharToErase;
+                        bLastWasWord = true;
+                    }
                 }
 
-                DEBUG_LOG("      Get width");
-                if (*iterChar1 == TO_U(' '))
-                    mLine.fWidth += fSpaceWidth_ + fTracking_;
-                else if (*iterChar1 == TO_U('\t'))
-                    mLine.fWidth += 4*fSpaceWidth_ + fTracking_;
-                else
+                if (bRemoveStartingSpaces_)
                 {
-                    mLine.fWidth += get_character_width(*iterChar1) + fTracking_;
-                    utils::ustring::iterator iterNext = iterChar1 + 1;
-                    if (iterNext != iterManual->end())
+                    while (iterChar2 != mLine.sCaption.end() && *iterChar2 == TO_U(' '))
                     {
-                        if (*iterNext != TO_U(' '))
-                            mLine.fWidth += get_character_kerning(*iterChar1, *iterNext);
+                        --uiCharToErase;
+                        sErasedString.erase(0, 1);
+                        ++iterChar2;
                     }
                 }
 
-                mLine.sCaption += *iterChar1;
+                mLine.sCaption.erase(mLine.sCaption.size() - uiCharToErase, uiCharToErase);
+
+                mParagraph.lLineList.push_back(mLine);
+                std::map<uint, format>::iterator iterFormat;
+                foreach (iterFormat, lTempFormatList)
+                    mParagraph.lFormatList[iterFormat->first] = iterFormat->second;
 
-                if (mLine.fWidth > fBoxW_)
+                lTempFormatList.clear();
+                uiCounter += mLine.sCaption.size();
+                mLine.fWidth = get_string_width(sErasedString);
+                mLine.sCaption = sErasedString;
+            }
+            else
+            {
+                DEBUG_LOG("       Single word");
+                // There is only one word on this line, or word
+                // wrap is disabled. Anyway, this line is just
+                // too long for the text box : our only option
+                // is to truncate it.
+                if (bAddEllipsis_)
                 {
-                    DEBUG_LOG("      Box break " + utils::to_string(mLine.fWidth) + " > " + utils::to_string(fBoxW_));
-                    // Whoops, the line is too long...
-                    if (mLine.sCaption.find(TO_U(" ")) != mLine.sCaption.npos && bWordWrap_)
+                    DEBUG_LOG("       Ellipsis");
+                    float fWordWidth = 3.0f*(get_character_width(TO_U('.')) + fTracking_);
+                    utils::ustring::iterator iterChar2 = mLine.sCaption.end();
+                    uint uiCharToErase = 0;
+                    while ((mLine.fWidth + fWordWidth > fBoxW_) && (iterChar2 != mLine.sCaption.begin()))
                     {
-                        DEBUG_LOG("       Spaced");
-                        // There are several words on this line, we'll
-                        // be able to put the last one on the next line
-                        utils::ustring::iterator iterChar2 = mLine.sCaption.end();
-                        utils::ustring sErasedString;
-                        uint uiCharToErase = 0;
-                        float fErasedWidth = 0.0f;
-                        bool bLastWasWord = false;
-                        while (mLine.fWidth > fBoxW_ && iterChar2 != mLine.sCaption.begin())
-                        {
-                            --iterChar2;
-                            if (*iterChar2 == TO_U(' '))
-                            {
-                                if (!bLastWasWord || bRemoveStartingSpaces_ || mLine.fWidth - fErasedWidth > fBoxW_)
-                                {
-                                    mLine.fWidth -= fErasedWidth + fSpaceWidth_ + fTracking_;
-                                    sErasedString.insert(sErasedString.begin(), *iterChar2);
-                                    fErasedWidth = 0.0f;
-                                    ++uiCharToErase;
-                                }
-                                else
-                                    break;
-                            }
-                            else
-                            {
-                                fErasedWidth += get_character_width(*iterChar2) + fTracking_;
-                                sErasedString.insert(sErasedString.begin(), *iterChar2);
-                                ++uiCharToErase;
-                                bLastWasWord = true;
-                            }
-                        }
-
-                        if (bRemoveStartingSpaces_)
-                        {
-                            while (iterChar2 != mLine.sCaption.end() && *iterChar2 == TO_U(' '))
-                            {
-                                --uiCharToErase;
-                                sErasedString.erase(0, 1);
-                                ++iterChar2;
-                            }
-                        }
+                        --iterChar2;
+                        mLine.fWidth -= get_character_width(*iterChar2) + fTracking_;
+                        ++uiCharToErase;
+                    }
 
-                        mLine.sCaption.erase(mLine.sCaption.size() - uiCharToErase, uiCharToErase);
+                    DEBUG_LOG("       Char to erase : " + utils::to_string(uiCharToErase) + " / "
+                        + utils::to_string(mLine.sCaption.size()));
 
-                        lLines.push_back(mLine);
-                        std::map<uint, format>::iterator iterFormat;
-                        foreach (iterFormat, lTempFormatList)
-                            lFormatList_[iterFormat->first] = iterFormat->second;
-
-                        lTempFormatList.clear();
-                        uiCounter += mLine.sCaption.size();
-                        mLine.fWidth = get_string_width(sErasedString);
-                        mLine.sCaption = sErasedString;
-                    }
-                    else
+                    mLine.sCaption.erase(mLine.sCaption.size() - uiCharToErase, uiCharToErase);
+                    mLine.sCaption += TO_U("...");
+                }
+                else
+                {
+                    DEBUG_LOG("       Truncate");
+                    utils::ustring::iterator iterChar2 = mLine.sCaption.end();
+                    uint uiCharToErase = 0;
+                    while (mLine.fWidth  > fBoxW_ && iterChar2 != mLine.sCaption.begin())
                     {
-                        DEBUG_LOG("       Single word");
-                        // There is only one word on this line, or word
-                        // wrap is disabled. Anyway, this line is just
-                        // too long for the text box : our only option
-                        // is to truncate it.
-                        if (bAddEllipsis_)
-                        {
-                            DEBUG_LOG("       Ellipsis");
-                            float fWordWidth = 3.0f*(get_character_width(TO_U('.')) + fTracking_);
-                            utils::ustring::iterator iterChar2 = mLine.sCaption.end();
-                            uint uiCharToErase = 0;
-                            while ((mLine.fWidth + fWordWidth > fBoxW_) && (iterChar2 != mLine.sCaption.begin()))
-                            {
-                                --iterChar2;
-                                mLine.fWidth -= get_character_width(*iterChar2) + fTracking_;
-                                ++uiCharToErase;
-                            }
+                        --iterChar2;
+                        mLine.fWidth -= get_character_width(*iterChar2) + fTracking_;
+                        ++uiCharToErase;
+                    }
+                    mLine.sCaption.erase(mLine.sCaption.size() - uiCharToErase, uiCharToErase);
+                }
 
-                            DEBUG_LOG("       Char to erase : " + utils::to_string(uiCharToErase) + " / "
-                                + utils::to_string(mLine.sCaption.size()));
+                if (!bWordWrap_)
+                {
+                    DEBUG_LOG("       Display single line");
+                    // Word wrap is disabled, so we can only display one line
+                    // anyway.
+                    mParagraph.lLineList.push_back(mLine);
+                    std::map<uint, format>::iterator iterFormat;
+                    foreach (iterFormat, lTempFormatList)
+                        mParagraph.lFormatList[iterFormat->first] = iterFormat->second;
+
+                    mParagraph.uiLetterCount = uiCounter + mLine.sCaption.size();
+                    mParagraph.bTruncated = true;
+                    return;
+                }
 
-                            mLine.sCaption.erase(mLine.sCaption.size() - uiCharToErase, uiCharToErase);
-                            mLine.sCaption += TO_U("...");
-                        }
-                        else
+                DEBUG_LOG("       Continue");
+                utils::ustring::const_iterator iterTemp = iterChar1;
+                size_t pos = sText.find(TO_U(" "), iterChar1 - sText.begin());
+                if (pos == sText.npos)
+                    iterChar1 = sText.end();
+                else
+                    iterChar1 = sText.begin() + pos;
+
+                if (iterChar1 != sText.end())
+                {
+                    // Read cutted format tags
+                    if (bFormattingEnabled_)
+                    {
+                        while (iterTemp != iterChar1)
                         {
-                            DEBUG_LOG("       Truncate");
-                            utils::ustring::iterator iterChar2 = mLine.sCaption.end();
-                            uint uiCharToErase = 0;
-                            while (mLine.fWidth  > fBoxW_ && iterChar2 != mLine.sCaption.begin())
+                            if (*iterTemp == TO_U('|'))
                             {
-                                --iterChar2;
-                                mLine.fWidth -= get_character_width(*iterChar2) + fTracking_;
-                                ++uiCharToErase;
+                                ++iterTemp;
+                                if (iterTemp != iterChar1 && *iterTemp != TO_U('|'))
+                                    get_format(iterTemp, lTempFormatList[uiCounter+mLine.sCaption.size()]);
                             }
-                            mLine.sCaption.erase(mLine.sCaption.size() - uiCharToErase, uiCharToErase);
-                        }
-
-                        if (!bWordWrap_)
-                        {
-                            DEBUG_LOG("       Display single line");
-                            // Word wrap is disabled, so we can only display one line
-                            // anyway.
-                            lLineList_.push_back(mLine);
-                            std::map<uint, format>::iterator iterFormat;
-                            foreach (iterFormat, lTempFormatList)
-                                lFormatList_[iterFormat->first] = iterFormat->second;
-
-                            return;
+                            ++iterTemp;
                         }
+                    }
 
-                        DEBUG_LOG("       Continue");
-                        utils::ustring::iterator iterTemp = iterChar1;
-                        size_t pos = iterManual->find(TO_U(" "), iterChar1 - iterManual->begin());
-                        if (pos == iterManual->npos)
-                            iterChar1 = iterManual->end();
+                    // Look for the next word
+                    while (iterChar1 != sText.end())
+                    {
+                        if ((*iterChar1) == TO_U(' '))
+                            ++iterChar1;
                         else
-                            iterChar1 = iterManual->begin() + pos;
-
-                        if (iterChar1 != iterManual->end())
-                        {
-                            // Read cutted format tags
-                            if (bFormattingEnabled_)
-                            {
-                                while (iterTemp != iterChar1)
-                                {
-                                    if (*iterTemp == TO_U('|'))
-                                    {
-                                        ++iterTemp;
-                                        if (iterTemp != iterChar1 && *iterTemp != TO_U('|'))
-                                            get_format(iterTemp, lTempFormatList[uiCounter+mLine.sCaption.size()]);
-                                    }
-                                    ++iterTemp;
-                                }
-                            }
-
-                            // Look for the next word
-                            while (iterChar1 != iterManual->end())
-                            {
-                                if ((*iterChar1) == TO_U(' '))
-                                    ++iterChar1;
-                                else
-                                    break;
-                            }
+                            break;
+                    }
 
-                            // Add the line
-                            if (iterChar1 != iterManual->end())
-                            {
-                                --iterChar1;
-                                lLines.push_back(mLine);
-                                uiCounter += mLine.sCaption.size();
+                    // Add the line
+                    if (iterChar1 != sText.end())
+                    {
+                        --iterChar1;
+                        mParagraph.lLineList.push_back(mLine);
+                        uiCounter += mLine.sCaption.size();
 
-                                std::map<uint, format>::iterator iterFormat;
-                                foreach (iterFormat, lTempFormatList)
-                                    lFormatList_[iterFormat->first] = iterFormat->second;
+                        std::map<uint, format>::iterator iterFormat;
+                        foreach (iterFormat, lTempFormatList)
+                            mParagraph.lFormatList[iterFormat->first] = iterFormat->second;
 
-                                lTempFormatList.clear();
-                                mLine.fWidth = 0.0f;
-                                mLine.sCaption.clear();
-                            }
-                            else
-                                break;
-                        }
-                        else
-                            break;
+                        lTempFormatList.clear();
+                        mLine.fWidth = 0.0f;
+                        mLine.sCaption.clear();
                     }
+                    else
+                        break;
                 }
+                else
+                    break;
             }
+        }
+    }
 
-            DEBUG_LOG("     End");
-
-            if (iterManual != lManualLineList.end() - 1)
-                mLine.sCaption += TO_U("\n");
+    DEBUG_LOG("     End");
 
-            lLines.push_back(mLine);
-            std::map<uint, format>::iterator iterFormat;
-            foreach (iterFormat, lTempFormatList)
-                lFormatList_[iterFormat->first] = iterFormat->second;
+    mParagraph.lLineList.push_back(mLine);
+    std::map<uint, format>::iterator iterFormat;
+    foreach (iterFormat, lTempFormatList)
+        mParagraph.lFormatList[iterFormat->first] = iterFormat->second;
 
-            lTempFormatList.clear();
-            uiCounter += mLine.sCaption.size() - 1;
+    mParagraph.uiLetterCount = uiCounter + mLine.sCaption.size();
+}
 
-            // Add the maximum number of line to this text
-            std::vector<line>::iterator iterLine;
-            foreach (iterLine, lLines)
-            {
-                lLineList_.push_back(*iterLine);
-                if (lLineList_.size() == uiMaxLineNbr)
-                    return;
-            }
-            DEBUG_LOG("     .");
+float text::get_line_x_(const line& mLine) const
+{
+    float fX0 = 0.0f;
+    if (fBoxW_ != 0.0f && !math::isinf(fBoxW_))
+    {
+        switch (mAlign_)
+        {
+            case ALIGN_LEFT :
+                fX0 = 0.0f;
+                break;
+            case ALIGN_CENTER :
+                fX0 = floor(fBoxW_*0.5f);
+                break;
+            case ALIGN_RIGHT :
+                fX0 = fBoxW_;
+                break;
         }
     }
+
+    switch (mAlign_)
+    {
+        case ALIGN_CENTER :
+            return fX0 - floor(mLine.fWidth*0.5f);
+        case ALIGN_RIGHT :
+            return fX0 - mLine.fWidth;
+        default :
+            return fX0;
+    }
 }
 
-void text::update_cache_()
+void text::update_layout_size_(layout& mLayout) const
 {
-    lLetterCache_.clear();
+    if (mLayout.lLineList.empty())
+    {
+        mLayout.fW = 0.0f;
+        mLayout.fH = 0.0f;
+        return;
+    }
+
+    if (fBoxW_ == 0.0f || math::isinf(fBoxW_))
+    {
+        mLayout.fW = 0.0f;
+        std::vector<line>::const_iterator iterLine;
+        foreach (iterLine, mLayout.lLineList)
+            mLayout.fW = std::max(mLayout.fW, iterLine->fWidth);
+    }
+    else
+        mLayout.fW = fBoxW_;
 
-    if (!lLineList_.empty())
+    mLayout.fH = (1.0f + (mLayout.lLineList.size() - 1)*fLineSpacing_)*get_line_height();
+
+    float fY = 0.0f;
+    if (!math::isinf(fBoxH_))
     {
-        if (fBoxW_ == 0.0f || math::isinf(fBoxW_))
+        switch (mVertAlign_)
         {
-            fW_ = 0.0f;
-            std::vector<line>::iterator iterLine;
-            foreach (iterLine, lLineList_)
-                fW_ = std::max(fW_, iterLine->fWidth);
+            case ALIGN_TOP :
+                fY = 0.0f;
+                break;
+            case ALIGN_MIDDLE :
+                fY = floor((fBoxH_ - mLayout.fH)*0.5f);
+                break;
+            case ALIGN_BOTTOM :
+                fY = (fBoxH_ - mLayout.fH);
+                break;
         }
-        else
-            fW_ = fBoxW_;
+    }
+    else
+    {
+        switch (mVertAlign_)
+        {
+            case ALIGN_TOP :
+                fY = 0.0f;
+                break;
+            case ALIGN_MIDDLE :
+                fY = -floor(mLayout.fH*0.5f);
+                break;
+            case ALIGN_BOTTOM :
+                fY = -mLayout.fH;
+                break;
+        }
+    }
+
+    mLayout.fTop = fY;
+}
 
-        fH_ = (1.0f + (lLineList_.size() - 1)*fLineSpacing_)*get_line_height();
+void text::add_line_letters_(const line& mLine, float fY, uint& uiCounter, color& mColor,
+    std::vector<letter>& lLetterList)
+{
+    float fX = get_line_x_(mLine);
 
-        float fX = 0.0f, fY = 0.0f;
-        float fX0 = 0.0f;
+    letter mLetter;
 
-        if (fBoxW_ != 0.0f && !math::isinf(fBoxW_))
+    utils::ustring::const_iterator iterChar, iterNext;
+    foreach (iterChar, mLine.sCaption)
+    {
+        // format our text
+        if (bFormattingEnabled_ && lFormatList_.find(uiCounter) != lFormatList_.end())
         {
-            switch (mAlign_)
+            const format& mFormat = lFormatList_[uiCounter];
+            switch (mFormat.mColorAction)
             {
-                case ALIGN_LEFT :
-                    fX0 = 0.0f;
-                    break;
-                case ALIGN_CENTER :
-                    fX0 = floor(fBoxW_*0.5f);
+                case COLOR_ACTION_SET :
+                    mColor = mFormat.mColor;
                     break;
-                case ALIGN_RIGHT :
-                    fX0 = fBoxW_;
+                case COLOR_ACTION_RESET :
+                    mColor = color::EMPTY;
                     break;
+                default : break;
             }
         }
-        else
-            fX0 = 0.0f;
 
-        if (!math::isinf(fBoxH_))
+        float fCharWidth, fCharHeight;
+
+        // Add the character to the cache
+        if (*iterChar == '\n')
         {
-            switch (mVertAlign_)
-            {
-                case ALIGN_TOP :
-                    fY = 0.0f;
-                    break;
-                case ALIGN_MIDDLE :
-                    fY = floor((fBoxH_ - fH_)*0.5f);
-                    break;
-                case ALIGN_BOTTOM :
-                    fY = (fBoxH_ - fH_);
-                    break;
-            }
+            fCharHeight = pFont_->get_character_height(TO_U('_'));
+            float fYOffset = floor(fSize_/2.0f + fSize_/8.0f - fCharHeight/2.0f);
+
+            mLetter.mQuad = quad2f(0.0f, 0.0f, fYOffset, fYOffset+fCharHeight) + vector2f(fX, fY);
+            mLetter.bNoRender = true;
+
+            lLetterList.push_back(mLetter);
+
+            continue; // Don't increase the uiCounter
+        }
+        else if (*iterChar == TO_U(' ') || *iterChar == TO_U('\t'))
+        {
+            fCharWidth = fSpaceWidth_;
+            if (*iterChar == TO_U('\t'))
+                fCharWidth *= 4;
+            fCharHeight = pFont_->get_character_height(TO_U('!'));
+            float fYOffset = floor(fSize_/2.0f + fSize_/8.0f - fCharHeight/2.0f);
+
+            mLetter.mQuad = quad2f(0.0f, fCharWidth, fYOffset, fYOffset+fCharHeight) + vector2f(fX, fY);
+            mLetter.bNoRender = true;
+
+            lLetterList.push_back(mLetter);
         }
         else
         {
-            switch (mVertAlign_)
-            {
-                case ALIGN_TOP :
-                    fY = 0.0f;
-                    break;
-                case ALIGN_MIDDLE :
-                    fY = -floor(fH_*0.5f);
-                    break;
-                case ALIGN_BOTTOM :
-                    fY = -fH_;
-                    break;
-            }
+            quad2f lUVs = pFont_->get_character_uvs(*iterChar);
+            fCharWidth = get_character_width(*iterChar);
+            fCharHeight = pFont_->get_character_height(*iterChar);
+            float fYOffset = floor(fSize_/2.0f + fSize_/8.0f - fCharHeight/2.0f);
+
+            mLetter.mQuad = quad2f(0.0f, fCharWidth, fYOffset, fYOffset+fCharHeight) + vector2f(fX, fY);
+            mLetter.mUVs = lUVs;
+            mLetter.mColor = mColor;
+            mLetter.bNoRender = false;
+
+            lLetterList.push_back(mLetter);
         }
 
-        uint uiCounter = 0;
+        iterNext = iterChar + 1;
 
-        letter mLetter;
+        float fKerning = 0.0f;
+        if (iterNext != mLine.sCaption.end() && *iterNext != TO_U(' ') && *iterChar != TO_U(' '))
+            fKerning = get_character_kerning(*iterChar, *iterNext);
 
-        color mColor = color::EMPTY;
+        fX += fCharWidth + fKerning + fTracking_;
+        ++uiCounter;
+    }
+}
 
-        std::vector<line>::iterator iterLine;
-        foreach (iterLine, lLineList_)
-        {
-            switch (mAlign_)
-            {
-                case ALIGN_LEFT :
-                    fX = fX0;
-                    break;
-                case ALIGN_CENTER :
-                    fX = fX0 - floor(iterLine->fWidth*0.5f);
-                    break;
-                case ALIGN_RIGHT :
-                    fX = fX0 - iterLine->fWidth;
-                    break;
-            }
+void text::update_cache_(layout& mLayout)
+{
+    mLayout.lLetterCache.clear();
+    mLayout.lLineStartList.clear();
 
-            utils::ustring::iterator iterChar, iterNext;
-            foreach (iterChar, iterLine->sCaption)
-            {
-                // format our text
-                if (bFormattingEnabled_ && lFormatList_.find(uiCounter) != lFormatList_.end())
-                {
-                    const format& mFormat = lFormatList_[uiCounter];
-                    switch (mFormat.mColorAction)
-                    {
-                        case COLOR_ACTION_SET :
-                            mColor = mFormat.mColor;
-                            break;
-                        case COLOR_ACTION_RESET :
-                            mColor = color::EMPTY;
-                            break;
-                        default : break;
-                    }
-                }
+    update_layout_size_(mLayout);
 
-                float fCharWidth, fCharHeight;
+    uint uiCounter = 0;
+    color mColor = color::EMPTY;
+    float fLineStep = get_line_height()*fLineSpacing_;
 
-                // Add the character to the cache
-                if (*iterChar == '\n')
-                {
-                    quad2f lUVs = pFont_->get_character_uvs(TO_U('_'));
-                    fCharHeight = lUVs.height()*pFont_->get_texture()->get_height();
-                    float fYOffset = floor(fSize_/2.0f + fSize_/8.0f - fCharHeight/2.0f);
+    for (uint i = 0; i < mLayout.lLineList.size(); ++i)
+    {
+        mLayout.lLineStartList.push_back(mLayout.lLetterCache.size());
+        add_line_letters_(mLayout.lLineList[i], mLayout.fTop + i*fLineStep,
+            uiCounter, mColor, mLayout.lLetterCache);
+    }
+}
 
-                    mLetter.mQuad = quad2f(0.0f, 0.0f, fYOffset, fYOffset+fCharHeight) + vector2f(fX, fY);
-                    mLetter.bNoRender = true;
+static void move_letters(std::vector<text::letter>::iterator iterBegin,
+    std::vector<text::letter>::iterator iterEnd, float fYOffset)
+{
+    if (fYOffset == 0.0f)
+        return;
 
-                    lLetterCache_.push_back(mLetter);
+    for (; iterBegin != iterEnd; ++iterBegin)
+        iterBegin->mQuad = iterBegin->mQuad + vector2f(0.0f, fYOffset);
+}
 
-                    continue; // Don't increase the uiCounter
-                }
-                else if (*iterChar == TO_U(' ') || *iterChar == TO_U('\t'))
-                {
-                    quad2f lUVs = pFont_->get_character_uvs(TO_U('!'));
-                    fCharWidth = fSpaceWidth_;
-                    if (*iterChar == TO_U('\t'))
-                        fCharWidth *= 4;
-                    fCharHeight = lUVs.height()*pFont_->get_texture()->get_height();
-                    float fYOffset = floor(fSize_/2.0f + fSize_/8.0f - fCharHeight/2.0f);
+static void move_quads(std::vector<std::array<vertex,4>>::iterator iterBegin,
+    std::vector<std::array<vertex,4>>::iterator iterEnd, float fYOffset)
+{
+    if (fYOffset == 0.0f)
+        return;
 
-                    mLetter.mQuad = quad2f(0.0f, fCharWidth, fYOffset, fYOffset+fCharHeight) + vector2f(fX, fY);
-                    mLetter.bNoRender = true;
+    for (; iterBegin != iterEnd; ++iterBegin)
+    {
+        for (uint i = 0; i < 4; ++i)
+            (*iterBegin)[i].pos.y += fYOffset;
+    }
+}
 
-                    lLetterCache_.push_back(mLetter);
-                }
-                else
-                {
-                    quad2f lUVs = pFont_->get_character_uvs(*iterChar);
-                    fCharWidth = get_character_width(*iterChar);
-                    fCharHeight = lUVs.height()*pFont_->get_texture()->get_height();
-                    float fYOffset = floor(fSize_/2.0f + fSize_/8.0f - fCharHeight/2.0f);
+bool text::update_edited_lines_()
+{
+    // Colors and truncated lines depend on the whole text :
+    // these texts are always updated from scratch
+    if (!pEditableLayout_ || !bLayoutComplete_ || bFormattingEnabled_ ||
+        (fBoxH_ != 0.0f && !math::isinf(fBoxH_)))
+        return false;
+
+    layout& mLayout = *pEditableLayout_;
+    if (mLayout.uiFontRevision != pFont_->get_texture_revision())
+        return false;
+
+    uint uiFirst, uiOldLineCount, uiNewCount;
+    split_paragraphs_(uiFirst, uiOldLineCount, uiNewCount);
+    if (uiNewCount == 0)
+        return true;
+
+    // Wrap the edited paragraphs
+    uint uiFirstLine = 0, uiOffset = 0;
+    for (uint i = 0; i < uiFirst; ++i)
+    {
+        uiFirstLine += lParagraphList_[i].lLineList.size();
+        uiOffset += lParagraphList_[i].uiLength + 1;
+    }
 
-                    mLetter.mQuad = quad2f(0.0f, fCharWidth, fYOffset, fYOffset+fCharHeight) + vector2f(fX, fY);
-                    mLetter.mUVs = lUVs;
-                    mLetter.mColor = mColor;
-                    mLetter.bNoRender = false;
+    std::vector<line> lNewLineList;
+    for (uint i = uiFirst; i < uiFirst + uiNewCount; ++i)
+    {
+        paragraph& mParagraph = lParagraphList_[i];
+        wrap_paragraph_(sUnicodeText_.substr(uiOffset, mParagraph.uiLength), mParagraph);
+        uiOffset += mParagraph.uiLength + 1;
 
-                    lLetterCache_.push_back(mLetter);
-                }
+        if (mParagraph.bTruncated)
+            return false;
 
-                iterNext = iterChar + 1;
+        lNewLineList.insert(lNewLineList.end(), mParagraph.lLineList.begin(), mParagraph.lLineList.end());
+        if (i + 1 != lParagraphList_.size())
+            lNewLineList.back().sCaption += TO_U("\n");
+    }
 
-                float fKerning = 0.0f;
-                if (iterNext != iterLine->sCaption.end() && *iterNext != TO_U(' ') && *iterChar != TO_U(' '))
-                    fKerning = get_character_kerning(*iterChar, *iterNext);
+    uint uiEndLine = uiFirstLine + uiOldLineCount;
+    uint uiNewLineCount = lNewLineList.size();
 
-                fX += fCharWidth + fKerning + fTracking_;
-                ++uiCounter;
-            }
+    std::vector<line>& lLineList = mLayout.lLineList;
+    lLineList.erase(lLineList.begin() + uiFirstLine, lLineList.begin() + uiEndLine);
+    lLineList.insert(lLineList.begin() + uiFirstLine, lNewLineList.begin(), lNewLineList.end());
+
+    // The lines before and after the edited ones are only moved vertically
+    float fOldTop = mLayout.fTop;
+    update_layout_size_(mLayout);
+
+    float fLineStep = get_line_height()*fLineSpacing_;
+    float fTopOffset = mLayout.fTop - fOldTop;
+    float fBottomOffset = fTopOffset + (float(uiNewLineCount) - float(uiOldLineCount))*fLineStep;
+
+    std::vector<letter>& lLetterList = mLayout.lLetterCache;
+    std::vector<uint>& lLineStartList = mLayout.lLineStartList;
+
+    uint uiFirstLetter = uiFirstLine < lLineStartList.size() ? lLineStartList[uiFirstLine] : lLetterList.size();
+    uint uiEndLetter = uiEndLine < lLineStartList.size() ? lLineStartList[uiEndLine] : lLetterList.size();
+
+    std::vector<letter> lNewLetterList;
+    std::vector<uint>   lNewLineStartList;
+    uint uiCounter = 0;
+    color mColor = color::EMPTY;
+    for (uint i = 0; i < uiNewLineCount; ++i)
+    {
+        lNewLineStartList.push_back(uiFirstLetter + lNewLetterList.size());
+        add_line_letters_(lNewLineList[i], mLayout.fTop + (uiFirstLine + i)*fLineStep,
+            uiCounter, mColor, lNewLetterList);
+    }
 
-            fY += get_line_height()*fLineSpacing_;
+    // New characters may have moved the others on the font texture
+    if (mLayout.uiFontRevision != pFont_->get_texture_revision())
+        return false;
+
+    int iLetterOffset = int(lNewLetterList.size()) - int(uiEndLetter - uiFirstLetter);
+    uint uiNewEndLetter = uiFirstLetter + lNewLetterList.size();
+
+    lLetterList.erase(lLetterList.begin() + uiFirstLetter, lLetterList.begin() + uiEndLetter);
+    lLetterList.insert(lLetterList.begin() + uiFirstLetter, lNewLetterList.begin(), lNewLetterList.end());
+    move_letters(lLetterList.begin(), lLetterList.begin() + uiFirstLetter, fTopOffset);
+    move_letters(lLetterList.begin() + uiNewEndLetter, lLetterList.end(), fBottomOffset);
+
+    lLineStartList.erase(lLineStartList.begin() + uiFirstLine, lLineStartList.begin() + uiEndLine);
+    lLineStartList.insert(lLineStartList.begin() + uiFirstLine, lNewLineStartList.begin(), lNewLineStartList.end());
+    for (uint i = uiFirstLine + uiNewLineCount; i < lLineStartList.size(); ++i)
+        lLineStartList[i] += iLetterOffset;
+
+    // Same thing for the quads, if they are up to date
+    if (!bUpdateQuads_)
+    {
+        uint uiFirstQuad = uiFirstLine < lLineQuadStartList_.size() ? lLineQuadStartList_[uiFirstLine] : lQuadList_.size();
+        uint uiEndQuad = uiEndLine < lLineQuadStartList_.size() ? lLineQuadStartList_[uiEndLine] : lQuadList_.size();
+
+        std::vector<std::array<vertex,4>> lNewQuadList;
+        std::vector<uint>                 lNewLineQuadStartList;
+        for (uint i = 0; i < uiNewLineCount; ++i)
+        {
+            uint uiLineEnd = i + 1 < uiNewLineCount ? lNewLineStartList[i+1] : uiNewEndLetter;
+            lNewLineQuadStartList.push_back(uiFirstQuad + lNewQuadList.size());
+            add_letter_quads_(lLetterList.begin() + lNewLineStartList[i],
+                lLetterList.begin() + uiLineEnd, lNewQuadList);
         }
+
+        int iQuadOffset = int(lNewQuadList.size()) - int(uiEndQuad - uiFirstQuad);
+        uint uiNewEndQuad = uiFirstQuad + lNewQuadList.size();
+
+        lQuadList_.erase(lQuadList_.begin() + uiFirstQuad, lQuadList_.begin() + uiEndQuad);
+        lQuadList_.insert(lQuadList_.begin() + uiFirstQuad, lNewQuadList.begin(), lNewQuadList.end());
+        move_quads(lQuadList_.begin(), lQuadList_.begin() + uiFirstQuad, fTopOffset);
+        move_quads(lQuadList_.begin() + uiNewEndQuad, lQuadList_.end(), fBottomOffset);
+
+        lLineQuadStartList_.erase(lLineQuadStartList_.begin() + uiFirstLine,
+            lLineQuadStartList_.begin() + uiEndLine);
+        lLineQuadStartList_.insert(lLineQuadStartList_.begin() + uiFirstLine,
+            lNewLineQuadStartList.begin(), lNewLineQuadStartList.end());
+        for (uint i = uiFirstLine + uiNewLineCount; i < lLineQuadStartList_.size(); ++i)
+            lLineQuadStartList_[i] += iQuadOffset;
+
+        bUpdateOutlineQuads_ = true;
+        bUpdateCopyQuads_ = true;
     }
-    else
+
+    return true;
+}
+
+void text::add_letter_quads_(std::vector<letter>::const_iterator iterBegin,
+    std::vector<letter>::const_iterator iterEnd, std::vector<std::array<vertex,4>>& lQuadList) const
+{
+    std::array<vertex,4> lVertexList;
+
+    if (!bFormattingEnabled_)
     {
-        fW_ = 0.0f;
-        fH_ = 0.0f;
+        for (uint i = 0; i < 4; ++i)
+            lVertexList[i].col = mColor_;
     }
+
+    std::vector<letter>::const_iterator iterLetter;
+    for (iterLetter = iterBegin; iterLetter != iterEnd; ++iterLetter)
+    {
+        if (iterLetter->bNoRender)
+            continue;
+
+        const quad2f& mQuad = iterLetter->mQuad;
+
+        lVertexList[0].pos = mQuad.top_left();
+        lVertexList[1].pos = mQuad.top_right();
+        lVertexList[2].pos = mQuad.bottom_right();
+        lVertexList[3].pos = mQuad.bottom_left();
+
+        lVertexList[0].uvs = iterLetter->mUVs.top_left();
+        lVertexList[1].uvs = iterLetter->mUVs.top_right();
+        lVertexList[2].uvs = iterLetter->mUVs.bottom_right();
+        lVertexList[3].uvs = iterLetter->mUVs.bottom_left();
+
+        if (bFormattingEnabled_)
+        {
+            if (iterLetter->mColor != color::EMPTY && !bForceColor_)
+            {
+                for (uint i = 0; i < 4; ++i)
+                    lVertexList[i].col = iterLetter->mColor;
+            }
+            else
+            {
+                for (uint i = 0; i < 4; ++i)
+                    lVertexList[i].col = mColor_;
+            }
+        }
+
+        lQuadList.push_back(lVertexList);
+    }
+}
+
+void text::update_quads_()
+{
+    // Quads are built relative to the position of the text, which is
+    // only given when rendering : moving the text does not update them
+    lQuadList_.clear();
+    lLineQuadStartList_.clear();
+
+    const std::vector<letter>& lLetterList = pLayout_->lLetterCache;
+    const std::vector<uint>& lLineStartList = pLayout_->lLineStartList;
+    for (uint i = 0; i < lLineStartList.size(); ++i)
+    {
+        uint uiLineEnd = i + 1 < lLineStartList.size() ? lLineStartList[i+1] : lLetterList.size();
+        lLineQuadStartList_.push_back(lQuadList_.size());
+        add_letter_quads_(lLetterList.begin() + lLineStartList[i],
+            lLetterList.begin() + uiLineEnd, lQuadList_);
+    }
+
+    bUpdateQuads_ = false;
+    bUpdateOutlineQuads_ = true;
+    bUpdateCopyQuads_ = true;
+}
+
+void text::update_outline_quads_(float fThickness)
+{
+    fOutlineThickness_ = fThickness;
+    lOutlineQuadList_.clear();
+
+    // Each quad is extended so that it covers the outline, and
+    // its uv coordinates are extended in the same proportions
+    std::vector<std::array<vertex,4>>::const_iterator iterQuad;
+    foreach (iterQuad, lQuadList_)
+    {
+        const std::array<vertex,4>& lQuad = *iterQuad;
+
+        float fWidth = lQuad[1].pos.x - lQuad[0].pos.x;
+        float fHeight = lQuad[3].pos.y - lQuad[0].pos.y;
+        if (fWidth <= 0.0f || fHeight <= 0.0f)
+            continue;
+
+        vector2f mPos(fThickness, fThickness);
+        vector2f mUVs(
+            fThickness*(lQuad[1].uvs.x - lQuad[0].uvs.x)/fWidth,
+            fThickness*(lQuad[3].uvs.y - lQuad[0].uvs.y)/fHeight
+        );
+
+        std::array<vertex,4> lOutlineQuad = lQuad;
+        lOutlineQuad[0].pos += vector2f(-mPos.x, -mPos.y);
+        lOutlineQuad[1].pos += vector2f( mPos.x, -mPos.y);
+        lOutlineQuad[2].pos += vector2f( mPos.x,  mPos.y);
+        lOutlineQuad[3].pos += vector2f(-mPos.x,  mPos.y);
+        lOutlineQuad[0].uvs += vector2f(-mUVs.x, -mUVs.y);
+        lOutlineQuad[1].uvs += vector2f( mUVs.x, -mUVs.y);
+        lOutlineQuad[2].uvs += vector2f( mUVs.x,  mUVs.y);
+        lOutlineQuad[3].uvs += vector2f(-mUVs.x,  mUVs.y);
+
+        lOutlineQuadList_.push_back(lOutlineQuad);
+    }
+
+    bUpdateOutlineQuads_ = false;
+}
+
+void text::update_copy_quads_(const std::vector<copy>& lCopyList)
+{
+    lCopyList_ = lCopyList;
+    lCopyQuadList_.clear();
+    lCopyQuadList_.reserve(lCopyList_.size()*lQuadList_.size());
+
+    std::vector<copy>::const_iterator iterCopy;
+    foreach (iterCopy, lCopyList_)
+    {
+        std::vector<std::array<vertex,4>>::const_iterator iterQuad;
+        foreach (iterQuad, lQuadList_)
+        {
+            std::array<vertex,4> lQuad = *iterQuad;
+            for (uint i = 0; i < 4; ++i)
+            {
+                lQuad[i].pos += iterCopy->mOffset;
+                if (!iterCopy->bUseTextColor)
+                    lQuad[i].col = iterCopy->mColor;
+            }
+
+            lCopyQuadList_.push_back(lQuad);
+        }
+    }
+
+    bUpdateCopyQuads_ = false;
 }
 
 utils::refptr<sprite> text::create_sprite(char32_t uiChar) const
@@ -907,7 +1457,7 @@ utils::refptr<sprite> text::create_sprite(char32_t uiChar) const
     quad2f lUVs = pFont_->get_character_uvs(uiChar);
 
     float fWidth = get_character_width(uiChar);
-    float fHeight = lUVs.height()*pFont_->get_texture()->get_height();
+    float fHeight = pFont_->get_character_height(uiChar);
 
     utils::refptr<sprite> pSprite = pManager_->create_sprite(pFont_->get_texture().lock(), fWidth, fHeight);
     pSprite->set_texture_rect(lUVs.left, lUVs.top, lUVs.right, lUVs.bottom, true);
@@ -920,6 +1470,56 @@ utils::refptr<sprite> text::create_sprite(char32_t uiChar) const
 const std::vector<text::letter>& text::get_letter_cache()
 {
     update();
-    return lLetterCache_;
+    return pLayout_->lLetterCache;
+}
+
+uint text::get_letter_line(uint uiIndex)
+{
+    update();
+
+    const std::vector<uint>& lLineStartList = pLayout_->lLineStartList;
+    if (lLineStartList.empty())
+        return 0;
+
+    std::vector<uint>::const_iterator iterLine =
+        std::upper_bound(lLineStartList.begin(), lLineStartList.end(), uiIndex);
+
+    return (iterLine - lLineStartList.begin()) - 1;
+}
+
+static bool is_letter_before(float fX, const text::letter& mLetter)
+{
+    return fX < mLetter.mQuad.center().x;
+}
+
+uint text::get_letter_id_at(float fX, float fY)
+{
+    update();
+
+    const std::vector<letter>& lLetterList = pLayout_->lLetterCache;
+    const std::vector<uint>& lLineStartList = pLayout_->lLineStartList;
+    if (lLineStartList.empty())
+        return 0;
+
+    float fLineHeight = get_line_height()*fLineSpacing_;
+    uint uiLine = 0;
+    if (fY > pLayout_->fTop && fLineHeight > 0.0f)
+        uiLine = std::min<uint>(floor((fY - pLayout_->fTop)/fLineHeight), lLineStartList.size() - 1);
+
+    std::vector<letter>::const_iterator iterBegin = lLetterList.begin() + lLineStartList[uiLine];
+    std::vector<letter>::const_iterator iterEnd = lLetterList.end();
+    if (uiLine + 1 < lLineStartList.size())
+        iterEnd = lLetterList.begin() + lLineStartList[uiLine + 1];
+
+    std::vector<letter>::const_iterator iterLetter =
+        std::upper_bound(iterBegin, iterEnd, fX, &is_letter_before);
+
+    // Stay on this line rather than after its end of line character
+    const utils::ustring& sCaption = pLayout_->lLineList[uiLine].sCaption;
+    if (iterLetter == iterEnd && iterLetter != iterBegin &&
+        !sCaption.empty() && sCaption[sCaption.size()-1] == TO_U('\n'))
+        --iterLetter;
+
+    return iterLetter - lLetterList.begin();
 }
 }
@@ -0,0 +1,140 @@
+#include "lxgui/gui_textlayoutcache.hpp"
+#include "lxgui/gui_font.hpp"
+
+#include <tuple>
+
+namespace gui
+{
+bool text_layout_cache::key::operator < (const key& mKey) const
+{
+    return std::tie(pFont, fSize, fBoxW, fBoxH, iAlign, iVertAlign, fTracking,
+        fLineSpacing, fSpaceWidth, uiFlags, sText) <
+        std::tie(mKey.pFont, mKey.fSize, mKey.fBoxW, mKey.fBoxH, mKey.iAlign, mKey.iVertAlign,
+        mKey.fTracking, mKey.fLineSpacing, mKey.fSpaceWidth, mKey.uiFlags, mKey.sText);
+}
+
+text_layout_cache::text_layout_cache(uint uiMaxSize, uint uiMaxLetterCount, uint uiMaxTextLength) :
+    uiMaxSize_(uiMaxSize), uiMaxLetterCount_(uiMaxLetterCount), uiMaxTextLength_(uiMaxTextLength),
+    uiLetterCount_(0u)
+{
+}
+
+text_layout_cache::~text_layout_cache()
+{
+}
+
+void text_layout_cache::set_max_size(uint uiMaxSize)
+{
+    uiMaxSize_ = uiMaxSize;
+    while (lEntryList_.size() > uiMaxSize_)
+        remove_oldest_();
+}
+
+uint text_layout_cache::get_max_size() const
+{
+    return uiMaxSize_;
+}
+
+uint text_layout_cache::get_size() const
+{
+    return lEntryList_.size();
+}
+
+void text_layout_cache::set_max_letter_count(uint uiMaxLetterCount)
+{
+    uiMaxLetterCount_ = uiMaxLetterCount;
+    while (uiLetterCount_ > uiMaxLetterCount_)
+        remove_oldest_();
+}
+
+uint text_layout_cache::get_max_letter_count() const
+{
+    return uiMaxLetterCount_;
+}
+
+uint text_layout_cache::get_letter_count() const
+{
+    return uiLetterCount_;
+}
+
+void text_layout_cache::set_max_text_length(uint uiMaxTextLength)
+{
+    uiMaxTextLength_ = uiMaxTextLength;
+}
+
+uint text_layout_cache::get_max_text_length() const
+{
+    return uiMaxTextLength_;
+}
+
+utils::refptr<const text::layout> text_layout_cache::find(const key& mKey, uint uiFontRevision)
+{
+    std::map<key, entry>::iterator iter = lEntryList_.find(mKey);
+    if (iter == lEntryList_.end())
+        return nullptr;
+
+    entry& mEntry = iter->second;
+    if (!mEntry.pFont.is_valid() || mEntry.pLayout->uiFontRevision != uiFontRevision)
+    {
+        // The font has been destroyed (another one may use the same
+        // address), or its texture has changed
+        remove_(iter);
+        return nullptr;
+    }
+
+    // Move it to the front of the list
+    lLRUList_.splice(lLRUList_.begin(), lLRUList_, mEntry.iterLRU);
+
+    return mEntry.pLayout;
+}
+
+void text_layout_cache::insert(const key& mKey, utils::wptr<font> pFont, utils::refptr<const text::layout> pLayout)
+{
+    uint uiLetterCount = mKey.sText.size();
+    if (uiMaxSize_ == 0u || uiLetterCount > uiMaxTextLength_ || uiLetterCount > uiMaxLetterCount_)
+        return;
+
+    std::map<key, entry>::iterator iter = lEntryList_.find(mKey);
+    if (iter != lEntryList_.end())
+    {
+        iter->second.pFont = pFont;
+        iter->second.pLayout = pLayout;
+        lLRUList_.splice(lLRUList_.begin(), lLRUList_, iter->second.iterLRU);
+        return;
+    }
+
+    while (lEntryList_.size() >= uiMaxSize_ || uiLetterCount_ + uiLetterCount > uiMaxLetterCount_)
+        remove_oldest_();
+
+    iter = lEntryList_.insert(std::make_pair(mKey, entry())).first;
+    iter->second.pFont = pFont;
+    iter->second.pLayout = pLayout;
+
+    lLRUList_.push_front(&iter->first);
+    iter->second.iterLRU = lLRUList_.begin();
+
+    uiLetterCount_ += uiLetterCount;
+}
+
+void text_layout_cache::clear()
+{
+    lEntryList_.clear();
+    lLRUList_.clear();
+    uiLetterCount_ = 0u;
+}
+
+void text_layout_cache::remove_(std::map<key, entry>::iterator iter)
+{
+    uiLetterCount_ -= iter->first.sText.size();
+    lLRUList_.erase(iter->second.iterLRU);
+    lEntryList_.erase(iter);
+}
+
+void text_layout_cache::remove_oldest_()
+{
+    if (lLRUList_.empty())
+        return;
+
+    remove_(lEntryList_.find(*lLRUList_.back()));
+}
+}
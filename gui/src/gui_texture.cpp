@@ -101,6 +101,21 @@ void texture::render()
     }
 }
 
+void texture::update(float fDelta)
+{
+    if (pPendingMaterial_ && pPendingMaterial_.lock()->is_ready())
+    {
+        pPendingMaterial_ = nullptr;
+        notify_renderer_need_redraw();
+    }
+
+    layered_region::update(fDelta);
+
+    // Keep checking until the texture is loaded
+    if (pPendingMaterial_)
+        fire_update();
+}
+
 void texture::create_glue()
 {
     utils::wptr<lua::state> pLua = pManager_->get_lua();
@@ -235,10 +250,7 @@ void texture::set_filter_mode(filter mFilter)
         mFilter_ = mFilter;
 
         if (!sTextureFile_.empty() && pSprite_)
-        {
-            pSprite_ = pManager_->create_sprite(pManager_->create_material(sTextureFile_, mFilter_));
-            pSprite_->set_texture_coords(lTexCoord_, true);
-        }
+            load_texture_file_();
 
         notify_renderer_need_redraw();
     }
@@ -361,10 +373,7 @@ void texture::set_texture(const std::string& sFile)
         return;
 
     if (utils::file_exists(sTextureFile_))
-    {
-        pSprite_ = pManager_->create_sprite(pManager_->create_material(sTextureFile_, mFilter_));
-        pSprite_->set_texture_coords(lTexCoord_, true);
-    }
+        load_texture_file_();
     else
     {
         gui::out << gui::error << "gui::" << lType_.back() << " : "
@@ -437,4 +446,17 @@ void texture::set_vertex_color(const color& mColor)
             << "Trying to set vertex color of an uninitialized texture : " << sName_ << "." << std::endl;
     }
 }
+
+void texture::load_texture_file_()
+{
+    utils::refptr<material> pMat = pManager_->create_material(sTextureFile_, mFilter_);
+    if (pMat && !pMat->is_ready())
+    {
+        pPendingMaterial_ = pMat;
+        fire_update();
+    }
+
+    pSprite_ = pManager_->create_sprite(pMat);
+    pSprite_->set_texture_coords(lTexCoord_, true);
+}
 }
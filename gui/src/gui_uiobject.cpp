@@ -22,7 +22,7 @@ uiobject::uiobject(manager* pManager) :
     lBorderList_(quad2i::ZERO), fAlpha_(1.0f), bIsShown_(true), bIsVisible_(true),
     bIsWidthAbs_(true), bIsHeightAbs_(true), uiAbsWidth_(0u), uiAbsHeight_(0u),
     fRelWidth_ (0.0f), fRelHeight_(0.0f), bUpdateAnchors_(false),
-    bUpdateBorders_(true), bUpdateDimensions_(false)
+    bUpdateBorders_(true), bUpdateDimensions_(false), bUpdateNeeded_(true)
 {
     lType_.push_back(CLASS_NAME);
 }
@@ -449,7 +449,7 @@ void uiobject::clear_all_points()
 
         lDefinedBorderList_ = quad2<bool>(false, false, false, false);
 
-        bUpdateAnchors_ = true;
+        fire_update_anchors_();
         fire_update_borders();
         notify_renderer_need_redraw();
         pManager_->notify_object_moved();
@@ -469,7 +469,7 @@ void uiobject::set_all_points(const std::string& sObjName)
 
         lDefinedBorderList_ = quad2<bool>(true, true, true, true);
 
-        bUpdateAnchors_ = true;
+        fire_update_anchors_();
         fire_update_borders();
         notify_renderer_need_redraw();
         pManager_->notify_object_moved();
@@ -491,7 +491,7 @@ void uiobject::set_all_points(uiobject* pObj)
 
         lDefinedBorderList_ = quad2<bool>(true, true, true, true);
 
-        bUpdateAnchors_ = true;
+        fire_update_anchors_();
         fire_update_borders();
         notify_renderer_need_redraw();
         pManager_->notify_object_moved();
@@ -555,7 +555,7 @@ void uiobject::set_abs_point(anchor_point mPoint, const std::string& sParentName
         default : break;
     }
 
-    bUpdateAnchors_ = true;
+    fire_update_anchors_();
     fire_update_borders();
     notify_renderer_need_redraw();
     pManager_->notify_object_moved();
@@ -616,7 +616,7 @@ void uiobject::set_rel_point(anchor_point mPoint, const std::string& sParentName
         default : break;
     }
 
-    bUpdateAnchors_ = true;
+    fire_update_anchors_();
     fire_update_borders();
     notify_renderer_need_redraw();
     pManager_->notify_object_moved();
@@ -659,7 +659,7 @@ void uiobject::set_point(const anchor& mAnchor)
         default : break;
     }
 
-    bUpdateAnchors_ = true;
+    fire_update_anchors_();
     fire_update_borders();
     notify_renderer_need_redraw();
     pManager_->notify_object_moved();
@@ -929,6 +929,8 @@ void uiobject::update_borders_() const
     else
         bReady_ = false;
 
+    notify_borders_updated();
+
     if (bReady_ || (!bReady_ && bOldReady))
     {
         DEBUG_LOG("  Fire redraw");
@@ -993,6 +995,7 @@ void uiobject::update_anchors()
 void uiobject::fire_update_borders() const
 {
     bUpdateBorders_ = true;
+    fire_update();
 
     std::map<uint, uiobject*>::const_iterator iterAnchored;
     foreach (iterAnchored, lAnchoredObjectList_)
@@ -1005,11 +1008,39 @@ void uiobject::fire_update_dimensions() const
     bUpdateDimensions_ = true;
 }
 
+void uiobject::fire_update() const
+{
+    bUpdateNeeded_ = true;
+
+    // The parents must be updated to reach this widget
+    const uiobject* pParent = pParent_;
+    while (pParent && !pParent->bUpdateNeeded_)
+    {
+        pParent->bUpdateNeeded_ = true;
+        pParent = pParent->pParent_;
+    }
+}
+
+bool uiobject::is_update_needed() const
+{
+    return bUpdateNeeded_;
+}
+
+void uiobject::fire_update_anchors_()
+{
+    if (!bUpdateAnchors_)
+    {
+        bUpdateAnchors_ = true;
+        pManager_->notify_object_anchors_changed(this);
+    }
+}
+
 void uiobject::update(float fDelta)
 {
     //#define DEBUG_LOG(msg) gui::out << (msg) << std::endl
     #define DEBUG_LOG(msg)
     DEBUG_LOG("  Update " + sName_ + " (" + lType_.back() + ")");
+    bUpdateNeeded_ = false;
     update_borders_();
 
     if (bNewlyCreated_)
@@ -1072,6 +1103,7 @@ bool uiobject::is_manually_rendered() const
 void uiobject::set_newly_created()
 {
     bNewlyCreated_ = true;
+    fire_update();
 }
 
 bool uiobject::is_newly_created() const
@@ -1083,6 +1115,10 @@ void uiobject::notify_renderer_need_redraw() const
 {
 }
 
+void uiobject::notify_borders_updated() const
+{
+}
+
 void uiobject::fire_redraw() const
 {
 }
@@ -0,0 +1,191 @@
+#include "lxgui/gui_xmlloader.hpp"
+#include "lxgui/gui_out.hpp"
+
+#include <lxgui/xml_document.hpp>
+
+#include <algorithm>
+#include <sstream>
+#ifndef NO_CPP11_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace gui
+{
+struct xml_loader::file
+{
+    std::string                  sFile;
+    std::stringstream            mLog;
+    utils::refptr<xml::document> pDocument;
+    bool                         bValid;
+    bool                         bDone;
+};
+
+struct xml_loader::thread_pool
+{
+    thread_pool() : bStarted(false), uiNextFile(0u), bStop(false) {}
+
+#ifndef NO_CPP11_THREADS
+    std::vector<std::thread> lThreadList;
+    std::mutex               mMutex;
+    std::condition_variable  mCondition;
+#endif
+    bool                     bStarted;
+    uint                     uiNextFile;
+    bool                     bStop;
+};
+
+xml_loader::xml_loader() : pPool_(new thread_pool())
+{
+}
+
+xml_loader::~xml_loader()
+{
+    clear();
+    delete pPool_;
+}
+
+void xml_loader::set_definition(utils::refptr<xml::definition> pDefinition)
+{
+    pDefinition_ = pDefinition;
+}
+
+void xml_loader::set_cache_directory(const std::string& sDirectory)
+{
+    sCacheDirectory_ = sDirectory;
+}
+
+void xml_loader::add_file(const std::string& sFile)
+{
+    if (pPool_->bStarted || lFileList_.find(sFile) != lFileList_.end())
+        return;
+
+    utils::refptr<file> pFile(new file());
+    pFile->sFile = sFile;
+    pFile->bValid = false;
+    pFile->bDone = false;
+
+    // The document is created here, since it shares the definition
+    // with a reference counter that is not thread safe
+    pFile->pDocument = utils::refptr<xml::document>(
+        new xml::document(sFile, pDefinition_, pFile->mLog)
+    );
+
+    lFileList_[sFile] = pFile;
+    lQueue_.push_back(pFile.get());
+}
+
+void xml_loader::start(uint uiThreadCount)
+{
+    if (pPool_->bStarted)
+        return;
+
+    pPool_->bStarted = true;
+
+#ifndef NO_CPP11_THREADS
+
+    uiThreadCount = std::min<uint>(uiThreadCount, lQueue_.size());
+    for (uint i = 0; i < uiThreadCount; ++i)
+        pPool_->lThreadList.push_back(std::thread(&xml_loader::run_thread_, this));
+#endif
+}
+
+utils::refptr<xml::document> xml_loader::load_file(const std::string& sFile, bool& bValid)
+{
+    std::map<std::string, utils::refptr<file>>::iterator iter = lFileList_.find(sFile);
+    if (iter == lFileList_.end() || !iter->second->pDocument)
+    {
+        // Not parsed in the background (or already loaded once)
+        utils::refptr<xml::document> pDocument(new xml::document(sFile, pDefinition_, gui::out));
+        bValid = parse_(*pDocument, sFile);
+        return pDocument;
+    }
+
+    file* pFile = iter->second.get();
+#ifdef NO_CPP11_THREADS
+    pFile->bValid = parse_(*pFile->pDocument, sFile);
+    pFile->bDone = true;
+#else
+    {
+        std::unique_lock<std::mutex> mLock(pPool_->mMutex);
+        if (pPool_->lThreadList.empty() && !pFile->bDone)
+        {
+            // No thread : parse it now
+            mLock.unlock();
+            pFile->bValid = parse_(*pFile->pDocument, sFile);
+            pFile->bDone = true;
+        }
+        else
+        {
+            while (!pFile->bDone)
+                pPool_->mCondition.wait(mLock);
+        }
+    }
+#endif
+
+    gui::out << pFile->mLog.str() << std::flush;
+
+    bValid = pFile->bValid;
+    utils::refptr<xml::document> pDocument = pFile->pDocument;
+    pFile->pDocument = nullptr;
+    return pDocument;
+}
+
+void xml_loader::clear()
+{
+#ifndef NO_CPP11_THREADS
+    {
+        std::unique_lock<std::mutex> mLock(pPool_->mMutex);
+        pPool_->bStop = true;
+    }
+
+    std::vector<std::thread>::iterator iterThread;
+    foreach (iterThread, pPool_->lThreadList)
+        iterThread->join();
+
+    pPool_->lThreadList.clear();
+#endif
+    lQueue_.clear();
+    lFileList_.clear();
+    pPool_->bStarted = false;
+    pPool_->uiNextFile = 0u;
+    pPool_->bStop = false;
+}
+
+bool xml_loader::parse_(xml::document& mDocument, const std::string& sFile) const
+{
+    if (sCacheDirectory_.empty())
+        return mDocument.check();
+    else
+        return mDocument.check_cached(sCacheDirectory_ + "/" + sFile + ".bin");
+}
+
+void xml_loader::run_thread_()
+{
+#ifndef NO_CPP11_THREADS
+    while (true)
+    {
+        file* pFile;
+        {
+            std::unique_lock<std::mutex> mLock(pPool_->mMutex);
+            if (pPool_->bStop || pPool_->uiNextFile == lQueue_.size())
+                return;
+
+            pFile = lQueue_[pPool_->uiNextFile];
+            ++pPool_->uiNextFile;
+        }
+
+        bool bValid = parse_(*pFile->pDocument, pFile->sFile);
+
+        {
+            std::unique_lock<std::mutex> mLock(pPool_->mMutex);
+            pFile->bValid = bValid;
+            pFile->bDone = true;
+        }
+
+        pPool_->mCondition.notify_all();
+    }
+#endif
+}
+}
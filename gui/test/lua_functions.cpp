@@ -0,0 +1,95 @@
+#include <lxgui/luapp_state.hpp>
+#include <lxgui/luapp_function.hpp>
+#include <lxgui/utils_filesystem.hpp>
+#include <lxgui/utils_string.hpp>
+
+int l_get_folder_list(lua_State* pLua)
+{
+    lua::function mFunc("get_folder_list", pLua);
+    mFunc.add(0, "folder", lua::TYPE_STRING);
+
+    if (mFunc.check())
+    {
+        std::vector<std::string> dirs = utils::get_directory_list(mFunc.get(0)->get_string());
+        std::vector<std::string>::iterator iter;
+        foreach (iter, dirs)
+            mFunc.push(*iter);
+    }
+
+    return mFunc.on_return();
+}
+
+int l_get_file_list(lua_State* pLua)
+{
+    lua::function mFunc("get_file_list", pLua);
+    mFunc.add(0, "folder", lua::TYPE_STRING);
+
+    if (mFunc.check())
+    {
+        std::vector<std::string> files = utils::get_file_list(mFunc.get(0)->get_string());
+        std::vector<std::string>::iterator iter;
+        foreach (iter, files)
+            mFunc.push(*iter);
+    }
+
+    return mFunc.on_return();
+}
+
+int l_cut_file_path(lua_State* pLua)
+{
+    lua::function mFunc("cut_file_path", pLua, 1);
+    mFunc.add(0, "path", lua::TYPE_STRING);
+
+    if (mFunc.check())
+    {
+        std::string sPath = mFunc.get(0)->get_string();
+        std::vector<std::string> lWords = utils::cut(sPath, "/");
+
+        std::vector<std::string>::iterator iter, iter2;
+        foreach (iter, lWords)
+        {
+            std::vector<std::string> lSubWords = utils::cut(*iter, "\\");
+            if (lSubWords.size() > 1)
+            {
+                iter = lWords.erase(iter);
+                foreach (iter2, lSubWords)
+                    iter = lWords.insert(iter, *iter2);
+            }
+        }
+
+        std::string sFile = lWords.back();
+        if (sFile.find(".") != sFile.npos)
+            lWords.pop_back();
+        else
+            sFile = "";
+
+        std::string sFolder;
+        foreach (iter, lWords)
+        {
+            if (sFolder.empty())
+                sFolder += *iter;
+            else
+                sFolder += "/" + *iter;
+        }
+
+        lua::state* pState = mFunc.get_state();
+        pState->new_table();
+        pState->set_field_string("file", sFile);
+        pState->set_field_string("folder", sFolder);
+        pState->new_table();
+        pState->set_field("folders");
+        pState->get_field("folders");
+
+        uint i = 1;
+        foreach (iter, lWords)
+        {
+            pState->set_field_string(i, *iter);
+            ++i;
+        }
+
+        pState->pop();
+        mFunc.notify_pushed();
+    }
+
+    return mFunc.on_return();
+}
@@ -173,7 +173,7 @@ int main(int argc, char* argv[])
         float update_time = 0.5f, timer = 1.0f;
         int frames = 0;
         pFrame->define_script("OnUpdate",
-            [&](gui::frame* self, gui::event* event) {
+            [&](gui::frame* self, const gui::event* event) {
                 float delta = event->get(0)->get<float>();
                 timer += delta;
                 ++frames;
@@ -282,94 +282,3 @@ int main(int argc, char* argv[])
 
     return 0;
 }
-
-int l_get_folder_list(lua_State* pLua)
-{
-    lua::function mFunc("get_folder_list", pLua);
-    mFunc.add(0, "folder", lua::TYPE_STRING);
-
-    if (mFunc.check())
-    {
-        std::vector<std::string> dirs = utils::get_directory_list(mFunc.get(0)->get_string());
-        std::vector<std::string>::iterator iter;
-        foreach (iter, dirs)
-            mFunc.push(*iter);
-    }
-
-    return mFunc.on_return();
-}
-
-int l_get_file_list(lua_State* pLua)
-{
-    lua::function mFunc("get_file_list", pLua);
-    mFunc.add(0, "folder", lua::TYPE_STRING);
-
-    if (mFunc.check())
-    {
-        std::vector<std::string> files = utils::get_file_list(mFunc.get(0)->get_string());
-        std::vector<std::string>::iterator iter;
-        foreach (iter, files)
-            mFunc.push(*iter);
-    }
-
-    return mFunc.on_return();
-}
-
-int l_cut_file_path(lua_State* pLua)
-{
-    lua::function mFunc("cut_file_path", pLua, 1);
-    mFunc.add(0, "path", lua::TYPE_STRING);
-
-    if (mFunc.check())
-    {
-        std::string sPath = mFunc.get(0)->get_string();
-        std::vector<std::string> lWords = utils::cut(sPath, "/");
-
-        std::vector<std::string>::iterator iter, iter2;
-        foreach (iter, lWords)
-        {
-            std::vector<std::string> lSubWords = utils::cut(*iter, "\\");
-            if (lSubWords.size() > 1)
-            {
-                iter = lWords.erase(iter);
-                foreach (iter2, lSubWords)
-                    iter = lWords.insert(iter, *iter2);
-            }
-        }
-
-        std::string sFile = lWords.back();
-        if (sFile.find(".") != sFile.npos)
-            lWords.pop_back();
-        else
-            sFile = "";
-
-        std::string sFolder;
-        foreach (iter, lWords)
-        {
-            if (sFolder.empty())
-                sFolder += *iter;
-            else
-                sFolder += "/" + *iter;
-        }
-
-        lua::state* pState = mFunc.get_state();
-        pState->new_table();
-        pState->set_field_string("file", sFile);
-        pState->set_field_string("folder", sFolder);
-        pState->new_table();
-        pState->set_field("folders");
-        pState->get_field("folders");
-
-        uint i = 1;
-        foreach (iter, lWords)
-        {
-            pState->set_field_string(i, *iter);
-            ++i;
-        }
-
-        pState->pop();
-        mFunc.notify_pushed();
-    }
-
-    return mFunc.on_return();
-}
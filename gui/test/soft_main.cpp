@@ -0,0 +1,196 @@
+#include <lxgui/gui_manager.hpp>
+#include <lxgui/gui_texture.hpp>
+#include <lxgui/gui_fontstring.hpp>
+#include <lxgui/gui_button.hpp>
+#include <lxgui/gui_slider.hpp>
+#include <lxgui/gui_editbox.hpp>
+#include <lxgui/gui_scrollframe.hpp>
+#include <lxgui/gui_statusbar.hpp>
+#include <lxgui/gui_out.hpp>
+#include <lxgui/input.hpp>
+#include <lxgui/luapp_state.hpp>
+#include <lxgui/utils_filesystem.hpp>
+#include <lxgui/utils_string.hpp>
+#include <lxgui/impl/gui_soft_manager.hpp>
+#include <lxgui/impl/gui_soft_material.hpp>
+#include <lxgui/impl/gui_soft_rendertarget.hpp>
+#include <lxgui/impl/gui_common_png.hpp>
+
+#include <png.h>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+
+// Renders the test interface with the software implementation of the gui,
+// without any window, and compares the result with a reference screenshot.
+//
+// Usage : lxgui-test-soft [reference.png] [max. ratio of differing pixels]
+//
+// The reference was taken with the OpenGL implementation, and some elements
+// depend on the machine (FPS counters, content of the file browser) : the
+// images are only expected to be close, not identical. The rendered image
+// is saved in soft_output.png.
+
+int l_get_folder_list(lua_State* pLua);
+int l_get_file_list(lua_State* pLua);
+int l_cut_file_path(lua_State* pLua);
+
+// An input source that never receives any event
+class null_handler : public input::handler_impl
+{
+public :
+
+    void update() {}
+    void toggle_mouse_grab() {}
+    std::string get_key_name(input::key::code mKey) const { return ""; }
+};
+
+bool write_png(const std::string& sFileName, uint uiWidth, uint uiHeight,
+    const std::vector<gui::soft::ub32color>& lData)
+{
+    FILE* pFile = fopen(sFileName.c_str(), "wb");
+    if (!pFile)
+        return false;
+
+    png_structp pWriteStruct = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    png_infop pInfoStruct = pWriteStruct ? png_create_info_struct(pWriteStruct) : nullptr;
+    if (!pInfoStruct || setjmp(png_jmpbuf(pWriteStruct)))
+    {
+        png_destroy_write_struct(&pWriteStruct, &pInfoStruct);
+        fclose(pFile);
+        return false;
+    }
+
+    png_init_io(pWriteStruct, pFile);
+    png_set_IHDR(pWriteStruct, pInfoStruct, uiWidth, uiHeight, 8, PNG_COLOR_TYPE_RGBA,
+        PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    png_write_info(pWriteStruct, pInfoStruct);
+
+    for (uint y = 0; y < uiHeight; ++y)
+        png_write_row(pWriteStruct, (png_const_bytep)(&lData[y*uiWidth]));
+
+    png_write_end(pWriteStruct, nullptr);
+    png_destroy_write_struct(&pWriteStruct, &pInfoStruct);
+    fclose(pFile);
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string sReferenceFile = "../expected.png";
+    float fMaxDiffRatio = 0.05f;
+    if (argc > 1)
+        sReferenceFile = argv[1];
+    if (argc > 2)
+        fMaxDiffRatio = utils::string_to_float(argv[2]);
+
+    // Redirect output from the gui library to a log file
+    std::fstream mGUI("gui_soft.txt", std::ios::out);
+    gui::out.rdbuf(mGUI.rdbuf());
+
+    try
+    {
+        // Read the reference image
+        std::ifstream mFile(sReferenceFile.c_str(), std::ios::binary);
+        if (!mFile.is_open() || !gui::common::check_png_signature(mFile))
+        {
+            std::cout << "# Error # : cannot read \"" << sReferenceFile << "\"." << std::endl;
+            return 1;
+        }
+
+        gui::common::png_reader mReader(mFile);
+        mReader.read_header();
+
+        uint uiWidth  = mReader.get_width();
+        uint uiHeight = mReader.get_height();
+        std::vector<uchar> lReference(uiWidth*uiHeight*4);
+        mReader.read_image(lReference.data());
+
+        std::string sLocale = "enGB";
+        if (utils::file_exists("config.lua"))
+        {
+            lua::state mLua;
+            mLua.do_file("config.lua");
+            sLocale = mLua.get_global_string("locale", false, "enGB");
+        }
+
+        // Initialize the gui, with the dimensions of the reference image
+        utils::refptr<gui::soft::manager> pSoftManager(new gui::soft::manager());
+        gui::manager mManager(
+            input::handler(utils::refptr<input::handler_impl>(new null_handler())),
+            sLocale, uiWidth, uiHeight, utils::refptr<gui::manager_impl>(pSoftManager)
+        );
+
+        mManager.enable_caching(false);
+        mManager.add_addon_directory("interface");
+        mManager.create_lua([&mManager](){
+            mManager.register_region_type<gui::texture>();
+            mManager.register_region_type<gui::font_string>();
+            mManager.register_frame_type<gui::button>();
+            mManager.register_frame_type<gui::slider>();
+            mManager.register_frame_type<gui::edit_box>();
+            mManager.register_frame_type<gui::scroll_frame>();
+            mManager.register_frame_type<gui::status_bar>();
+            mManager.get_lua()->reg("get_folder_list", l_get_folder_list);
+            mManager.get_lua()->reg("get_file_list",   l_get_file_list);
+            mManager.get_lua()->reg("cut_file_path",   l_cut_file_path);
+        });
+
+        mManager.read_files();
+
+        // Let the scripts run for a few frames
+        for (uint i = 0; i < 10; ++i)
+            mManager.update(0.1f);
+
+        // Render the gui on the same background as the OpenGL test
+        utils::refptr<gui::soft::render_target> pScreen = pSoftManager->get_screen_target().lock();
+        pScreen->clear(gui::color(0.2f, 0.2f, 0.2f, 1.0f));
+        mManager.render_ui();
+
+        utils::refptr<gui::soft::material> pPixels = pScreen->get_material().lock();
+        if (!write_png("soft_output.png", uiWidth, uiHeight, pPixels->get_data()))
+            std::cout << "# Warning # : cannot write \"soft_output.png\"." << std::endl;
+
+        // Compare the rendered image with the reference
+        const int iTolerance = 48;
+        uint uiDiffCount = 0;
+        for (uint y = 0; y < uiHeight; ++y)
+        for (uint x = 0; x < uiWidth; ++x)
+        {
+            const gui::soft::ub32color& mPixel = pPixels->get_pixel(x, y);
+            const uchar* pRef = &lReference[(y*uiWidth + x)*4];
+            if (std::abs(int(mPixel.r) - int(pRef[0])) > iTolerance ||
+                std::abs(int(mPixel.g) - int(pRef[1])) > iTolerance ||
+                std::abs(int(mPixel.b) - int(pRef[2])) > iTolerance)
+                ++uiDiffCount;
+        }
+
+        float fDiffRatio = uiDiffCount/float(uiWidth*uiHeight);
+        std::cout << uiDiffCount << " pixels out of " << uiWidth*uiHeight << " differ from \""
+            << sReferenceFile << "\" (" << fDiffRatio*100.0f << "%, max. "
+            << fMaxDiffRatio*100.0f << "%)." << std::endl;
+
+        if (fDiffRatio > fMaxDiffRatio)
+        {
+            std::cout << "# Error # : the rendered image does not match the reference." << std::endl;
+            return 1;
+        }
+    }
+    catch (utils::exception& e)
+    {
+        std::cout << e.get_description() << std::endl;
+        return 1;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cout << "# Error # : Unhandled exception !" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
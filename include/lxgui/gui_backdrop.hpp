@@ -167,6 +167,13 @@ namespace gui
         /// Renders this backdrop on the current render target.
         void render() const;
 
+        /// Checks if the textures of this backdrop have finished loading.
+        /** \note Called by the parent frame on each update. Asks the
+        *         frame for a redraw when a texture that was loading in
+        *         the background becomes ready.
+        */
+        void update();
+
     private :
 
         frame*      pParent_;
@@ -178,6 +185,9 @@ namespace gui
         mutable utils::refptr<sprite>               pBackground_;
         mutable std::array<utils::refptr<sprite>,8> lEdgeList_;
 
+        utils::wptr<material> pPendingBackground_;
+        utils::wptr<material> pPendingEdge_;
+
         bool   bBackgroundTilling_;
         uint   uiTileSize_;
         uint   uiOriginalTileSize_;
@@ -57,7 +57,7 @@ namespace gui
         /** \param sScriptName The name of the script
         *   \param pEvent      Stores scripts arguments
         */
-        virtual void on(const std::string& sScriptName, event* pEvent = nullptr);
+        virtual void on(const std::string& sScriptName, const event* pEvent = nullptr);
 
         /// Calls the on_event script.
         /** \param mEvent The Event that occured
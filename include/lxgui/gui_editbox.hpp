@@ -115,7 +115,7 @@ namespace gui
         /** \param sScriptName The name of the script
         *   \param pEvent      Stores scripts arguments
         */
-        virtual void on(const std::string& sScriptName, event* pEvent = nullptr);
+        virtual void on(const std::string& sScriptName, const event* pEvent = nullptr);
 
         /// Returns 'true' if this edit_box can use a script.
         /** \param sScriptName The name of the script
@@ -344,13 +344,15 @@ namespace gui
         bool add_char_(char32_t sChar);
         bool remove_char_();
         uint get_letter_id_at_(int iX, int iY);
+        uint get_letter_id_before_carret_(float fWidth) const;
         bool move_carret_at_(int iX, int iY);
         bool move_carret_horizontally_(bool bForward = true);
         bool move_carret_vertically_(bool bDown = true);
 
         void process_key_(uint uiKey);
 
-        std::string              sText_;
+        mutable std::string      sText_;
+        mutable bool             bUpdateText_;
         utils::ustring           sUnicodeText_;
         utils::ustring           sDisplayedText_;
         utils::ustring::iterator iterCarretPos_;
@@ -64,6 +64,30 @@ namespace gui
         */
         const std::string& get_name() const;
 
+        /// Returns the identifier of this event's name.
+        /** \return The identifier of this event's name
+        *   \note See get_id(const std::string&).
+        */
+        uint get_id() const;
+
+        /// Returns the identifier of an event name.
+        /** \param sName The name of the event
+        *   \return The identifier of this event name
+        *   \note Each name is given a unique identifier the first time it
+        *         is seen, starting from zero : identifiers can thus be used
+        *         as indices in flat tables, and compared without comparing
+        *         strings.
+        */
+        static uint get_id(const std::string& sName);
+
+        /// Returns the identifier of an event name, if it has one.
+        /** \param sName The name of the event
+        *   \return The identifier of this event name, or uint(-1) if
+        *           this name has never been given an identifier
+        *   \note Unlike get_id(), this function never stores the name.
+        */
+        static uint find_id(const std::string& sName);
+
         /// Checks if this event should only be fired once per frame.
         /** \return 'true' if this should only be fired once per frame
         */
@@ -76,6 +100,7 @@ namespace gui
     private :
 
         std::string           sName_;
+        uint                  uiID_;
         bool                  bOncePerFrame_;
         std::vector<lua::var> lArgList_;
     };
@@ -3,7 +3,6 @@
 
 #include <lxgui/utils.hpp>
 #include <string>
-#include <map>
 #include <vector>
 
 namespace gui
@@ -12,10 +11,18 @@ namespace gui
     class event;
 
     /// Manages events and their responses
+    /** Receivers are stored in a table indexed by the identifier of
+    *   each event (see event::get_id()), so that firing an event does
+    *   not depend on the length of its name, nor on the number of
+    *   different events that are registered.
+    */
     class event_manager
     {
     public :
 
+        /// Constructor.
+        event_manager();
+
         /// Enables an event_receiver's reaction to an event.
         /** \param pReceiver The event_receiver to consider
         *   \param sEvent    The name of the event it should react to
@@ -38,6 +45,9 @@ namespace gui
         *   \note All event_receivers registred to react to this Event
         *         will be told the Event has occured by calling
         *         event_receiver::on_event().
+        *   \note Receivers that are unregistered while an event is being
+        *         fired are not told anymore, and are removed from the
+        *         lists once all the events have been fired.
         */
         void fire_event(const event& mEvent);
 
@@ -46,8 +56,15 @@ namespace gui
 
     private :
 
-        std::multimap<std::string, event_receiver*> lReceiverList_;
-        std::vector<std::string>                    lFiredEventList_;
+        void remove_receiver_(uint uiID, std::vector<event_receiver*>::iterator iterReceiver);
+        void remove_null_receivers_();
+
+        std::vector<std::vector<event_receiver*>> lReceiverList_;
+        std::vector<bool>                         lFiredEventList_;
+        std::vector<uint>                         lFiredIDList_;
+
+        uint              uiFireDepth_;
+        std::vector<uint> lNullReceiverIDList_;
     };
 
 }
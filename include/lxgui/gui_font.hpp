@@ -40,6 +40,13 @@ namespace gui
         */
         virtual float get_character_width(char32_t uiChar) const = 0;
 
+        /// Returns the height of a character in pixels.
+        /** \param uiChar The unicode character
+        *   \return The height of the character in pixels.
+        *   \note By default, this is the height of the character on the texture.
+        */
+        virtual float get_character_height(char32_t uiChar) const;
+
         /// Return the kerning amount between two characters.
         /** \param uiChar1 The first unicode character
         *   \param uiChar2 The second unicode character
@@ -51,10 +58,50 @@ namespace gui
         */
         virtual float get_character_kerning(char32_t uiChar1, char32_t uiChar2) const = 0;
 
+        /// Returns the width of several characters in pixels.
+        /** \param pChars  The unicode characters
+        *   \param uiCount The number of characters
+        *   \param pWidths The array to fill (uiCount values)
+        *   \note By default, this calls get_character_width() for each
+        *         character. Implementations can override it to look the
+        *         characters up without a virtual call for each of them.
+        */
+        virtual void get_character_widths(const char32_t* pChars, uint uiCount, float* pWidths) const;
+
+        /// Returns the kerning amounts between consecutive characters.
+        /** \param pChars    The unicode characters
+        *   \param uiCount   The number of characters
+        *   \param pKernings The array to fill (uiCount-1 values : the
+        *                    kerning between pChars[i] and pChars[i+1])
+        *   \note By default, this calls get_character_kerning() for each
+        *         pair of characters.
+        */
+        virtual void get_character_kernings(const char32_t* pChars, uint uiCount, float* pKernings) const;
+
         /// Returns the underlying material to use for rendering.
         /** \return The underlying material to use for rendering
         */
         virtual utils::wptr<material> get_texture() const = 0;
+
+        /// Returns a number that changes when the font texture is resized.
+        /** \return A number that changes when the font texture is resized
+        *   \note When the texture is resized, the uv coordinates returned by
+        *         get_character_uvs() are not valid anymore, and must be
+        *         queried again. Returns 0 by default (fixed texture size).
+        */
+        virtual uint get_texture_revision() const;
+
+        /// Returns the material to use to render outlined characters.
+        /** \param fThickness The thickness of the outline (in pixels)
+        *   \return The material to use to render outlined characters
+        *           (nullptr if not supported)
+        *   \note This material renders both the characters and their outline
+        *         in a single pass (see gui::text::render_outlined()). It uses
+        *         the uv coordinates returned by get_character_uvs(), and the
+        *         texture must have at least fThickness pixels of free space
+        *         around each character. Returns nullptr by default.
+        */
+        virtual utils::wptr<material> get_outline_texture(float fThickness) const;
     };
 }
 
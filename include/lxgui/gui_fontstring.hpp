@@ -38,6 +38,12 @@ namespace gui
         /// updates this widget's logic.
         virtual void update(float fDelta);
 
+        /// Returns the area of the screen covered by this font_string when rendered.
+        /** \return The area of the screen covered by this font_string when rendered
+        *   \note This includes the shadow and the outline.
+        */
+        virtual quad2i get_render_area() const;
+
         /// Returns the name of the font file.
         /** \return The name of the font file
         */
@@ -230,12 +236,25 @@ namespace gui
         */
         bool is_formatting_enabled() const;
 
+        /// Enables sharing the text layout with identical font_strings.
+        /** \param bShare 'true' to share the text layout
+        *   \note Enabled by default. See text::enable_layout_sharing().
+        */
+        void enable_layout_sharing(bool bShare);
+
         /// Sets the rendered text.
         /** \param sText The rendered text
         *   \note See text::set_text for more infos about formatting.
         */
         void set_text(const std::string& sText);
 
+        /// Sets the rendered text (unicode character set).
+        /** \param sText The rendered text
+        *   \note See text::set_unicode_text(). The UTF-8 string returned by
+        *         get_text() is only built when it is requested.
+        */
+        void set_unicode_text(const utils::ustring& sText);
+
         /// Creates the associated Lua glue.
         virtual void create_glue();
 
@@ -267,8 +286,9 @@ namespace gui
 
         mutable utils::refptr<text> pText_;
 
-        std::string sText_;
-        std::string sFontName_;
+        mutable std::string sText_;
+        mutable bool        bUpdateText_;
+        std::string         sFontName_;
         uint        uiHeight_;
 
         float                    fSpacing_;
@@ -282,12 +302,15 @@ namespace gui
         bool  bCanWordWrap_;
         bool  bAddEllipsis_;
         bool  bFormattingEnabled_;
+        bool  bLayoutSharingEnabled_;
         color mTextColor_;
 
         bool  bHasShadow_;
         color mShadowColor_;
         int   iShadowXOffset_;
         int   iShadowYOffset_;
+
+        std::vector<text::copy> lCopyList_;
     };
 
     /** \cond NOT_REMOVE_FROM_DOC
@@ -10,6 +10,7 @@
 namespace gui
 {
     class backdrop;
+    class frame_grid;
 
     /// Contains layered_region
     struct layer
@@ -28,6 +29,7 @@ namespace gui
     */
     class frame : public event_receiver, public region
     {
+    friend frame_grid;
     public :
 
         /// Constructor.
@@ -333,6 +335,21 @@ namespace gui
         */
         virtual bool is_in_frame(int iX, int iY) const;
 
+        /// Returns the area of the screen covered by this frame when rendered.
+        /** \return The area of the screen covered by this frame when rendered
+        *   \note This includes the backdrop and all the layered regions.
+        *         Used by the manager to only redraw the frames that have
+        *         been damaged.
+        */
+        quad2i get_render_area() const;
+
+        /// Returns the area of the screen in which this frame can be hovered.
+        /** \return The area of the screen in which this frame can be hovered
+        *   \note is_in_frame() always returns 'false' outside of this area.
+        *         Used by the frame_grid to find the hovered frame quickly.
+        */
+        virtual quad2i get_hit_area() const;
+
         /// Checks if this frame can receive keyboard input.
         /** \return 'true' if this frame can receive keyboard input
         */
@@ -379,11 +396,14 @@ namespace gui
         *   \param sFile       The file in which this script has been found
         *   \param uiLineNbr   The line number at which this script is located in the file
         *   \note The last two informations are required for error messages.
+        *   \note The script receives its arguments in the 'arg1' to 'arg9' local
+        *         variables, and in '...'. The OnEvent script also receives the
+        *         name of the event in the 'event' local variable.
         */
         void define_script(const std::string& sScriptName, const std::string& sContent,
             const std::string& sFile, uint uiLineNbr);
 
-        typedef std::function<void(frame*, event*)> handler;
+        typedef std::function<void(frame*, const event*)> handler;
 
         /// Registers a handler script to this frame.
         /** \param sScriptName The name of the script
@@ -400,8 +420,10 @@ namespace gui
         /// Calls a script.
         /** \param sScriptName The name of the script
         *   \param pEvent      Stores scripts arguments
+        *   \note Lua scripts are called with 'self', then the name of the event
+        *         (OnEvent only), then the parameters of the event.
         */
-        virtual void on(const std::string& sScriptName, event* pEvent = nullptr);
+        virtual void on(const std::string& sScriptName, const event* pEvent = nullptr);
 
         /// Calls the on_event script.
         /** \param mEvent The Event that occured
@@ -632,8 +654,8 @@ namespace gui
 
         /// Tells this frame that at least one of its children has modified its strata or level.
         /** \param pChild The child that has changed its strata (can also be a child of this child)
-        *   \note If this frame has no parent, it calls manager::fire_build_strata_list(). Else it
-        *         notifies its parent.
+        *   \note This function only notifies the parent frame, if any: the manager is directly
+        *         notified by the child itself (see manager::notify_frame_strata_changed()).
         */
         virtual void notify_child_strata_changed(frame* pChild);
 
@@ -642,6 +664,12 @@ namespace gui
         */
         virtual void notify_renderer_need_redraw() const;
 
+        /// Notifies this widget that its borders have been updated.
+        /** \note The frame version of this function tells the frame_grid
+        *         this frame is registered in that its hit area has changed.
+        */
+        virtual void notify_borders_updated() const;
+
         /// Notifies this widget that it has been fully loaded.
         /** \note Calls the "OnLoad" script.
         */
@@ -714,6 +742,13 @@ namespace gui
 
         void add_level_(int iAmount);
 
+        void queue_event_(const std::string& sScriptName);
+
+        void set_legacy_script_globals_(const std::string& sScriptName, const event* pEvent);
+
+        void set_script_ref_(const std::string& sScriptName, int iRef);
+        void remove_script_ref_(const std::string& sScriptName);
+
         virtual void update_borders_() const;
 
         struct script_info
@@ -727,6 +762,7 @@ namespace gui
         std::map<layer_type, layer>        lLayerList_;
         std::map<std::string, std::string> lDefinedScriptList_;
         std::map<std::string, script_info> lXMLScriptInfoList_;
+        std::map<std::string, int>         lScriptRefList_;
         std::vector<std::string>           lQueuedEventList_;
         std::set<std::string>              lRegEventList_;
         std::set<std::string>              lRegDragList_;
@@ -776,6 +812,12 @@ namespace gui
 
         std::vector<std::string> lMouseButtonList_;
         bool                     bMouseDragged_;
+
+        mutable quad2i lLastRenderArea_;
+
+        frame_grid* pFrameGrid_;
+
+        int iLuaSelfRef_;
     };
 
     /** \cond NOT_REMOVE_FROM_DOC
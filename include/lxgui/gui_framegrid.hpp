@@ -0,0 +1,94 @@
+#ifndef GUI_FRAMEGRID_HPP
+#define GUI_FRAMEGRID_HPP
+
+#include <lxgui/utils.hpp>
+#include "lxgui/gui_quad2.hpp"
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+namespace gui
+{
+    class frame;
+
+    /// Spatial index used to find the frame under the mouse.
+    /** The screen is split into square cells, and each frame is
+    *   registered in all the cells covered by its hit area (see
+    *   frame::get_hit_area()). Each cell keeps its frames sorted
+    *   from the topmost to the bottommost (strata, then level, then
+    *   creation order), so that finding the frame at a given position
+    *   only requires testing the few frames of a single cell.
+    *   \note Frames are automatically moved to their new cells when
+    *         their borders are updated. If the strata or level of a
+    *         frame is changed, it has to be removed and added again.
+    */
+    class frame_grid
+    {
+    public :
+
+        /// Constructor.
+        /** \param uiCellSize The size of a grid cell (in pixels)
+        */
+        explicit frame_grid(uint uiCellSize = 64u);
+
+        /// Destructor.
+        ~frame_grid();
+
+        /// Registers a frame in this grid.
+        /** \param pFrame The frame to add
+        *   \note A frame can only be registered in a single grid.
+        *         If it is already registered in another one, it is
+        *         first removed from it.
+        */
+        void add_frame(frame* pFrame);
+
+        /// Unregisters a frame from this grid.
+        /** \param pFrame The frame to remove
+        */
+        void remove_frame(frame* pFrame);
+
+        /// Removes all frames from this grid.
+        void clear();
+
+        /// Tells this grid that the hit area of a frame has changed.
+        /** \param pFrame The frame that has moved
+        *   \note The frame will be moved to its new cells on the next
+        *         call to find_frame().
+        */
+        void notify_frame_moved(const frame* pFrame);
+
+        /// Returns the topmost frame that can be hovered at the given position.
+        /** \param iX The horizontal coordinate
+        *   \param iY The vertical coordinate
+        *   \return The topmost frame that is visible, mouse enabled and
+        *           contains the given position (nullptr if none)
+        */
+        frame* find_frame(int iX, int iY) const;
+
+    private :
+
+        struct entry
+        {
+            frame* pFrame;
+            quad2i mCells;
+            bool   bLarge;
+            bool   bDirty;
+        };
+
+        unsigned long long get_cell_key_(int iCellX, int iCellY) const;
+        int                get_cell_coord_(int iCoord) const;
+
+        void               insert_(entry& mEntry) const;
+        void               erase_(const entry& mEntry) const;
+        void               update_() const;
+
+        uint uiCellSize_;
+
+        mutable std::map<const frame*, entry>                               lEntryList_;
+        mutable std::unordered_map<unsigned long long, std::vector<frame*>> lCellList_;
+        mutable std::vector<frame*>                                         lLargeFrameList_;
+        mutable std::vector<const frame*>                                   lDirtyFrameList_;
+    };
+}
+
+#endif
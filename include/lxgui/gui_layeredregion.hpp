@@ -72,6 +72,13 @@ namespace gui
         */
         virtual void notify_renderer_need_redraw() const;
 
+        /// Returns the area of the screen covered by this region when rendered.
+        /** \return The area of the screen covered by this region when rendered
+        *   \note By default, this is the borders of the region. Regions that
+        *         draw outside of their borders must return a larger area.
+        */
+        virtual quad2i get_render_area() const;
+
         /// Parses data from an xml::block.
         /** \param pBlock The frame's xml::block
         */
@@ -4,6 +4,10 @@
 #include "lxgui/gui_eventreceiver.hpp"
 #include "lxgui/gui_anchor.hpp"
 #include "lxgui/gui_material.hpp"
+#include "lxgui/gui_quad2.hpp"
+#include "lxgui/gui_framegrid.hpp"
+#include "lxgui/gui_xmlloader.hpp"
+#include "lxgui/gui_textlayoutcache.hpp"
 #include <lxgui/utils_exception.hpp>
 #include <lxgui/utils_refptr.hpp>
 #include <lxgui/utils_wptr.hpp>
@@ -22,6 +26,10 @@ namespace input {
     class manager;
 }
 
+namespace xml {
+    class definition;
+}
+
 namespace gui
 {
     class uiobject;
@@ -92,6 +100,7 @@ namespace gui
     /// Contains frame
     struct level
     {
+        int                 iLevel;
         std::vector<frame*> lFrameList;
     };
 
@@ -101,9 +110,27 @@ namespace gui
         strata();
         ~strata();
 
+        /// Adds a frame to this strata.
+        /** \param pFrame The frame to add
+        *   \param iLevel The level in which to add the frame
+        *   \note Levels are sorted by increasing level, and frames
+        *         are sorted by increasing ID within a level.
+        */
+        void add_frame(frame* pFrame, int iLevel);
+
+        /// Removes a frame from this strata.
+        /** \param pFrame The frame to remove
+        *   \param iLevel The level in which the frame has been added
+        *   \return 'false' if the frame was not found in this level
+        *   \note The frame is never dereferenced, so it can be
+        *         removed after it has been deleted.
+        */
+        bool remove_frame(frame* pFrame, int iLevel);
+
         uint                         uiID;
-        std::map<int, level>         lLevelList;
+        std::vector<level>           lLevelList;
         mutable bool                 bRedraw;
+        mutable std::vector<quad2i>  lDamageList;
         utils::refptr<render_target> pRenderTarget;
         utils::refptr<sprite>        pSprite;
         mutable uint                 uiRedrawCount;
@@ -188,6 +215,64 @@ namespace gui
         */
         void clear_addon_directory_list();
 
+        /// Sets the directory where compiled layout files are stored.
+        /** \param sDirectory The directory (empty to disable compiled layouts)
+        *   \note When set, each XML file is compiled into a binary file in
+        *         this directory, that is loaded instead of parsing the XML
+        *         file the next time the UI is loaded. The binary file is
+        *         only used as long as the XML file and the definition file
+        *         (ui.def) are unchanged : else, the XML file is parsed again
+        *         and the binary file is updated. Loading the UI once is thus
+        *         enough to compile all the layout files.<br>
+        *         Disabled by default.
+        */
+        void set_layout_cache_directory(const std::string& sDirectory);
+
+        /// Returns the directory where compiled layout files are stored.
+        /** \return The directory where compiled layout files are stored
+        *   \note See set_layout_cache_directory().
+        */
+        const std::string& get_layout_cache_directory() const;
+
+        /// Sets the number of threads used to parse XML files.
+        /** \param uiCount The number of threads (0 to parse XML files on the main thread)
+        *   \note When loading the UI, the XML files of all enabled addons
+        *         are parsed by these threads, while the main thread executes
+        *         Lua files and creates widgets in the order of the addon list.<br>
+        *         Defaults to 0 : background parsing is opt-in, and requires
+        *         linking to the thread library. The number of cores is a good
+        *         value on machines that have more than one.
+        */
+        void set_loading_thread_count(uint uiCount);
+
+        /// Returns the number of threads used to parse XML files.
+        /** \return The number of threads used to parse XML files
+        *   \note See set_loading_thread_count().
+        */
+        uint get_loading_thread_count() const;
+
+        /// Sets the maximum number of text layouts to keep in memory.
+        /** \param uiSize The maximum number of layouts (0 to disable the cache)
+        *   \note Texts with the same font, string and parameters share the
+        *         same layout, which is only computed once. The least recently
+        *         used layouts are removed first. Defaults to 256.
+        *   \note The cache is also bounded by its total number of letters,
+        *         and long texts are not cached (see get_text_layout_cache()).
+        */
+        void set_text_layout_cache_size(uint uiSize);
+
+        /// Returns the maximum number of text layouts to keep in memory.
+        /** \return The maximum number of text layouts to keep in memory
+        *   \note See set_text_layout_cache_size().
+        */
+        uint get_text_layout_cache_size() const;
+
+        /// Returns the cache of text layouts.
+        /** \return The cache of text layouts
+        *   \note Used by gui::text.
+        */
+        text_layout_cache& get_text_layout_cache();
+
         /// Checks the provided string is suitable for naming a widget.
         /** \param sName The string to test
         *   \return 'true' if the provided string can be the name of a widget
@@ -351,6 +436,13 @@ namespace gui
         */
         void notify_object_has_parent(uiobject* pObj);
 
+        /// Tells this manager that the anchors of an object have changed.
+        /** \param pObj The object whose anchors have changed
+        *   \note Only the objects given to this function have their
+        *         anchors updated on the next call to update().
+        */
+        void notify_object_anchors_changed(uiobject* pObj);
+
         /// Returns the uiobject associated with the given ID.
         /** \param uiID The unique ID representing the widget
         *   \return The uiobject associated with the given ID
@@ -378,8 +470,20 @@ namespace gui
         uiobject* get_uiobject_by_name(const std::string& sName, bool bVirtual = false);
 
         /// Tells this manager it must rebuild its strata list.
+        /** \note This rebuilds the whole list. If only a few frames have
+        *         been modified, prefer notify_frame_strata_changed().
+        */
         void fire_build_strata_list();
 
+        /// Tells this manager that a frame has changed its strata or level.
+        /** \param pFrame The frame that has changed
+        *   \note The frame is moved in the strata list on the next call to
+        *         update(), and only the affected strata are redrawn. Also
+        *         to be called when a frame is created, deleted, or becomes
+        *         (or stops being) manually rendered.
+        */
+        void notify_frame_strata_changed(frame* pFrame);
+
         /// Prints in the log several performance statistics.
         void print_statistics();
 
@@ -506,12 +610,16 @@ namespace gui
         /// Renders a set of quads.
         /** \param mQuad     The base quad to use for rendering (material, blending, ...)
         *   \param lQuadList The list of the quads you want to render
+        *   \param mOffset   The translation to apply to all the quads
         *   \note This function is meant to be called between begin() and
         *         end() only. It is always more efficient to call this method
         *         than calling render_quad repeatedly, as it allows to batch
         *         count reduction.
+        *   \note The translation allows rendering the same list of quads
+        *         at different positions, without modifying it.
         */
-        void render_quads(const quad& mQuad, const std::vector<std::array<vertex,4>>& lQuadList) const;
+        void render_quads(const quad& mQuad, const std::vector<std::array<vertex,4>>& lQuadList,
+            const vector2f& mOffset = vector2f::ZERO) const;
 
         /// Checks if the UI is currently being loaded.
         /** \return 'true' if the UI is currently being loaded
@@ -578,8 +686,19 @@ namespace gui
         void notify_object_moved();
 
         /// Tells this manager to redraw the UI.
+        /** \param mStrata The strata to redraw entirely
+        */
         void fire_redraw(frame_strata mStrata) const;
 
+        /// Tells this manager to redraw part of the UI.
+        /** \param mStrata The strata to redraw
+        *   \param mArea   The area of the screen that has changed
+        *   \note When caching is enabled, only the frames of this strata that
+        *         intersect the damaged area(s) are rendered again, and only
+        *         the damaged area(s) are copied to the screen.
+        */
+        void fire_redraw(frame_strata mStrata, const quad2i& mArea) const;
+
         /// Enables/disables GUI caching.
         /** \param bEnable 'true' to enable
         *   \note See toggle_caching().
@@ -617,6 +736,23 @@ namespace gui
         */
         bool is_input_enabled() const;
 
+        /// Enables/disables the legacy script globals.
+        /** \param bEnable 'true' to enable
+        *   \note Scripts receive their arguments as parameters (see frame::on()).
+        *         When enabled, these arguments are also copied into the 'arg1',
+        *         'arg2', ... and 'event' global variables before each call, for
+        *         older addons that rely on them. Disabling this saves several
+        *         global variable writes per call.
+        *   \note Enabled by default.
+        */
+        void enable_legacy_script_globals(bool bEnable);
+
+        /// Checks if the legacy script globals are enabled.
+        /** \return 'true' if the legacy script globals are enabled
+        *   \note See enable_legacy_script_globals().
+        */
+        bool is_legacy_script_globals_enabled() const;
+
         /// Sets wether the Manager should clear all fonts when closed.
         /** \param bClear 'true' to clear fonts
         *   \note Enabled by default. Note that when enabled, it will also
@@ -780,8 +916,12 @@ namespace gui
 
         void set_overed_frame_(frame* pFrame, int iX = 0, int iY = 0);
 
+        void add_to_strata_list_(frame* pFrame);
+        void update_strata_list_();
+
         void create_strata_render_target_(strata& mStrata);
         void render_strata_(strata& mStrata);
+        void render_strata_frames_(const strata& mStrata, const quad2i* pArea = nullptr) const;
 
         void parse_xml_file_(const std::string& sFile, addon* pAddOn);
 
@@ -800,6 +940,11 @@ namespace gui
         bool                      bLoadingUI_;
         bool                      bFirstIteration_;
 
+        utils::refptr<xml::definition> pXMLDefinition_;
+        std::string                    sLayoutCacheDirectory_;
+        xml_loader                     mXMLLoader_;
+        uint                           uiLoadingThreadCount_;
+
         bool                          bInputEnabled_;
         utils::refptr<input::manager> pInputManager_;
         std::map<uint, std::map<uint, std::map<uint, std::string>>> lKeyBindingList_;
@@ -809,6 +954,7 @@ namespace gui
 
         std::map<uint, uiobject*> lObjectList_;
         std::map<uint, uiobject*> lMainObjectList_;
+        std::vector<uint>         lAnchorChangedList_;
 
         std::vector<uiobject*> lRemovedObjectList_;
 
@@ -818,7 +964,20 @@ namespace gui
 
         std::map<uint, frame*>         lFrameList_;
         std::map<frame_strata, strata> lStrataList_;
+        frame_grid                     mFrameGrid_;
+        text_layout_cache              mTextLayoutCache_;
         bool                           bBuildStrataList_;
+
+        struct strata_slot
+        {
+            frame*       pFrame;
+            frame_strata mStrata;
+            int          iLevel;
+        };
+
+        std::map<uint, strata_slot> lStrataSlotList_;
+        std::vector<uint>           lStrataChangedList_;
+
         bool                           bObjectMoved_;
         frame*                         pOveredFrame_;
         bool                           bUpdateOveredFrame_;
@@ -845,6 +1004,7 @@ namespace gui
         uint uiFrameNumber_;
 
         bool bEnableCaching_;
+        bool bEnableLegacyScriptGlobals_;
 
         utils::refptr<render_target> pRenderTarget_;
         utils::refptr<sprite>        pSprite_;
@@ -892,12 +1052,36 @@ namespace gui
         /// Renders a set of quads.
         /** \param mQuad     The base quad to use for rendering (material, blending, ...)
         *   \param lQuadList The list of the quads you want to render
+        *   \param mOffset   The translation to apply to all the quads
         *   \note This function is meant to be called between begin() and
         *         end() only. It is always more efficient to call this method
         *         than calling render_quad repeatedly, as it allows to batch
         *         count reduction.
+        *   \note The translation allows rendering the same list of quads
+        *         at different positions, without modifying it.
+        */
+        virtual void render_quads(const quad& mQuad, const std::vector<std::array<vertex,4>>& lQuadList,
+            const vector2f& mOffset) const = 0;
+
+        /// Restricts rendering to an area of the current render target.
+        /** \param mArea The area in which rendering is allowed (in pixels)
+        *   \return 'false' if scissoring is not supported
+        *   \note This also applies to render_target::clear(). The scissor
+        *         area is reset by begin() and end().
+        *   \note If you don't override this function, scissoring is not
+        *         supported and the gui::manager will always redraw the
+        *         whole strata render targets.
+        */
+        virtual bool set_scissor(const quad2i& mArea) const;
+
+        /// Disables scissoring.
+        virtual void disable_scissor() const;
+
+        /// Updates the implementation.
+        /** \note Called by gui::manager at the beginning of each update,
+        *         before any frame is updated. Does nothing by default.
         */
-        virtual void render_quads(const quad& mQuad, const std::vector<std::array<vertex,4>>& lQuadList) const = 0;
+        virtual void update();
 
         /// Creates a new sprite.
         /** \param pMat The material with which to create the sprite
@@ -54,6 +54,14 @@ namespace gui
         *         power of two dimensions (the "physical" dimensions).
         */
         virtual float get_real_height() const = 0;
+
+        /// Checks if this material can be rendered.
+        /** \return 'true' if this material can be rendered
+        *   \note Some implementations of gui::manager_impl can load textures
+        *         in the background. Until then, the material has its final
+        *         dimensions, but is not rendered. Returns 'true' by default.
+        */
+        virtual bool is_ready() const;
     };
 }
 
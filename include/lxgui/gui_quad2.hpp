@@ -58,6 +58,47 @@ namespace gui
             return bottom - top;
         }
 
+        bool is_empty() const
+        {
+            return right <= left || bottom <= top;
+        }
+
+        bool overlaps(const quad2& mQuad) const
+        {
+            return left < mQuad.right && mQuad.left < right && top < mQuad.bottom && mQuad.top < bottom;
+        }
+
+        /// Grows this quad so that it also contains the provided one.
+        /** \param mQuad The quad to include (ignored if empty)
+        */
+        void extend(const quad2& mQuad)
+        {
+            if (mQuad.is_empty())
+                return;
+
+            if (is_empty())
+            {
+                *this = mQuad;
+                return;
+            }
+
+            if (mQuad.left   < left)   left   = mQuad.left;
+            if (mQuad.right  > right)  right  = mQuad.right;
+            if (mQuad.top    < top)    top    = mQuad.top;
+            if (mQuad.bottom > bottom) bottom = mQuad.bottom;
+        }
+
+        /// Shrinks this quad so that it is contained in the provided one.
+        /** \param mQuad The quad to clip against
+        */
+        void clip(const quad2& mQuad)
+        {
+            if (left   < mQuad.left)   left   = mQuad.left;
+            if (right  > mQuad.right)  right  = mQuad.right;
+            if (top    < mQuad.top)    top    = mQuad.top;
+            if (bottom > mQuad.bottom) bottom = mQuad.bottom;
+        }
+
         static const quad2 ZERO;
 
         T left, right, top, bottom;
@@ -34,6 +34,12 @@ namespace gui
         */
         virtual bool is_in_region(int iX, int iY) const;
 
+        /// Notifies this widget that its borders have been updated.
+        /** \note The region version of this function notifies the parent
+        *         frame, since its hit area can depend on its regions.
+        */
+        virtual void notify_borders_updated() const;
+
         /// Creates the associated Lua glue.
         virtual void create_glue();
 
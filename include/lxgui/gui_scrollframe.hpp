@@ -41,7 +41,7 @@ namespace gui
         /** \param sScriptName The name of the script
         *   \param pEvent      Stores scripts arguments
         */
-        virtual void on(const std::string& sScriptName, event* pEvent = nullptr);
+        virtual void on(const std::string& sScriptName, const event* pEvent = nullptr);
 
         /// Sets this scroll_frame's scroll child.
         /** \param pFrame The scroll child
@@ -96,6 +96,13 @@ namespace gui
         */
         virtual bool is_in_frame(int iX, int iY) const;
 
+        /// Returns the area of the screen in which this frame can be hovered.
+        /** \return The area of the screen in which this frame can be hovered
+        *   \note The scroll_frame version of this function includes the scroll
+        *         texture.
+        */
+        virtual quad2i get_hit_area() const;
+
         /// Tells this scroll_frame it is being overed by the mouse.
         /** \param bMouseInFrame 'true' if the mouse is above this scroll_frame
         *   \param iX            The horizontal mouse coordinate
@@ -109,8 +116,7 @@ namespace gui
         /// Tells this scroll_frame that at least one of its children has modified its strata or level.
         /** \param pChild The child that has changed its strata (can also be a child of this child)
         *   \note If pChild is the scroll child, it only rebuilds its internal strata list.
-        *   \note If this scroll_frame has no parent, it calls manager::fire_build_strata_list(). Else it
-        *         notifies its parent.
+        *         Else it notifies its parent, if any.
         */
         virtual void notify_child_strata_changed(frame* pChild);
 
@@ -163,6 +169,7 @@ namespace gui
         mutable bool                   bRebuildScrollStrataList_;
         std::map<uint, frame*>         lScrollChildList_;
         std::map<frame_strata, strata> lScrollStrataList_;
+        frame_grid                     mScrollFrameGrid_;
 
         bool   bMouseInScrollTexture_;
         frame* pOveredScrollChild_;
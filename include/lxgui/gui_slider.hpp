@@ -149,6 +149,13 @@ namespace gui
         */
         virtual bool is_in_frame(int iX, int iY) const;
 
+        /// Returns the area of the screen in which this frame can be hovered.
+        /** \return The area of the screen in which this frame can be hovered
+        *   \note The slider version of this function includes the thumb
+        *         texture.
+        */
+        virtual quad2i get_hit_area() const;
+
         /// Tells this frame it is being overed by the mouse.
         /** \param bMouseInFrame 'true' if the mouse is above this frame
         *   \param iX            The horizontal mouse coordinate
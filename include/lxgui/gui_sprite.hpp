@@ -44,6 +44,8 @@ namespace gui
 
     struct quad
     {
+        quad() : blend(BLEND_NORMAL) {}
+
         std::array<vertex, 4>   v;
         utils::refptr<material> mat;
         blend_mode              blend;
@@ -132,12 +134,14 @@ namespace gui
 
         /// Renders a set of quads using this sprite's material.
         /** \param lQuadsArray The set of quads you want to render.
+        *   \param mOffset     The translation to apply to all the quads
         *   \note It is always much more efficient to use this method
         *         rather than calling render_XXX() repeatedly, as it
         *         allows for batch count reduction. The actual improvement
         *         depends on implementation.
         */
-        virtual void render_quads(const std::vector<std::array<vertex,4>>& lQuadsArray) const;
+        virtual void render_quads(const std::vector<std::array<vertex,4>>& lQuadsArray,
+            const vector2f& mOffset = vector2f::ZERO) const;
 
         /// Sets this sprite's internal quad.
         /** \param lVertexArray The new quad
@@ -8,12 +8,14 @@
 #include <lxgui/utils_string.hpp>
 #include <lxgui/utils_refptr.hpp>
 #include <map>
+#include <vector>
 #include <array>
 
 namespace gui
 {
     class  manager;
     class  font;
+    class  material;
     class  sprite;
     struct vertex;
 
@@ -71,6 +73,51 @@ namespace gui
             bool   bNoRender;
         };
 
+        /// The lines and letters of a text, as computed by update().
+        /** \note Layouts are never modified once computed : texts that have
+        *         the same font, string and parameters share the same layout
+        *         (see text_layout_cache).
+        */
+        struct layout
+        {
+            layout() : fW(0.0f), fH(0.0f), fTop(0.0f), uiFontRevision(0u)
+            {}
+
+            std::vector<line>   lLineList;
+            std::vector<letter> lLetterCache;
+            std::vector<uint>   lLineStartList; // index of the first letter of each line
+            float               fW, fH;
+            float               fTop;           // vertical position of the first line
+            uint                uiFontRevision;
+        };
+
+        /// A copy of the text to draw with render_copies().
+        struct copy
+        {
+            copy() : mColor(color::EMPTY), bUseTextColor(true)
+            {}
+
+            /// Copy drawn with the colors of the text.
+            explicit copy(const vector2f& mOffset) :
+                mOffset(mOffset), mColor(color::EMPTY), bUseTextColor(true)
+            {}
+
+            /// Copy drawn with a single color.
+            copy(const vector2f& mOffset, const color& mColor) :
+                mOffset(mOffset), mColor(mColor), bUseTextColor(false)
+            {}
+
+            bool operator == (const copy& mCopy) const
+            {
+                return mOffset == mCopy.mOffset && mColor == mCopy.mColor &&
+                    bUseTextColor == mCopy.bUseTextColor;
+            }
+
+            vector2f mOffset;
+            color    mColor;
+            bool     bUseTextColor;
+        };
+
         /// Constructor.
         /** \param sFileName The path to the .ttf file to use
         *   \param fSize    The size of the font (in point)
@@ -104,6 +151,13 @@ namespace gui
         */
         void set_text(const std::string& sText);
 
+        /// Sets the text to render (unicode character set).
+        /** \param sText The text to render
+        *   \note See set_text(). Only the paragraphs that differ from the
+        *         previous text are wrapped again on the next update.
+        */
+        void set_unicode_text(const utils::ustring& sText);
+
         /// Returns the text that will be rendered.
         /** \return The text that will be rendered
         *   \note This string contains format tags.
@@ -186,6 +240,16 @@ namespace gui
         */
         float get_string_width(const utils::ustring& sString) const;
 
+        /// Returns the lenght of several strings.
+        /** \param lStringList The strings to measure
+        *   \param lWidthList  The list that will receive the lenghts
+        *                      (in the same order as lStringList)
+        *   \note Use this rather than calling get_string_width() for each
+        *         string when measuring many strings at once (the lines of
+        *         a tooltip or the entries of a list, for example).
+        */
+        void get_string_widths(const std::vector<utils::ustring>& lStringList, std::vector<float>& lWidthList) const;
+
         /// Returns the length of a single character.
         /** \param uiChar The character to measure
         *   \return The lenght of this character
@@ -292,6 +356,14 @@ namespace gui
         */
         void enable_formatting(bool bFormatting);
 
+        /// Enables sharing the layout of this text with identical texts.
+        /** \param bShare 'true' to use the manager's text_layout_cache
+        *   \note Enabled by default. Texts that are often modified, like
+        *         the content of an edit_box, should not be shared : they
+        *         would fill the cache with layouts that are never reused.
+        */
+        void enable_layout_sharing(bool bShare);
+
         /// Renders this text at the given position.
         /** \param fX The horizontal position of the top left corner
         *   \param fY The vertical position of the top left corner
@@ -300,6 +372,38 @@ namespace gui
         */
         void render(float fX, float fY);
 
+        /// Renders this text and its outline at the given position.
+        /** \param fX         The horizontal position of the top left corner
+        *   \param fY         The vertical position of the top left corner
+        *   \param fThickness The thickness of the outline (in pixels)
+        *   \return 'false' if the font does not support single pass outlines
+        *   \note The outline is rendered in black, with the alpha of this text's
+        *         color. If this function returns 'false', nothing is rendered.
+        *   \note Must be called between spriteManager::begin() and
+        *         spriteManager::end().
+        */
+        bool render_outlined(float fX, float fY, float fThickness);
+
+        /// Checks if this text can be rendered with render_outlined().
+        /** \param fThickness The thickness of the outline (in pixels)
+        *   \return 'true' if the font supports single pass outlines
+        */
+        bool is_outline_supported(float fThickness) const;
+
+        /// Renders several copies of this text in a single batch.
+        /** \param fX        The horizontal position of the top left corner
+        *   \param fY        The vertical position of the top left corner
+        *   \param lCopyList The copies to render, in order
+        *   \note Each copy is offset from the given position, and drawn with
+        *         its color (forced on all letters), or with the colors of
+        *         this text if copy::bUseTextColor is 'true'. This is used to render
+        *         shadows and outlines : the letter quads are only built once,
+        *         and the copies are only rebuilt when something changes.
+        *   \note Must be called between spriteManager::begin() and
+        *         spriteManager::end().
+        */
+        void render_copies(float fX, float fY, const std::vector<copy>& lCopyList);
+
         /// updates this text's cache.
         /** \note Automatically done by render().<br>
         *         Only use this method if you need it to
@@ -313,6 +417,31 @@ namespace gui
         */
         const std::vector<letter>& get_letter_cache();
 
+        /// Returns the line on which a letter is displayed.
+        /** \param uiIndex The index of the letter in the letter cache
+        *   
+eturn The index of the line (0 for the first one)
+        *   
+ote Letters are stored line after line : this is a binary
+        *         search in the list of lines.
+        */
+        uint get_letter_line(uint uiIndex);
+
+        /// Returns the letter that is displayed at a given position.
+        /** \param fX The horizontal position
+        *   \param fY The vertical position
+        *   
+eturn The index of the letter (in the letter cache) before
+        *           which a carret placed at this position would be drawn
+        *   
+ote The position is given in the same coordinates as the
+        *         letter quads (see get_letter_cache()). Within a line,
+        *         letters are laid out from left to right : the letter
+        *         quads form a sorted table of cumulative advances, in
+        *         which this function does a binary search.
+        */
+        uint get_letter_id_at(float fX, float fY);
+
         /// Creates a sprite that contains the provided character.
         /** \param uiChar The character to draw
         *   \note Uses this text's font texture.
@@ -321,8 +450,34 @@ namespace gui
 
     private :
 
-        void update_lines_();
-        void update_cache_();
+        /// The wrapped lines of a single paragraph (text between two '\n').
+        struct paragraph
+        {
+            paragraph() : uiLength(0), uiLetterCount(0), bTruncated(false), bWrapped(false) {}
+
+            std::vector<line>      lLineList;
+            std::map<uint, format> lFormatList;
+            uint                   uiLength;
+            uint                   uiLetterCount;
+            bool                   bTruncated;
+            bool                   bWrapped;
+        };
+
+        float get_line_width_(const char32_t* pChars, uint uiCount) const;
+        void  split_paragraphs_(uint& uiFirst, uint& uiOldLineCount, uint& uiNewCount);
+        void  update_lines_(layout& mLayout);
+        void  wrap_paragraph_(const utils::ustring& sText, paragraph& mParagraph) const;
+        float get_line_x_(const line& mLine) const;
+        void  update_layout_size_(layout& mLayout) const;
+        void  add_line_letters_(const line& mLine, float fY, uint& uiCounter, color& mColor,
+            std::vector<letter>& lLetterList);
+        void  update_cache_(layout& mLayout);
+        bool  update_edited_lines_();
+        void  add_letter_quads_(std::vector<letter>::const_iterator iterBegin,
+            std::vector<letter>::const_iterator iterEnd, std::vector<std::array<vertex,4>>& lQuadList) const;
+        void  update_quads_();
+        void  update_outline_quads_(float fThickness);
+        void  update_copy_quads_(const std::vector<copy>& lCopyList);
 
         manager* pManager_;
 
@@ -339,25 +494,50 @@ namespace gui
         color mColor_;
         bool  bForceColor_;
         bool  bFormattingEnabled_;
-        float fW_, fH_;
-        float fX_, fY_;
+        bool  bLayoutSharingEnabled_;
         float fBoxW_, fBoxH_;
 
-        std::string        sText_;
-        utils::ustring     sUnicodeText_;
-        alignment          mAlign_;
-        vertical_alignment mVertAlign_;
+        mutable std::string sText_;
+        mutable bool        bUpdateText_;
+        utils::ustring      sUnicodeText_;
+        alignment           mAlign_;
+        vertical_alignment  mVertAlign_;
 
-        std::vector<line>      lLineList_;
         std::map<uint, format> lFormatList_;
+        std::vector<paragraph> lParagraphList_;
+
+        // The part of sUnicodeText_ that has changed since the paragraphs
+        // were split : [uiEditStart_, size - uiEditTail_[
+        uint uiEditStart_;
+        uint uiEditTail_;
+
+        mutable std::vector<float> lWidthBuffer_;
+        mutable std::vector<float> lKerningBuffer_;
 
-        bool                bUpdateCache_;
-        std::vector<letter> lLetterCache_;
+        bool                        bUpdateCache_;
+        bool                        bRebuildLayout_;
+        bool                        bLayoutComplete_;
+        uint                        uiFontRevision_;
+        utils::refptr<const layout> pLayout_;
+        // Same as pLayout_ when it is not shared, and can thus be
+        // updated in place when only a few paragraphs are edited
+        utils::refptr<layout>       pEditableLayout_;
 
         bool                              bUpdateQuads_;
         std::vector<std::array<vertex,4>> lQuadList_;
+        std::vector<uint>                 lLineQuadStartList_;
         utils::refptr<sprite>             pSprite_;
 
+        bool                              bUpdateOutlineQuads_;
+        float                             fOutlineThickness_;
+        std::vector<std::array<vertex,4>> lOutlineQuadList_;
+        utils::refptr<material>           pOutlineMaterial_;
+        utils::refptr<sprite>             pOutlineSprite_;
+
+        bool                              bUpdateCopyQuads_;
+        std::vector<copy>                 lCopyList_;
+        std::vector<std::array<vertex,4>> lCopyQuadList_;
+
         utils::refptr<font> pFont_;
     };
 }
@@ -0,0 +1,149 @@
+#ifndef GUI_TEXTLAYOUTCACHE_HPP
+#define GUI_TEXTLAYOUTCACHE_HPP
+
+#include <lxgui/utils.hpp>
+#include "lxgui/gui_text.hpp"
+#include <lxgui/utils_refptr.hpp>
+#include <lxgui/utils_wptr.hpp>
+#include <lxgui/utils_string.hpp>
+#include <map>
+#include <list>
+
+namespace gui
+{
+    class font;
+
+    /// Stores the most recently used text layouts.
+    /** Laying out a text (word wrapping, alignment, letter positions)
+    *   only depends on its font, its string and a few parameters.
+    *   Texts with the same parameters can thus share the same layout,
+    *   which is computed once and never modified (see text::layout).
+    *   When the cache is full, the least recently used layout is removed.
+    *   \note The cache is bounded both by its number of layouts and by the
+    *         total number of letters they contain. Texts longer than
+    *         get_max_text_length() are never cached.
+    *   \note This cache is owned by the gui::manager.
+    */
+    class text_layout_cache
+    {
+    public :
+
+        /// Identifies a text layout.
+        struct key
+        {
+            key() : pFont(nullptr), fSize(0.0f), fBoxW(0.0f), fBoxH(0.0f), iAlign(0),
+                iVertAlign(0), fTracking(0.0f), fLineSpacing(0.0f), fSpaceWidth(0.0f), uiFlags(0u)
+            {}
+
+            bool operator < (const key& mKey) const;
+
+            const font*    pFont;
+            float          fSize;
+            float          fBoxW, fBoxH;
+            int            iAlign, iVertAlign;
+            float          fTracking;
+            float          fLineSpacing;
+            float          fSpaceWidth;
+            uint           uiFlags;
+            utils::ustring sText;
+        };
+
+        /// Constructor.
+        /** \param uiMaxSize        The maximum number of layouts to keep
+        *   \param uiMaxLetterCount The maximum total number of letters to keep
+        *   \param uiMaxTextLength  The maximum number of letters of a cached text
+        */
+        explicit text_layout_cache(uint uiMaxSize = 256u, uint uiMaxLetterCount = 16384u,
+            uint uiMaxTextLength = 512u);
+
+        /// Destructor.
+        ~text_layout_cache();
+
+        /// Sets the maximum number of layouts to keep.
+        /** \param uiMaxSize The maximum number of layouts to keep (0 to disable the cache)
+        */
+        void set_max_size(uint uiMaxSize);
+
+        /// Returns the maximum number of layouts to keep.
+        /** \return The maximum number of layouts to keep
+        */
+        uint get_max_size() const;
+
+        /// Returns the number of layouts in the cache.
+        /** \return The number of layouts in the cache
+        */
+        uint get_size() const;
+
+        /// Sets the maximum total number of letters to keep.
+        /** \param uiMaxLetterCount The maximum total number of letters to keep
+        *   \note Each layout stores its string and the position of each of
+        *         its letters : its memory footprint grows with its length.
+        */
+        void set_max_letter_count(uint uiMaxLetterCount);
+
+        /// Returns the maximum total number of letters to keep.
+        /** \return The maximum total number of letters to keep
+        */
+        uint get_max_letter_count() const;
+
+        /// Returns the total number of letters in the cache.
+        /** \return The total number of letters in the cache
+        */
+        uint get_letter_count() const;
+
+        /// Sets the maximum number of letters of a cached text.
+        /** \param uiMaxTextLength The maximum number of letters of a cached text
+        *   \note Longer texts are unlikely to be shared : they are not cached.
+        */
+        void set_max_text_length(uint uiMaxTextLength);
+
+        /// Returns the maximum number of letters of a cached text.
+        /** \return The maximum number of letters of a cached text
+        */
+        uint get_max_text_length() const;
+
+        /// Looks for a layout in the cache.
+        /** \param mKey           The parameters of the text
+        *   \param uiFontRevision The current texture revision of the font
+        *   \return The layout (nullptr if not found)
+        *   \note Layouts made for another revision of the font texture
+        *         are not valid anymore : they are removed.
+        */
+        utils::refptr<const text::layout> find(const key& mKey, uint uiFontRevision);
+
+        /// Adds a layout to the cache.
+        /** \param mKey    The parameters of the text
+        *   \param pFont   The font of the text
+        *   \param pLayout The layout
+        *   \note The font is not kept alive by the cache : if it is
+        *         destroyed, the layouts that use it are not used anymore.
+        *   \note Nothing is done if the text is longer than get_max_text_length().
+        */
+        void insert(const key& mKey, utils::wptr<font> pFont, utils::refptr<const text::layout> pLayout);
+
+        /// Removes all the layouts.
+        void clear();
+
+    private :
+
+        struct entry
+        {
+            utils::wptr<font>                 pFont;
+            utils::refptr<const text::layout> pLayout;
+            std::list<const key*>::iterator   iterLRU;
+        };
+
+        void remove_(std::map<key, entry>::iterator iter);
+        void remove_oldest_();
+
+        uint uiMaxSize_;
+        uint uiMaxLetterCount_;
+        uint uiMaxTextLength_;
+        uint uiLetterCount_;
+
+        std::map<key, entry>  lEntryList_;
+        std::list<const key*> lLRUList_;
+    };
+}
+
+#endif
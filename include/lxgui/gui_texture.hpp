@@ -40,6 +40,12 @@ namespace gui
         /// Renders this widget on the current render target.
         virtual void render();
 
+        /// updates this widget's logic.
+        /** \note Asks for a redraw when a texture that was loading
+        *         in the background becomes ready.
+        */
+        virtual void update(float fDelta);
+
         /// Copies an uiobject's parameters into this texture (inheritance).
         /** \param pObj The uiobject to copy
         */
@@ -223,9 +229,11 @@ namespace gui
         virtual void parse_attributes_(xml::block* pBlock);
         void parse_tex_coords_block_(xml::block* pBlock);
         void parse_gradient_block_(xml::block* pBlock);
+        void load_texture_file_();
 
         utils::refptr<sprite> pSprite_;
         std::string           sTextureFile_;
+        utils::wptr<material> pPendingMaterial_;
 
         blend_mode mBlendMode_;
         filter     mFilter_;
@@ -82,6 +82,21 @@ namespace gui
         /// Tells this widget to update its dimensions.
         void fire_update_dimensions() const;
 
+        /// Tells this widget that it needs to be updated.
+        /** \note Widgets are only updated when they (or one of their
+        *         children) need it : this also flags all the parents
+        *         of this widget. Widgets that have work to do on each
+        *         update (OnUpdate script, animation, ...) must call this
+        *         function again at the end of update().
+        */
+        void fire_update() const;
+
+        /// Checks if this widget needs to be updated.
+        /** \return 'true' if this widget needs to be updated
+        *   \note See fire_update().
+        */
+        bool is_update_needed() const;
+
         /// Returns this widget's name.
         /** \return This widget's name
         */
@@ -466,6 +481,12 @@ namespace gui
         */
         virtual void notify_renderer_need_redraw() const;
 
+        /// Notifies this widget that its borders have been updated.
+        /** \note Automatically called by update_borders_(). Does
+        *         nothing by default.
+        */
+        virtual void notify_borders_updated() const;
+
         /// Tells this widget that a manually rendered widget requires redraw.
         /** \note This function does nothing by default.
         */
@@ -540,6 +561,7 @@ namespace gui
         void         make_borders_(float& iMin, float& iMax, float iCenter, float iSize) const;
         virtual void update_borders_() const;
         virtual void update_dimensions_() const;
+        void         fire_update_anchors_();
 
         virtual void notify_manually_rendered_object_(uiobject* pObject, bool bManuallyRendered);
 
@@ -585,6 +607,7 @@ namespace gui
         mutable bool bUpdateAnchors_;
         mutable bool bUpdateBorders_;
         mutable bool bUpdateDimensions_;
+        mutable bool bUpdateNeeded_;
 
         mutable std::map<uint, uiobject*> lAnchoredObjectList_;
     };
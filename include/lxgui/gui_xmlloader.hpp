@@ -0,0 +1,97 @@
+#ifndef GUI_XMLLOADER_HPP
+#define GUI_XMLLOADER_HPP
+
+#include <lxgui/utils.hpp>
+#include <lxgui/utils_refptr.hpp>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace xml
+{
+    class definition;
+    class document;
+}
+
+namespace gui
+{
+    /// Parses XML files in the background.
+    /** Parsing XML files does not depend on the Lua state nor on
+    *   the widgets : the files of all addons can thus be parsed by
+    *   a pool of threads, while the main thread executes Lua files
+    *   and creates widgets in the proper order.
+    *   \note Errors and warnings of each file are buffered, and written
+    *         to gui::out when the file is loaded, so that the log stays
+    *         in the same order as when parsing files one after the other.
+    *   \note The threads are hidden in the implementation file, so that
+    *         this header does not require the C++11 thread library.
+    */
+    class xml_loader
+    {
+    public :
+
+        /// Constructor.
+        xml_loader();
+
+        /// Destructor.
+        ~xml_loader();
+
+        /// Sets the definition file to use to parse XML files.
+        /** \param pDefinition The definition
+        */
+        void set_definition(utils::refptr<xml::definition> pDefinition);
+
+        /// Sets the directory where compiled layout files are stored.
+        /** \param sDirectory The directory (empty to disable compiled layouts)
+        *   \note See manager::set_layout_cache_directory().
+        */
+        void set_cache_directory(const std::string& sDirectory);
+
+        /// Adds a file to be parsed in the background.
+        /** \param sFile The path to the XML file
+        *   \note Files must be added before calling start().
+        */
+        void add_file(const std::string& sFile);
+
+        /// Starts parsing the files that have been added.
+        /** \param uiThreadCount The number of threads to use
+        *   \note If uiThreadCount is zero, files are only parsed when
+        *         calling load_file().
+        */
+        void start(uint uiThreadCount);
+
+        /// Returns a parsed XML file.
+        /** \param sFile  The path to the XML file
+        *   \param bValid Set to 'true' if the file has been parsed successfully
+        *   \return The parsed document
+        *   \note If the file is being parsed in the background, this function
+        *         waits until it is done. If it has not been added with
+        *         add_file(), it is parsed immediately.
+        */
+        utils::refptr<xml::document> load_file(const std::string& sFile, bool& bValid);
+
+        /// Stops the threads and forgets about all the files.
+        void clear();
+
+    private :
+
+        xml_loader(const xml_loader& mLoader);
+        xml_loader& operator = (const xml_loader& mLoader);
+
+        struct file;
+        struct thread_pool;
+
+        bool parse_(xml::document& mDocument, const std::string& sFile) const;
+        void run_thread_();
+
+        utils::refptr<xml::definition> pDefinition_;
+        std::string                    sCacheDirectory_;
+
+        std::map<std::string, utils::refptr<file>> lFileList_;
+        std::vector<file*>                         lQueue_;
+
+        thread_pool* pPool_;
+    };
+}
+
+#endif
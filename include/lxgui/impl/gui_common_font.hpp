@@ -0,0 +1,167 @@
+#ifndef GUI_COMMON_FONT_HPP
+#define GUI_COMMON_FONT_HPP
+
+#include <lxgui/utils.hpp>
+#include <lxgui/gui_font.hpp>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <array>
+
+struct FT_SizeRec_;
+
+namespace gui {
+namespace common
+{
+    class font_face;
+
+    struct character_info
+    {
+        uint   uiCodePoint;
+        uint   uiGlyphIndex;
+        quad2i mRect;
+    };
+
+    /// A texture containing characters rendered by FreeType
+    /** This is the part of the gui::font that is shared by the
+    *   implementations : it uses the freetype library to read data
+    *   from .ttf and .otf files and to render the characters on the
+    *   font texture, which is provided by the implementation (see
+    *   create_texture_(), resize_texture_(), set_texture_alpha_() and
+    *   update_texture_()).
+    *   \note Characters are rendered the first time they are needed,
+    *         and packed in rows on the font texture, which grows when
+    *         it is full. Any unicode character can thus be displayed,
+    *         and only the characters that are used take texture memory.
+    *         Kerning amounts are also read on first use.
+    *   \note In distance field mode, the texture stores, for each texel, the
+    *         distance to the closest edge of the character instead of its
+    *         coverage.
+    */
+    class font : public gui::font
+    {
+    public :
+
+        /// Constructor.
+        /** \param pFace The font face to use (can be shared with other fonts)
+        *   \note The implementation must call init_() in its constructor.
+        */
+        explicit font(utils::refptr<font_face> pFace);
+
+        /// Destructor.
+        virtual ~font();
+
+        /// Returns the uv coordinates of a character on the texture.
+        /** \param uiChar The unicode character
+        *   \return The uv coordinates of this character on the texture
+        *   \note The uv coordinates are normalisez, i.e. they range from
+        *         0 to 1. They are arranged as {u1, v1, u2, v2}.
+        */
+        quad2f get_character_uvs(char32_t uiChar) const;
+
+        /// Returns the width of a character in pixels.
+        /** \param uiChar The unicode character
+        *   \return The width of the character in pixels.
+        */
+        float get_character_width(char32_t uiChar) const;
+
+        /// Return the kerning amount between two characters.
+        /** \param uiChar1 The first unicode character
+        *   \param uiChar2 The second unicode character
+        *   \return The kerning amount between the two characters
+        *   \note Kerning is a font rendering adjustment that makes some
+        *         letters closer, for example in 'VA', there is room for
+        *         the two to be closer than with 'VW'. This has no effect
+        *         for fixed width fonts (like Courrier, etc).
+        */
+        float get_character_kerning(char32_t uiChar1, char32_t uiChar2) const;
+
+        /// Returns the width of several characters in pixels.
+        /** \param pChars  The unicode characters
+        *   \param uiCount The number of characters
+        *   \param pWidths The array to fill (uiCount values)
+        */
+        void get_character_widths(const char32_t* pChars, uint uiCount, float* pWidths) const;
+
+        /// Returns the kerning amounts between consecutive characters.
+        /** \param pChars    The unicode characters
+        *   \param uiCount   The number of characters
+        *   \param pKernings The array to fill (uiCount-1 values)
+        */
+        void get_character_kernings(const char32_t* pChars, uint uiCount, float* pKernings) const;
+
+        /// Returns a number that changes when the font texture is resized.
+        /** \return A number that changes when the font texture is resized
+        *   \note The texture grows when new characters do not fit anymore.
+        */
+        uint get_texture_revision() const;
+
+    protected :
+
+        /// Opens the font at the given size and creates the texture.
+        /** \param uiSize         The requested size in pixels of the font
+        *   \param bDistanceField 'true' to render characters as distance fields
+        */
+        void init_(uint uiSize, bool bDistanceField);
+
+        /// Creates the font texture, filled with transparent pixels.
+        /** \param uiWidth  The width of the texture
+        *   \param uiHeight The height of the texture
+        */
+        virtual void create_texture_(uint uiWidth, uint uiHeight) = 0;
+
+        /// Resizes the font texture, keeping its content in the top left corner.
+        /** \param uiWidth  The new width of the texture
+        *   \param uiHeight The new height of the texture
+        *   \return 'false' if the texture cannot be that large
+        */
+        virtual bool resize_texture_(uint uiWidth, uint uiHeight) const = 0;
+
+        /// Writes the coverage (or the distance field) of one texel.
+        /** \param x       The horizontal coordinate of the texel
+        *   \param y       The vertical coordinate of the texel
+        *   \param ucAlpha The coverage (or the distance field) of this texel
+        */
+        virtual void set_texture_alpha_(uint x, uint y, uchar ucAlpha) const = 0;
+
+        /// Notifies the implementation that a part of the texture has been written.
+        /** \param mRect The area that has been written, in texels
+        */
+        virtual void update_texture_(const quad2i& mRect) const = 0;
+
+        utils::refptr<font_face> pFace_;
+
+        bool bDistanceField_;
+        uint uiPadding_;
+
+        mutable uint uiTextureWidth_;
+        mutable uint uiTextureHeight_;
+        mutable uint uiTextureRevision_;
+
+    private :
+
+        const character_info& get_character_(char32_t uiChar) const;
+        bool                  load_character_(character_info& mCI) const;
+        void                  write_distance_field_(const std::vector<float>& lCoverage,
+                                  uint uiWidth, uint uiHeight, const quad2i& mRect) const;
+        bool                  pack_character_(uint uiWidth, quad2i& mRect) const;
+        bool                  grow_texture_() const;
+
+        FT_SizeRec_* pSize_;
+
+        uint uiSpacing_;
+        uint uiMaxHeight_;
+        int  iMaxBearingY_;
+
+        mutable std::vector<uint> lRowList_;
+
+        mutable std::unordered_map<char32_t, character_info>  lCharacterList_;
+        mutable std::array<const character_info*, 256>        lCharacterTable_;
+        mutable std::unordered_map<unsigned long long, float> lKerningList_;
+
+        bool bKerning_;
+    };
+}
+}
+
+#endif
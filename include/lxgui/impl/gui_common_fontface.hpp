@@ -0,0 +1,53 @@
+#ifndef GUI_COMMON_FONTFACE_HPP
+#define GUI_COMMON_FONTFACE_HPP
+
+#include <lxgui/utils.hpp>
+#include <string>
+
+struct FT_FaceRec_;
+
+namespace gui {
+namespace common
+{
+    /// A font file opened by FreeType
+    /** A face can be shared by several fonts, which only differ
+    *   by their size : the font file is only opened and parsed once.
+    *   All the faces use the same FreeType library instance, which
+    *   is created with the first face and released with the last one.
+    */
+    class font_face
+    {
+    public :
+
+        /// Constructor.
+        /** \param sFontFile The name of the font file to read
+        */
+        explicit font_face(const std::string& sFontFile);
+
+        /// Destructor.
+        ~font_face();
+
+        /// Returns the name of the font file.
+        /** \return The name of the font file
+        */
+        const std::string& get_file() const;
+
+        /// Returns the FreeType face.
+        /** \return The FreeType face
+        *   \note Each font must create its own FT_Size on this face,
+        *         and activate it before using the face.
+        */
+        FT_FaceRec_* get_face() const;
+
+    private :
+
+        font_face(const font_face& mFace);
+        font_face& operator = (const font_face& mFace);
+
+        std::string  sFontFile_;
+        FT_FaceRec_* pFace_;
+    };
+}
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef GUI_COMMON_PNG_HPP
+#define GUI_COMMON_PNG_HPP
+
+#include <lxgui/utils.hpp>
+#include <iosfwd>
+
+namespace gui {
+namespace common
+{
+    /// Reads the signature at the beginning of a PNG file.
+    /** \param mFile The file to read
+    *   \return 'true' if the file is a PNG file
+    */
+    bool check_png_signature(std::ifstream& mFile);
+
+    /// Reads a PNG file with libpng
+    /** The file is read in two steps : the header first (see read_header()),
+    *   then the pixels (see read_image()), so that the texture can be created
+    *   before the image is decoded. The signature must have been read already
+    *   (see check_png_signature()).
+    */
+    class png_reader
+    {
+    public :
+
+        /// Constructor.
+        /** \param mFile The file to read (must stay open while reading)
+        */
+        explicit png_reader(std::ifstream& mFile);
+
+        /// Destructor.
+        ~png_reader();
+
+        /// Reads the header of the image.
+        /** \note Throws an utils::exception if the image is not supported.
+        */
+        void read_header();
+
+        /// Reads the pixels of the image.
+        /** \param pData The buffer to fill (get_width()*get_height() RGBA pixels)
+        *   \note Throws an utils::exception if the image is corrupted.
+        */
+        void read_image(uchar* pData);
+
+        /// Returns the width of the image.
+        /** \return The width of the image
+        *   \note Only available after read_header() has been called.
+        */
+        uint get_width() const;
+
+        /// Returns the height of the image.
+        /** \return The height of the image
+        *   \note Only available after read_header() has been called.
+        */
+        uint get_height() const;
+
+    private :
+
+        png_reader(const png_reader& mReader);
+        png_reader& operator = (const png_reader& mReader);
+
+        struct png_data;
+
+        png_data* pData_;
+        uint      uiWidth_, uiHeight_;
+    };
+}
+}
+
+#endif
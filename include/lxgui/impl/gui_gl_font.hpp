@@ -2,78 +2,94 @@
 #define GUI_GL_FONT_HPP
 
 #include <lxgui/utils.hpp>
-#include <lxgui/gui_font.hpp>
-#include <vector>
+#include "lxgui/impl/gui_common_font.hpp"
+#include <string>
+#include <map>
 
 namespace gui {
 namespace gl
 {
     class material;
-
-    struct character_info
-    {
-        uint                  uiCodePoint;
-        quad2f                mUVs;
-        std::vector<vector2f> lKerningInfo;
-    };
+    class manager;
 
     /// A texture containing characters
     /** This is the OpenGL implementation of the gui::font.
-    *   It uses the freetype library to read data from .ttf and
-    *   .otf files and to render the characters on the font texture.
+    *   The characters are rendered by common::font, on demand,
+    *   and uploaded to an OpenGL texture.
+    *   \note In distance field mode, the texture stores, for each texel, the
+    *         distance to the closest edge of the character instead of its
+    *         coverage. Such a font can be scaled to any size (see scaled_font),
+    *         and outlined in a single pass (see get_outline_texture()).
     */
-    class font : public gui::font
+    class font : public common::font
     {
     public :
 
         /// Constructor.
-        /** \param sFontFile The name of the font file to read
-        *   \param uiSize    The requested size in pixels of the font
+        /** \param sFontFile      The name of the font file to read
+        *   \param uiSize         The requested size in pixels of the font
+        *   \param bDistanceField 'true' to render characters as distance fields
         */
-        font(const std::string& sFontFile, uint uiSize);
+        font(const std::string& sFontFile, uint uiSize, bool bDistanceField = false);
+
+        /// Constructor.
+        /** \param pFace          The font face to use (can be shared with other fonts)
+        *   \param uiSize         The requested size in pixels of the font
+        *   \param bDistanceField 'true' to render characters as distance fields
+        */
+        font(utils::refptr<common::font_face> pFace, uint uiSize, bool bDistanceField = false);
 
         /// Destructor.
         ~font();
 
-        /// Returns the uv coordinates of a character on the texture.
-        /** \param uiChar The unicode character
-        *   \return The uv coordinates of this character on the texture
-        *   \note The uv coordinates are normalisez, i.e. they range from
-        *         0 to 1. They are arranged as {u1, v1, u2, v2}.
-        */
-        quad2f get_character_uvs(char32_t uiChar) const;
-
-        /// Returns the width of a character in pixels.
-        /** \param uiChar The unicode character
-        *   \return The width of the character in pixels.
-        */
-        float get_character_width(char32_t uiChar) const;
-
-        /// Return the kerning amount between two characters.
-        /** \param uiChar1 The first unicode character
-        *   \param uiChar2 The second unicode character
-        *   \return The kerning amount between the two characters
-        *   \note Kerning is a font rendering adjustment that makes some
-        *         letters closer, for example in 'VA', there is room for
-        *         the two to be closer than with 'VW'. This has no effect
-        *         for fixed width fonts (like Courrier, etc).
+        /// Sets the manager that renders this font.
+        /** \param pManager The manager (can be nullptr)
+        *   \note When the font texture grows, the quads that this manager
+        *         has batched so far are rendered first, since their texture
+        *         coordinates are only valid for the previous texture size.
         */
-        float get_character_kerning(char32_t uiChar1, char32_t uiChar2) const;
+        void set_manager(const gl::manager* pManager);
 
         /// Returns the underlying material to use for rendering.
         /** \return The underlying material to use for rendering
         */
         utils::wptr<gui::material> get_texture() const;
 
+        /// Returns the material to use to render outlined characters.
+        /** \param fThickness The thickness of the outline (in pixels)
+        *   \return The material to use to render outlined characters
+        *           (nullptr if this font is not a distance field)
+        *   \note The material shares the texture of this font. The outline
+        *         cannot be thicker than get_distance_field_spread().
+        */
+        utils::wptr<gui::material> get_outline_texture(float fThickness) const;
+
+        /// Checks if this font is rendered as a distance field.
+        /** \return 'true' if this font is rendered as a distance field
+        */
+        bool is_distance_field() const;
+
+        /// Returns the maximum distance stored in the distance field (in pixels).
+        /** \return The maximum distance stored in the distance field
+        *   \note Zero if this font is not a distance field. Characters are
+        *         surrounded by this amount of free pixels on the texture.
+        */
+        uint get_distance_field_spread() const;
+
+    protected :
+
+        void create_texture_(uint uiWidth, uint uiHeight);
+        bool resize_texture_(uint uiWidth, uint uiHeight) const;
+        void set_texture_alpha_(uint x, uint y, uchar ucAlpha) const;
+        void update_texture_(const quad2i& mRect) const;
+
     private :
 
-        float fTextureWidth_;
-        float fTextureHeight_;
+        const gl::manager* pManager_;
 
-        utils::refptr<gl::material> pTexture_;
-        std::vector<character_info> lCharacterList_;
+        mutable utils::refptr<gl::material> pTexture_;
 
-        bool bKerning_;
+        mutable std::map<float, utils::refptr<gl::material>> lOutlineTextureList_;
     };
 }
 }
@@ -3,16 +3,27 @@
 
 #include <lxgui/utils.hpp>
 #include <lxgui/gui_manager.hpp>
+#include <lxgui/gui_sprite.hpp>
 #include "lxgui/impl/gui_gl_matrix4.hpp"
 
+#include <deque>
+
 namespace gui {
+namespace common
+{
+    class font_face;
+}
+
 namespace gl
 {
     class render_target;
+    class material;
+    class font;
 
     /// Abstract type for implementation specific management
     class manager : public gui::manager_impl
     {
+    friend font;
     public :
 
         /// Constructor.
@@ -23,10 +34,16 @@ namespace gl
 
         /// Begins rendering on a particular render target.
         /** \param pTarget The render target (main screen if nullptr)
+        *   \note Starts a new batch : quads are not sent to the GPU until
+        *         end() is called.
         */
         void begin(utils::refptr<gui::render_target> pTarget = nullptr) const;
 
         /// Ends rendering.
+        /** \note Flushes the current batch : all the quads rendered since
+        *         begin() are uploaded in a single vertex buffer, and drawn
+        *         with one draw call per material/blend mode change.
+        */
         void end() const;
 
         /// Renders a quad.
@@ -39,12 +56,101 @@ namespace gl
         /// Renders a set of quads.
         /** \param mQuad     The base quad to use for rendering (material, blending, ...)
         *   \param lQuadList The list of the quads you want to render
+        *   \param mOffset   The translation to apply to all the quads
         *   \note This function is meant to be called between begin() and
         *         end() only. It is always more efficient to call this method
         *         than calling render_quad repeatedly, as it allows to batch
         *         count reduction.
+        *   \note The translation is applied while copying the vertices to
+        *         the batch, so it costs nothing more.
+        */
+        virtual void render_quads(const quad& mQuad, const std::vector<std::array<vertex,4>>& lQuadList,
+            const vector2f& mOffset) const;
+
+        /// Restricts rendering to an area of the current render target.
+        /** \param mArea The area in which rendering is allowed (in pixels)
+        *   \return Always 'true' (uses glScissor)
+        *   \note Flushes the current batch.
+        */
+        bool set_scissor(const quad2i& mArea) const;
+
+        /// Disables scissoring.
+        /** \note Flushes the current batch.
+        */
+        void disable_scissor() const;
+
+        /// Enables/disables quad batching.
+        /** \param bEnable 'true' to enable batching
+        *   \note Enabled by default. When disabled, each call to render_quad()
+        *         or render_quads() issues its own draw call.
+        */
+        void enable_batching(bool bEnable);
+
+        /// Checks if quad batching is enabled.
+        /** \return 'true' if quad batching is enabled
+        */
+        bool is_batching_enabled() const;
+
+        /// Returns the number of draw calls issued during the last batch.
+        /** \return The number of draw calls issued during the last batch
+        *   \note Useful to check how well the UI batches.
+        */
+        uint get_batch_count() const;
+
+        /// Enables/disables asynchronous texture loading.
+        /** \param bEnable 'true' to load textures in the background
+        *   \note Disabled by default. When enabled, create_material() only
+        *         reads the header of the texture file, and returns a material
+        *         that has its final dimensions but is not rendered until it is
+        *         ready (see gui::material::is_ready()). The pixels are decoded
+        *         by worker threads, and sent to the GPU by update().
+        *   \note Disabling asynchronous loading waits for all the pending
+        *         textures to be decoded, and uploads them immediately.
+        *   \note Without thread support (NO_CPP11_THREADS), the pixels are
+        *         decoded immediately, but still uploaded by update().
+        */
+        void enable_async_loading(bool bEnable);
+
+        /// Checks if asynchronous texture loading is enabled.
+        /** \return 'true' if asynchronous texture loading is enabled
+        */
+        bool is_async_loading_enabled() const;
+
+        /// Sets the maximum amount of texture data to send to the GPU per update.
+        /** \param uiBytes The maximum number of bytes to upload per update
+        *   \note At least one texture is uploaded per update, even if it is
+        *         larger than this budget. Default is 4 MB.
         */
-        virtual void render_quads(const quad& mQuad, const std::vector<std::array<vertex,4>>& lQuadList) const;
+        void set_texture_upload_budget(uint uiBytes);
+
+        /// Returns the maximum amount of texture data to send to the GPU per update.
+        /** \return The maximum number of bytes to upload per update
+        */
+        uint get_texture_upload_budget() const;
+
+        /// Uploads the textures that have been decoded in the background.
+        /** \note Automatically called by gui::manager::update(). Uploads
+        *         textures in the order they were requested, until the
+        *         upload budget is spent (see set_texture_upload_budget()).
+        */
+        void update();
+
+        /// Enables/disables distance field fonts.
+        /** \param bEnable 'true' to use distance field fonts
+        *   \note Disabled by default. When enabled, create_font() renders
+        *         each font file once, as a distance field, and all the
+        *         sizes of this font share the same texture. Outlines are
+        *         then rendered in a single pass (see gui::text::render_outlined()).
+        *   \note Distance fields need shaders (OpenGL 2.0) : if they are not supported
+        *         by the graphics card, this function has no effect.
+        *   \note Only affects fonts created after this call.
+        */
+        void enable_distance_field_fonts(bool bEnable);
+
+        /// Checks if distance field fonts are enabled.
+        /** \return 'true' if distance field fonts are enabled
+        */
+        bool is_distance_field_fonts_enabled() const;
 
         /// Creates a new material from a texture file.
         /** \param sFileName The name of the file
@@ -77,6 +183,10 @@ namespace gl
         *   \param uiSize    The requested size of the characters (in points)
         *   \note This implementation uses FreeType to load vector fonts and rasterize them.
         *         Bitmap fonts are not yet supported.
+        *   \note The font file is only opened once : fonts of different sizes
+        *         created from the same file share the same font_face.
+        *   \note If distance field fonts are enabled, the characters are only
+        *         rendered once per font file (see enable_distance_field_fonts()).
         */
         utils::refptr<gui::font> create_font(const std::string& sFontFile, uint uiSize) const;
 
@@ -87,17 +197,84 @@ namespace gl
 
     private :
 
+        manager(const manager& mMgr);
+        manager& operator = (const manager& mMgr);
+
+        /// Interleaved vertex, as sent to the GPU.
+        struct batch_vertex
+        {
+            float x, y;
+            float u, v;
+            float r, g, b, a;
+        };
+
+        /// A range of vertices sharing the same material and blend mode.
+        struct batch
+        {
+            utils::refptr<gl::material> pMaterial;
+            blend_mode                  mBlend;
+            uint                        uiFirst;
+            uint                        uiCount;
+        };
+
         void update_view_matrix_() const;
+
+        void add_quad_(const quad& mQuad, const std::array<vertex,4>& lVertexList, const vector2f& mOffset) const;
+        batch& get_batch_(const quad& mQuad) const;
+        void flush_batches_() const;
 
+        void create_distance_field_program_();
+        void use_material_program_(const gl::material& mMat) const;
+
+        /// A texture that is being loaded in the background.
+        struct texture_job
+        {
+            utils::refptr<gl::material> pMaterial;
+            gl::material*               pTexture;
+            std::string                 sFileName;
+            std::string                 sError;
+            bool                        bDone;
+        };
+
         utils::refptr<gui::material> create_material_png(const std::string& sFileName, filter mFilter) const;
+        void decode_png_(texture_job& mJob) const;
+
+        /// The threads that decode textures (see gui_gl_manager.cpp).
+        struct decoder;
+
+        void start_decoding_threads_();
+        void stop_decoding_threads_();
+        void run_decoding_thread_() const;
+        void queue_texture_job_(texture_job& mJob) const;
+        bool is_texture_job_done_(const texture_job& mJob) const;
+        void upload_texture_(texture_job& mJob) const;
 
         mutable std::map<std::string, utils::wptr<gui::material>> lTextureList_;
         mutable std::map<std::string, utils::wptr<gui::font>>     lFontList_;
+        mutable std::map<std::string, utils::wptr<common::font_face>> lFontFaceList_;
+        mutable std::map<std::string, utils::wptr<gl::font>>      lDistanceFieldFontList_;
 
         mutable bool    bUpdateViewMatrix_;
         mutable matrix4 mViewMatrix_;
 
         mutable utils::refptr<gui::gl::render_target> pCurrentTarget_;
+
+        bool                              bBatching_;
+        bool                              bVBOSupported_;
+        uint                              uiVBOHandle_;
+        mutable uint                      uiBatchCount_;
+        mutable std::vector<batch_vertex> lBatchVertexList_;
+        mutable std::vector<batch>        lBatchList_;
+
+        bool         bDistanceFieldFonts_;
+        uint         uiDistanceFieldProgram_;
+        int          iOutlineLocation_;
+        mutable bool bProgramActive_;
+
+        bool                                            bAsyncLoading_;
+        uint                                            uiUploadBudget_;
+        mutable std::deque<utils::refptr<texture_job>> lTextureJobList_;
+        decoder*                                        pDecoder_;
     };
 }
 }
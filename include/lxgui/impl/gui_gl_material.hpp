@@ -60,6 +60,13 @@ namespace gl
         */
         material(const color& mColor);
 
+        /// Constructor for textures sharing the pixels of another material.
+        /** \param pBase The material that holds the texture
+        *   \note Both materials use the same OpenGL texture, but can be
+        *         rendered with different settings (see set_distance_field()).
+        */
+        explicit material(utils::refptr<material> pBase);
+
         /// Destructor.
         ~material();
 
@@ -98,6 +105,13 @@ namespace gl
         */
         float get_real_height() const;
 
+        /// Checks if this material can be rendered.
+        /** \return 'true' if this material can be rendered
+        *   \note Textures loaded asynchronously by the gui::gl::manager
+        *         are not ready until their pixels have been uploaded.
+        */
+        bool is_ready() const;
+
         /// Resizes this texture.
         /** \param uiWidth  The new texture width
         *   \param uiHeight The new texture height
@@ -128,6 +142,28 @@ namespace gl
         */
         void set_filter(filter mFilter);
 
+        /// Flags the alpha channel of this texture as a distance field.
+        /** \param bDistanceField 'true' if the alpha channel stores a distance field
+        *   \param fOutline       The width of the outline to draw around shapes
+        *   \note In a distance field, alpha is 0.5 on the edges of the shapes,
+        *         and goes to 1 inside and to 0 outside. Such textures are rendered
+        *         with a shader that keeps edges sharp at any scale.
+        *   \note The outline is drawn in black, with the alpha of the vertex
+        *         color. Its width is given in alpha units : shapes are extended
+        *         down to an alpha of 0.5 - fOutline.
+        */
+        void set_distance_field(bool bDistanceField, float fOutline = 0.0f);
+
+        /// Checks if the alpha channel of this texture is a distance field.
+        /** \return 'true' if the alpha channel of this texture is a distance field
+        */
+        bool is_distance_field() const;
+
+        /// Returns the width of the outline drawn around distance field shapes.
+        /** \return The width of the outline drawn around distance field shapes
+        */
+        float get_distance_field_outline() const;
+
         /// Sets this material as the active one.
         void bind() const;
 
@@ -178,11 +214,27 @@ namespace gl
         */
         void update_texture();
 
+        /// Updates a part of the texture that is in GPU memory.
+        /** \param uiX      The horizontal position of the part to update
+        *   \param uiY      The vertical position of the part to update
+        *   \param uiWidth  The width of the part to update
+        *   \param uiHeight The height of the part to update
+        *   \note Faster than update_texture() when only a few pixels
+        *         have changed.
+        */
+        void update_texture(uint uiX, uint uiY, uint uiWidth, uint uiHeight);
+
         /// Removes the cached texture data (in CPU memory).
         /** \note For internal use.
         */
         void clear_cache_data_();
 
+        /// Flags this texture as ready to be rendered or not.
+        /** \param bReady 'true' if the texture can be rendered
+        *   \note For internal use.
+        */
+        void set_ready_(bool bReady);
+
         /// Returns the OpenGL texture handle.
         /** \note For internal use.
         */
@@ -207,6 +259,7 @@ namespace gl
             wrap   mWrap_;
             filter mFilter_;
             uint   uiTextureHandle_;
+            bool   bReady_;
 
             std::vector<ub32color> pData_;
         };
@@ -221,6 +274,9 @@ namespace gl
         utils::refptr<texture_data> pTexData_;
         utils::refptr<color_data>   pColData_;
 
+        bool  bDistanceField_;
+        float fOutline_;
+
         static bool ONLY_POWER_OF_TWO;
         static uint MAXIMUM_SIZE;
     };
@@ -0,0 +1,97 @@
+#ifndef GUI_GL_SCALEDFONT_HPP
+#define GUI_GL_SCALEDFONT_HPP
+
+#include <lxgui/utils.hpp>
+#include <lxgui/gui_font.hpp>
+#include <lxgui/utils_refptr.hpp>
+
+namespace gui {
+namespace gl
+{
+    class font;
+
+    /// A distance field font displayed at another size
+    /** All the sizes of a font file can share the same distance field
+    *   texture : this class forwards the texture and uv coordinates of
+    *   the base gl::font, and scales all its metrics.
+    */
+    class scaled_font : public gui::font
+    {
+    public :
+
+        /// Constructor.
+        /** \param pFont      The distance field font to scale
+        *   \param uiSize     The requested size in pixels of the font
+        *   \param uiBaseSize The size in pixels of pFont
+        */
+        scaled_font(utils::refptr<gl::font> pFont, uint uiSize, uint uiBaseSize);
+
+        /// Destructor.
+        ~scaled_font();
+
+        /// Returns the uv coordinates of a character on the texture.
+        /** \param uiChar The unicode character
+        *   \return The uv coordinates of this character on the texture
+        *   \note The uv coordinates are normalisez, i.e. they range from
+        *         0 to 1. They are arranged as {u1, v1, u2, v2}.
+        */
+        quad2f get_character_uvs(char32_t uiChar) const;
+
+        /// Returns the width of a character in pixels.
+        /** \param uiChar The unicode character
+        *   \return The width of the character in pixels.
+        */
+        float get_character_width(char32_t uiChar) const;
+
+        /// Returns the height of a character in pixels.
+        /** \param uiChar The unicode character
+        *   \return The height of the character in pixels.
+        */
+        float get_character_height(char32_t uiChar) const;
+
+        /// Return the kerning amount between two characters.
+        /** \param uiChar1 The first unicode character
+        *   \param uiChar2 The second unicode character
+        *   \return The kerning amount between the two characters
+        */
+        float get_character_kerning(char32_t uiChar1, char32_t uiChar2) const;
+
+        /// Returns the width of several characters in pixels.
+        /** \param pChars  The unicode characters
+        *   \param uiCount The number of characters
+        *   \param pWidths The array to fill (uiCount values)
+        */
+        void get_character_widths(const char32_t* pChars, uint uiCount, float* pWidths) const;
+
+        /// Returns the kerning amounts between consecutive characters.
+        /** \param pChars    The unicode characters
+        *   \param uiCount   The number of characters
+        *   \param pKernings The array to fill (uiCount-1 values)
+        */
+        void get_character_kernings(const char32_t* pChars, uint uiCount, float* pKernings) const;
+
+        /// Returns the underlying material to use for rendering.
+        /** \return The underlying material to use for rendering
+        */
+        utils::wptr<gui::material> get_texture() const;
+
+        /// Returns a number that changes when the font texture is resized.
+        /** \return A number that changes when the font texture is resized
+        */
+        uint get_texture_revision() const;
+
+        /// Returns the material to use to render outlined characters.
+        /** \param fThickness The thickness of the outline (in pixels)
+        *   \return The material to use to render outlined characters
+        */
+        utils::wptr<gui::material> get_outline_texture(float fThickness) const;
+
+    private :
+
+        utils::refptr<gl::font> pFont_;
+        float                   fScale_;
+    };
+}
+}
+
+#endif
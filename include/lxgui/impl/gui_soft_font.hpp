@@ -0,0 +1,56 @@
+#ifndef GUI_SOFT_FONT_HPP
+#define GUI_SOFT_FONT_HPP
+
+#include <lxgui/utils.hpp>
+#include "lxgui/impl/gui_common_font.hpp"
+#include <string>
+
+namespace gui {
+namespace soft
+{
+    class material;
+
+    /// A texture containing characters
+    /** This is the software implementation of the gui::font.
+    *   The characters are rendered by common::font, on demand,
+    *   directly in the pixels of a soft::material.
+    */
+    class font : public common::font
+    {
+    public :
+
+        /// Constructor.
+        /** \param sFontFile The name of the font file to read
+        *   \param uiSize    The requested size in pixels of the font
+        */
+        font(const std::string& sFontFile, uint uiSize);
+
+        /// Constructor.
+        /** \param pFace  The font face to use (can be shared with other fonts)
+        *   \param uiSize The requested size in pixels of the font
+        */
+        font(utils::refptr<common::font_face> pFace, uint uiSize);
+
+        /// Destructor.
+        ~font();
+
+        /// Returns the underlying material to use for rendering.
+        /** \return The underlying material to use for rendering
+        */
+        utils::wptr<gui::material> get_texture() const;
+
+    protected :
+
+        void create_texture_(uint uiWidth, uint uiHeight);
+        bool resize_texture_(uint uiWidth, uint uiHeight) const;
+        void set_texture_alpha_(uint x, uint y, uchar ucAlpha) const;
+        void update_texture_(const quad2i& mRect) const;
+
+    private :
+
+        mutable utils::refptr<soft::material> pTexture_;
+    };
+}
+}
+
+#endif
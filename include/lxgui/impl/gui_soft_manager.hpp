@@ -0,0 +1,144 @@
+#ifndef GUI_SOFT_MANAGER_HPP
+#define GUI_SOFT_MANAGER_HPP
+
+#include <lxgui/utils.hpp>
+#include <lxgui/gui_manager.hpp>
+#include <lxgui/gui_sprite.hpp>
+
+namespace gui {
+namespace common
+{
+    class font_face;
+}
+
+namespace soft
+{
+    class render_target;
+    class material;
+    struct ub32color;
+
+    /// Software implementation of the rendering
+    /** This implementation does not need any graphics hardware :
+    *   quads are rasterized by the CPU into an in-memory RGBA
+    *   pixel buffer, with premultiplied alpha. It can be used
+    *   to run the GUI headlessly (tests, screenshots, ...).
+    *   \note Only the BLEND_NORMAL blend mode is supported.
+    */
+    class manager : public gui::manager_impl
+    {
+    public :
+
+        /// Constructor.
+        manager();
+
+        /// Destructor.
+        ~manager();
+
+        /// Begins rendering on a particular render target.
+        /** \param pTarget The render target (main screen if nullptr)
+        *   \note When rendering on the main screen, the screen render target
+        *         is (re)sized to match the screen dimensions of the gui::manager.
+        */
+        void begin(utils::refptr<gui::render_target> pTarget = nullptr) const;
+
+        /// Ends rendering.
+        void end() const;
+
+        /// Renders a quad.
+        /** \param mQuad The quad to render on the current render target
+        *   \note This function is meant to be called between begin() and
+        *         end() only.
+        */
+        virtual void render_quad(const quad& mQuad) const;
+
+        /// Renders a set of quads.
+        /** \param mQuad     The base quad to use for rendering (material, blending, ...)
+        *   \param lQuadList The list of the quads you want to render
+        *   \param mOffset   The translation to apply to all the quads
+        *   \note This function is meant to be called between begin() and
+        *         end() only.
+        */
+        virtual void render_quads(const quad& mQuad, const std::vector<std::array<vertex,4>>& lQuadList,
+            const vector2f& mOffset) const;
+
+        /// Restricts rendering to an area of the current render target.
+        /** \param mArea The area in which rendering is allowed (in pixels)
+        *   \return 'false' if there is no current render target
+        */
+        bool set_scissor(const quad2i& mArea) const;
+
+        /// Disables scissoring.
+        void disable_scissor() const;
+
+        /// Creates a new material from a texture file.
+        /** \param sFileName The name of the file
+        *   \param mFilter   The filtering to apply to the texture
+        *   \return The new material
+        *   \note Only PNG textures are supported by this implementation (parsed by libpng).
+        */
+        utils::refptr<gui::material> create_material(const std::string& sFileName, filter mFilter = FILTER_NONE) const;
+
+        /// Creates a new material from a plain color.
+        /** \param mColor The color to use
+        *   \return The new material
+        */
+        utils::refptr<gui::material> create_material(const color& mColor) const;
+
+        /// Creates a new material from a render target.
+        /** \param pRenderTarget The render target from which to read the pixels
+        *   \return The new material
+        */
+        utils::refptr<gui::material> create_material(utils::refptr<gui::render_target> pRenderTarget) const;
+
+        /// Creates a new render target.
+        /** \param uiWidth  The width of the render target
+        *   \param uiHeight The height of the render target
+        */
+        utils::refptr<gui::render_target> create_render_target(uint uiWidth, uint uiHeight) const;
+
+        /// Creates a new font.
+        /** \param sFontFile The file from which to read the font
+        *   \param uiSize    The requested size of the characters (in points)
+        *   \note This implementation uses FreeType to load vector fonts and rasterize them.
+        *         Bitmap fonts are not yet supported.
+        *   \note The font file is only opened once : fonts of different sizes
+        *         created from the same file share the same font_face.
+        */
+        utils::refptr<gui::font> create_font(const std::string& sFontFile, uint uiSize) const;
+
+        /// Returns the render target that represents the main screen.
+        /** \return The render target that represents the main screen
+        *   \note This is where everything ends up when calling begin()
+        *         without a render target. Its pixels can be read back with
+        *         soft::render_target::get_material().
+        */
+        utils::wptr<soft::render_target> get_screen_target() const;
+
+    private :
+
+        /// A triangle vertex, in pixel coordinates.
+        struct raster_vertex
+        {
+            float x, y;
+            float u, v;
+            float r, g, b, a;
+        };
+
+        void render_quad_(const quad& mQuad, const std::array<vertex,4>& lVertexList,
+            const vector2f& mOffset, soft::material& mTarget, const quad2i& mClip) const;
+        void render_triangle_(const raster_vertex& v0, const raster_vertex& v1, const raster_vertex& v2,
+            const soft::material* pTexture, soft::material& mTarget, const quad2i& mClip) const;
+
+        utils::refptr<gui::material> create_material_png(const std::string& sFileName, filter mFilter) const;
+
+        mutable std::map<std::string, utils::wptr<gui::material>> lTextureList_;
+        mutable std::map<std::string, utils::wptr<gui::font>>     lFontList_;
+        mutable std::map<std::string, utils::wptr<common::font_face>> lFontFaceList_;
+
+        mutable utils::refptr<soft::render_target> pScreenTarget_;
+        mutable utils::refptr<soft::render_target> pCurrentTarget_;
+    };
+}
+}
+
+#endif
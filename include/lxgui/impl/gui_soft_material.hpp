@@ -0,0 +1,183 @@
+#ifndef GUI_SOFT_MATERIAL_HPP
+#define GUI_SOFT_MATERIAL_HPP
+
+#include <lxgui/utils.hpp>
+#include <lxgui/gui_material.hpp>
+#include <lxgui/gui_color.hpp>
+
+#include <vector>
+
+namespace gui {
+namespace soft
+{
+    struct ub32color
+    {
+        typedef unsigned char chanel;
+        ub32color();
+        ub32color(chanel r, chanel g, chanel b, chanel a);
+        chanel r, g, b, a;
+    };
+
+    /// A class that holds rendering data
+    /** This implementation can contain either a plain color
+    *   or a texture that lives in CPU memory. It is also used by
+    *   the gui::soft::render_target class to store the output data.
+    *   \note Texture data is stored with premultiplied alpha.
+    */
+    class material : public gui::material
+    {
+    public :
+
+        enum wrap
+        {
+            REPEAT,
+            CLAMP
+        };
+
+        enum filter
+        {
+            NONE,
+            LINEAR
+        };
+
+        enum type
+        {
+            TYPE_TEXTURE,
+            TYPE_COLOR
+        };
+
+        /// Constructor for textures.
+        /** \param uiWidth  The requested texture width
+        *   \param uiHeight The requested texture height
+        *   \param mWrap    How to adjust texture coordinates that are outside the [0,1] range
+        *   \param mFilter  Use texture filtering or not (see set_filter())
+        */
+        material(uint uiWidth, uint uiHeight, wrap mWrap = REPEAT, filter mFilter = NONE);
+
+        /// Constructor for plain colors.
+        /** \param mColor The plain color to use
+        */
+        material(const color& mColor);
+
+        /// Destructor.
+        ~material();
+
+        /// Returns the type of this texture (texture or color).
+        /** \return The type of this texture (texture or color)
+        */
+        type get_type() const;
+
+        /// Returns the width of the underlying texture (if any).
+        /** \return The width of the underlying texture (if any)
+        */
+        float get_width() const;
+
+        /// Returns the height of the underlying texture (if any).
+        /** \return The height of the underlying texture (if any)
+        */
+        float get_height() const;
+
+        /// Returns the physical width of the underlying texture (if any).
+        /** \return The physical width of the underlying texture (if any)
+        *   \note There is no hardware restriction in this implementation :
+        *         this is always equal to get_width().
+        */
+        float get_real_width() const;
+
+        /// Returns the physical height of the underlying texture (if any).
+        /** \return The physical height of the underlying texture (if any)
+        *   \note There is no hardware restriction in this implementation :
+        *         this is always equal to get_height().
+        */
+        float get_real_height() const;
+
+        /// Resizes this texture.
+        /** \param uiWidth  The new texture width
+        *   \param uiHeight The new texture height
+        *   \return 'true' if the pixel buffer had to be reallocated
+        *   \note All the previous data that was stored in this texture will be lost.
+        */
+        bool set_dimensions(uint uiWidth, uint uiHeight);
+
+        /// Returns the plain color of this texture.
+        /** \return The plain color of this texture
+        */
+        color get_color() const;
+
+        /// Premultiplies the texture by alpha component.
+        /** \note Premultiplied alpha is a rendering technique that allows perfect
+        *         alpha blending when using render targets.
+        */
+        void premultiply_alpha();
+
+        /// Sets the wrap mode of this texture.
+        /** \param mWrap How to adjust texture coordinates that are outside the [0,1] range
+        */
+        void set_wrap(wrap mWrap);
+
+        /// Returns the wrap mode of this texture.
+        /** \return The wrap mode of this texture
+        */
+        wrap get_wrap() const;
+
+        /// Sets the filter mode of this texture.
+        /** \param mFilter Use texture filtering or not
+        *   \note When texture filtering is disabled, enlarged textures get pixelated.
+        *         Else, the rasterizer uses bilinear interpolation to blur the pixels.
+        */
+        void set_filter(filter mFilter);
+
+        /// Returns the filter mode of this texture.
+        /** \return The filter mode of this texture
+        */
+        filter get_filter() const;
+
+        /// Returns the texture data (read only).
+        /** \return The texture data (read only)
+        */
+        const std::vector<ub32color>& get_data() const;
+
+        /// Returns the texture data (read and write).
+        /** \return The texture data (read and write)
+        */
+        std::vector<ub32color>&       get_data();
+
+        /// Sets the color of one pixel.
+        /** \param x      The coordinate of the pixel in the texture
+        *   \param y      The coordinate of the pixel in the texture
+        *   \param mColor The new color of the pixel
+        */
+        void                          set_pixel(uint x, uint y, const ub32color& mColor);
+
+        /// Returns the color of one pixel (read only).
+        /** \param x      The coordinate of the pixel in the texture
+        *   \param y      The coordinate of the pixel in the texture
+        *   \return The color of the pixel
+        */
+        const ub32color&              get_pixel(uint x, uint y) const;
+
+        /// Returns the color of one pixel.
+        /** \param x The coordinate of the pixel in the texture
+        *   \param y The coordinate of the pixel in the texture
+        *   \return The color of the pixel
+        */
+        ub32color&                    get_pixel(uint x, uint y);
+
+    private:
+
+        material(const material& tex);
+        material& operator = (const material& tex);
+
+        type mType_;
+
+        uint   uiWidth_, uiHeight_;
+        wrap   mWrap_;
+        filter mFilter_;
+        color  mColor_;
+
+        std::vector<ub32color> lData_;
+    };
+}
+}
+
+#endif
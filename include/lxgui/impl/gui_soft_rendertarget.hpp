@@ -0,0 +1,102 @@
+#ifndef GUI_SOFT_RENDERTARGET_HPP
+#define GUI_SOFT_RENDERTARGET_HPP
+
+#include <lxgui/utils.hpp>
+#include <lxgui/gui_rendertarget.hpp>
+#include <lxgui/gui_quad2.hpp>
+#include "lxgui/impl/gui_soft_material.hpp"
+
+namespace gui {
+namespace soft
+{
+    /// A place to render things (the screen, a texture, ...)
+    /** In this implementation, a render target is a simple RGBA
+    *   pixel buffer in CPU memory (with premultiplied alpha).
+    */
+    class render_target : public gui::render_target
+    {
+    public :
+
+        /// Constructor.
+        /** \param uiWidth  The width of the render_target
+        *   \param uiHeight The height of the render_target
+        */
+        render_target(uint uiWidth, uint uiHeight);
+
+        /// Destructor.
+        ~render_target();
+
+        /// Begins rendering on this target.
+        /** \note Disables scissoring.
+        */
+        void begin();
+
+        /// Ends rendering on this target.
+        /** \note Disables scissoring.
+        */
+        void end();
+
+        /// Clears the content of this render_target.
+        /** \param mColor The color to use as background
+        *   \note Only clears the scissor area, if any.
+        */
+        void clear(const color& mColor);
+
+        /// Restricts rendering to an area of this render target.
+        /** \param mArea The area in which rendering is allowed (in pixels)
+        */
+        void set_scissor(const quad2i& mArea);
+
+        /// Disables scissoring.
+        void disable_scissor();
+
+        /// Returns the area in which rendering is allowed.
+        /** \return The area in which rendering is allowed
+        *   \note If scissoring is disabled, this is the whole render target.
+        */
+        const quad2i& get_scissor() const;
+
+        /// Returns this render target's width.
+        /** \return This render target's width
+        */
+        uint get_width() const;
+
+        /// Returns this render target's height.
+        /** \return This render target's height
+        */
+        uint get_height() const;
+
+        /// Sets this render target's dimensions.
+        /** \param uiWidth This render target's width
+        *   \param uiHeight This render target's height
+        *   \return 'true' if the function had to re-create a
+        *           new render target
+        */
+        bool set_dimensions(uint uiWidth, uint uiHeight);
+
+        /// Returns this render target's real width.
+        /** \return This render target's real width
+        *   \note This is always equal to get_width() in this implementation.
+        */
+        uint get_real_width() const;
+
+        /// Returns this render target's real height.
+        /** \return This render target's real height
+        *   \note This is always equal to get_height() in this implementation.
+        */
+        uint get_real_height() const;
+
+        /// Returns the associated texture for rendering.
+        /** \return The underlying pixel buffer, that you can use to render its content
+        */
+        utils::wptr<soft::material> get_material();
+
+    private :
+
+        utils::refptr<soft::material> pTexture_;
+        quad2i                        mScissor_;
+    };
+}
+}
+
+#endif
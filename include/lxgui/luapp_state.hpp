@@ -76,6 +76,15 @@ public :
     */
     void do_string(const std::string& sStr);
 
+    /// Executes a string containing Lua instructions.
+    /** \param sStr       The string to execute
+    *   \param sChunkName The name of the chunk, used in error messages
+    *   \note If the chunk name starts with '@', the rest is used as a file
+    *         name (see lua_load()). This function wil throw an exception if
+    *         any error occurs. Don't forget to catch them.
+    */
+    void do_string(const std::string& sStr, const std::string& sChunkName);
+
     /// Executes a Lua function.
     /** \param sFunctionName The name of the function to execute
     *   \note This function wil throw an exception if any error occurs.
@@ -91,6 +100,27 @@ public :
     */
     void call_function(const std::string& sFunctionName, const std::vector<var>& lArgumentStack);
 
+    /// Executes a Lua function stored in the registry.
+    /** \param iRef      The reference to the function (see ref())
+    *   \param uiNumArgs The number of arguments, at the top of the stack
+    *   \note The arguments are popped from the stack, and the returned
+    *         values are discarded. This function wil throw an exception
+    *         if any error occurs. Don't forget to catch them.
+    */
+    void call_ref(int iRef, uint uiNumArgs = 0);
+
+    /// Stores the value at the top of the stack in the registry.
+    /** \return A reference to this value
+    *   \note The value is popped from the stack. The reference must be
+    *         released with unref() when it is not needed anymore.
+    */
+    int ref();
+
+    /// Releases a reference created with ref().
+    /** \param iRef The reference to release
+    */
+    void unref(int iRef);
+
     /// Binds a C++ function to a Lua function.
     /** \param sFunctionName The name of the Lua function
     *   \param mFunction     The C++ function to bind
@@ -199,6 +229,11 @@ public :
     */
     void push_global(const std::string& sName);
 
+    /// Puts a value stored in the registry on the stack.
+    /** \param iRef The reference to the value (see ref())
+    */
+    void push_ref(int iRef);
+
     /// Puts a user data (C++ pointer) on the stack.
     /** \param pData The pointer to put on the stack
     */
@@ -3,7 +3,9 @@
 
 #include "lxgui/luapp_exception.hpp"
 #include <typeinfo>
-#include <memory>
+#include <type_traits>
+#include <new>
+#include <utility>
 
 namespace lua
 {
@@ -13,12 +15,12 @@ typedef std::type_info var_type;
 /** The purpose of this class is to have an untyped
 *   return value / argument. It allows simple manipulation
 *   of events, and a lot of other things.<br><br>
-*   It uses a little bit more memory than a simple object :<br>
-*   sizeof(void*) + sizeof(T)<br>... and has the overhead of
-*   using the v-table (because of inheritance). At last, var
-*   does a dynamic_cast (which is not the fastest thing in the
-*   world) each time you call get().<br>
-*   So this class is definatly slower than base types : <b>use it
+*   Small values (numbers, booleans, strings, ...) are stored
+*   inside the var itself, so creating or copying them does not
+*   allocate memory (a string can still allocate its own buffer if
+*   it is long). Larger values are allocated on the heap.<br>
+*   get() only compares a type tag, but calling it still has a
+*   cost : this class is slower than base types, <b>use it
 *   wisely</b>.
 *   \note This class is highly inspired from boost::any.
 */
@@ -33,13 +35,16 @@ public :
     /** \param mValue The value to assign
     */
     template <class T>
-    var(const T& mValue) : pValue_(new value<T>(mValue)) {}
+    var(const T& mValue) : bInline_(false), pValue_(create_<T>(mValue, &mBuffer_, bInline_)) {}
 
     /// Copy constructor.
     /** \param mVar The var to copy
     */
     var(const var& mVar);
 
+    /// Destructor.
+    ~var();
+
     var& operator = (const var& mVar);
 
     bool operator == (const var& mVar) const;
@@ -60,13 +65,11 @@ public :
     template<class T>
     const T& get() const
     {
-        const value<T>* pValue = dynamic_cast<const value<T>*>(pValue_.get());
-
-        if (pValue)
-            return pValue->mT_;
+        if (pValue_ && pValue_->pTag_ == get_tag_<T>())
+            return static_cast<const value<T>*>(pValue_)->mT_;
 
         throw lua::exception("var",
-            "Conversion from "+std::string(pValue ? "type \""+std::string(pValue_->get_type().name())
+            "Conversion from "+std::string(pValue_ ? "type \""+std::string(pValue_->get_type().name())
             +"\"" : "empty lua::var")+" to \""+typeid(T).name()+"\" failed."
         );
     }
@@ -93,11 +96,11 @@ public :
     {
         if (pValue_)
         {
-            return pValue_->get_type() == typeid(T);
+            return pValue_->pTag_ == get_tag_<T>();
         }
         else
         {
-            return typeid(void) == typeid(T);
+            return std::is_void<T>::value;
         }
     }
 
@@ -120,13 +123,26 @@ private :
     /** \cond NOT_REMOVE_FROM_DOC
     */
 
+    // Types are compared with the address of a static variable
+    // that is unique for each type, rather than with RTTI
+    template<class T>
+    static const void* get_tag_()
+    {
+        static const char cTag = 0;
+        return &cTag;
+    }
+
     class value_base
     {
     public :
 
+        explicit value_base(const void* pTag) : pTag_(pTag) {}
         virtual ~value_base() {}
-        virtual value_base* clone() const = 0;
+        virtual value_base* clone(void* pBuffer, bool& bInline) const = 0;
+        virtual value_base* move(void* pBuffer, bool& bInline) = 0;
         virtual const var_type& get_type() const = 0;
+
+        const void* pTag_;
     };
 
     template <class T>
@@ -136,11 +152,17 @@ private :
 
         friend var;
 
-        value(const T& mT) : mT_(mT) {}
+        value(const T& mT) : value_base(get_tag_<T>()), mT_(mT) {}
+        value(T&& mT) : value_base(get_tag_<T>()), mT_(std::move(mT)) {}
 
-        value_base* clone() const
+        value_base* clone(void* pBuffer, bool& bInline) const
         {
-            return new value(mT_);
+            return create_<T>(mT_, pBuffer, bInline);
+        }
+
+        value_base* move(void* pBuffer, bool& bInline)
+        {
+            return create_<T>(std::move(mT_), pBuffer, bInline);
         }
 
         const var_type& get_type() const
@@ -156,7 +178,27 @@ private :
     /** \endcond
     */
 
-    std::unique_ptr<value_base> pValue_;
+    typedef std::aligned_storage<48>::type buffer;
+
+    // Values that fit in the buffer are created inside it
+    template<class T, class U>
+    static value_base* create_(U&& mValue, void* pBuffer, bool& bInline)
+    {
+        bInline = sizeof(value<T>) <= sizeof(buffer) &&
+            std::alignment_of<value<T>>::value <= std::alignment_of<buffer>::value;
+
+        if (bInline)
+            return new (pBuffer) value<T>(std::forward<U>(mValue));
+        else
+            return new value<T>(std::forward<U>(mValue));
+    }
+
+    void move_from_(var& mVar);
+    void clear_();
+
+    buffer      mBuffer_;
+    bool        bInline_;
+    value_base* pValue_;
 };
 }
 
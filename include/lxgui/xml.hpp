@@ -11,5 +11,6 @@
 namespace xml
 {
     class document;
+    class definition;
     class block;
 }
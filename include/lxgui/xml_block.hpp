@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <iosfwd>
 #include <lxgui/utils.hpp>
 
 namespace xml
@@ -50,6 +51,21 @@ namespace xml
         uint   uiRadioGroup;
     };
 
+    /// Writes an unsigned integer to a binary stream.
+    /** \param mStream The stream to write to
+    *   \param uiValue The value to write
+    *   \note Used for cache files (always written in little endian).
+    */
+    void write_uint(std::ostream& mStream, uint uiValue);
+
+    /// Reads an unsigned integer from a binary stream.
+    /** \param mStream The stream to read from
+    *   \param uiValue The value that has been read
+    *   \return 'false' if the end of the stream was reached
+    *   \note Used for cache files (always written in little endian).
+    */
+    bool read_uint(std::istream& mStream, uint& uiValue);
+
     /// An element in an XML file
     class block
     {
@@ -243,11 +259,12 @@ namespace xml
         */
         void set_name(const std::string& sName);
 
-        /// Sets this Block's value.
-        /** \param sValue The new value
+        /// Appends text to this Block's value.
+        /** \param pBegin The beginning of the text
+        *   \param pEnd   The end of the text
         *   \note Only used in the loading stage.
         */
-        void add_value(const std::string& sValue);
+        void add_value(const char* pBegin, const char* pEnd);
 
         /// Notify this block that another one derivates from it.
         /** \param sName The name of the derivated Block
@@ -359,6 +376,26 @@ namespace xml
         */
         predefined_block* add_predefined_radio_block(block* pBlock, uint uiRadioGroup);
 
+        /// Writes this block and its children to a binary stream.
+        /** \param mStream The stream to write to
+        *   \note Only used to create cache files.
+        */
+        void save(std::ostream& mStream) const;
+
+        /// Reads this block and its children from a binary stream.
+        /** \param mStream The stream to read from
+        *   \return 'false' if the stream is corrupted
+        *   \note Only used to load cache files. Only the data that is
+        *         available after the loading stage is read.
+        */
+        bool load(std::istream& mStream);
+
+        /// Adds a block that has been fully loaded to this block's children.
+        /** \param pBlock The block to add
+        *   \note This block takes ownership of pBlock.
+        */
+        void add_block(block* pBlock);
+
     private :
 
         std::string sName_;
@@ -2,10 +2,13 @@
 #define XML_DOCUMENT_HPP
 
 #include "lxgui/xml_block.hpp"
+#include <lxgui/utils_refptr.hpp>
 #include <iostream>
 
 namespace xml
 {
+    class definition;
+
     /// Parses an XML file
     /** Uses a definition file (*.def) to validate
     *   the parsed file.
@@ -13,6 +16,7 @@ namespace xml
     class document
     {
     friend class block;
+    friend class definition;
     public :
 
         /// Default constructor.
@@ -30,6 +34,15 @@ namespace xml
         */
         document(const std::string& sFileName, const std::string& sDefFileName, std::ostream& mOut = std::cout);
 
+        /// File constructor, with an already parsed definition.
+        /** \param sFileName   The path to the file you want to parse
+        *   \param pDefinition The definition to use
+        *   \param mOut        The output stream for errors and warnings
+        *   \note The definition is not parsed again : use this constructor
+        *         when parsing several files with the same definition.
+        */
+        document(const std::string& sFileName, utils::refptr<definition> pDefinition, std::ostream& mOut = std::cout);
+
         /// Destructor.
         ~document();
 
@@ -82,6 +95,21 @@ namespace xml
         */
         bool check(const std::string& sPreProcCommands = "");
 
+        /// Loads the XML file from a binary cache file, or parses it.
+        /** \param sCacheFile       The path to the cache file
+        *   \param sPreProcCommands Preprocessor commands to use when parsing
+        *                           the xml file
+        *   \return 'true' if everything went fine
+        *   \note The cache file contains the block tree as it is after
+        *         check(). It is only used if it has been created from the
+        *         same XML file, definition file and preprocessor commands.
+        *         Else, the XML file is parsed with check(), and the cache
+        *         file is (re)written if parsing succeeded.<br>
+        *         A source string cannot be cached : this function then
+        *         simply calls check().
+        */
+        bool check_cached(const std::string& sCacheFile, const std::string& sPreProcCommands = "");
+
     protected :
 
         /// Creates a new predefined block with inheritance.
@@ -93,15 +121,11 @@ namespace xml
         /// Returns a predefined Block.
         /** \param sName The name of the predefined block you want
         *   \note Only used in loading stage.
+        *   \note If this document uses a shared definition, the block
+        *         belongs to the definition and cannot be modified.
         */
         const block* get_predefined_block(const std::string& sName) const;
 
-        /// Returns a predefined Block.
-        /** \param sName The name of the predefined block you want
-        *   \note Only used in loading stage.
-        */
-        block* get_predefined_block(const std::string& sName);
-
         /// Flags this Document as invalid.
         void set_invalid();
 
@@ -133,7 +157,7 @@ namespace xml
             void          set_document(document* pDoc);
             void          set_current_block(block* pBlock);
             void          set_current_parent_block(block* pParentBlock);
-            void          add_content(const std::string& sContent);
+            void          add_content(const char* pBegin, const char* pEnd);
             const id&     get_id() const;
 
         protected :
@@ -183,8 +207,15 @@ namespace xml
         */
 
         void load_definition_();
+        block* get_predefined_block_(const std::string& sName);
+        bool parse_(std::string& sBuffer, const std::string& sPreProcCommands);
 
-        void read_tags_(std::string& sLine);
+        unsigned long long get_definition_hash_() const;
+        bool load_cache_(const std::string& sCacheFile, unsigned long long uiKey);
+        void save_cache_(const std::string& sCacheFile, unsigned long long uiKey);
+
+        void read_tags_(std::string& sBuffer);
+        void add_content_(const char* pBegin, const char* pEnd, bool bKeepLineBreaks);
         void read_opening_tag_(std::string& sTagContent);
         void read_single_tag_(std::string& sTagContent);
         void read_ending_tag_(std::string& sTagContent);
@@ -196,6 +227,8 @@ namespace xml
         uint         uiCurrentLineNbr_;
         bool         bValid_;
 
+        unsigned long long uiDefinitionHash_;
+
         xml_state mXMLState_;
         def_state mDefState_;
         state*    pState_;
@@ -205,8 +238,6 @@ namespace xml
         bool        bSmartComment_;
         std::string sSmartCommentTag_;
         uint        uiSmartCommentCount_;
-        bool        bMultilineComment_;
-        uint        uiMultilineCommentCount_;
         bool        bPreProcessor_;
         uint        uiPreProcessorCount_;
         uint        uiSkippedPreProcessorCount_;
@@ -214,6 +245,43 @@ namespace xml
         block mMainBlock_;
 
         std::map<std::string, block> lPredefinedBlockList_;
+
+        utils::refptr<definition> pDefinition_;
+    };
+
+    /// A parsed definition file (*.def)
+    /** Parsing the definition file is most of the work when loading
+    *   a small XML file. This class parses it once, so that it can be
+    *   shared by all the documents that use the same definition.
+    *   \note A definition is never modified by the documents that use it.
+    */
+    class definition
+    {
+    friend class document;
+    public :
+
+        /// Constructor.
+        /** \param sDefFileName The path to the definition file to parse
+        *   \param mOut         The output stream for errors and warnings
+        */
+        explicit definition(const std::string& sDefFileName, std::ostream& mOut = std::cout);
+
+        /// Destructor.
+        ~definition();
+
+        /// Returns the path to the definition file.
+        /** \return The path to the definition file
+        */
+        const std::string& get_file_name() const;
+
+        /// Checks if the definition file has been successfully parsed.
+        /** \return 'true' if the definition file has been successfully parsed
+        */
+        bool is_valid() const;
+
+    private :
+
+        document mDocument_;
     };
 }
 
@@ -285,11 +285,16 @@ void state::do_file(const std::string& sFile)
 }
 
 void state::do_string(const std::string& sStr)
+{
+    do_string(sStr, sStr);
+}
+
+void state::do_string(const std::string& sStr, const std::string& sChunkName)
 {
     lua_pushcfunction(pLua_, pErrorFunction_);
     uint uiFuncPos = get_top();
 
-    if (luaL_loadstring(pLua_, sStr.c_str()) != 0)
+    if (luaL_loadbuffer(pLua_, sStr.c_str(), sStr.size(), sChunkName.c_str()) != 0)
     {
         if (lua_isstring(pLua_, -1))
         {
@@ -452,6 +457,52 @@ void state::call_function(const std::string& sFunctionName, const std::vector<va
     lua_remove(pLua_, uiFuncPos);
 }
 
+void state::call_ref(int iRef, uint uiNumArgs)
+{
+    uint uiFuncPos = get_top() - uiNumArgs + 1;
+
+    lua_pushcfunction(pLua_, pErrorFunction_);
+    lua_insert(pLua_, uiFuncPos);
+    lua_rawgeti(pLua_, LUA_REGISTRYINDEX, iRef);
+    lua_insert(pLua_, uiFuncPos + 1);
+
+    if (!lua_isfunction(pLua_, uiFuncPos + 1))
+    {
+        lua::exception mExcept("state", "Reference "+utils::to_string(iRef)+" is not a function ("+
+            get_type_name(get_type(uiFuncPos + 1))+")."
+        );
+        lua_settop(pLua_, uiFuncPos-1);
+        throw mExcept;
+    }
+
+    if (lua_pcall(pLua_, uiNumArgs, 0, uiFuncPos) != 0)
+    {
+        if (lua_isstring(pLua_, -1))
+        {
+            lua::exception mExcept(lua_tostring(pLua_, -1));
+            lua_settop(pLua_, uiFuncPos-1);
+            throw mExcept;
+        }
+        else
+        {
+            lua_settop(pLua_, uiFuncPos-1);
+            throw lua::exception("state", "Unhandled error.");
+        }
+    }
+
+    lua_remove(pLua_, uiFuncPos);
+}
+
+int state::ref()
+{
+    return luaL_ref(pLua_, LUA_REGISTRYINDEX);
+}
+
+void state::unref(int iRef)
+{
+    luaL_unref(pLua_, LUA_REGISTRYINDEX, iRef);
+}
+
 void state::reg(const std::string& sFunctionName, c_function mFunction)
 {
     lua_register(pLua_, sFunctionName.c_str(), mFunction);
@@ -645,6 +696,11 @@ void state::push_global(const std::string& sName)
     get_global(sName);
 }
 
+void state::push_ref(int iRef)
+{
+    lua_rawgeti(pLua_, LUA_REGISTRYINDEX, iRef);
+}
+
 void state::set_global(const std::string& sName)
 {
     std::deque<std::string> lDecomposedName;
@@ -12,20 +12,29 @@ const var_type& var::VALUE_BOOL    = typeid(bool);
 const var_type& var::VALUE_STRING  = typeid(std::string);
 const var_type& var::VALUE_POINTER = typeid(void*);
 
-var::var() : pValue_(nullptr)
+var::var() : bInline_(false), pValue_(nullptr)
 {
 }
 
-var::var(const var& mVar) : pValue_(mVar.pValue_ ? mVar.pValue_->clone() : nullptr)
+var::var(const var& mVar) : bInline_(false),
+    pValue_(mVar.pValue_ ? mVar.pValue_->clone(&mBuffer_, bInline_) : nullptr)
 {
 }
 
+var::~var()
+{
+    clear_();
+}
+
 var& var::operator = (const var& mVar)
 {
     if (&mVar != this)
     {
+        // Copy the value before destroying the current one : the copy
+        // may throw, and mVar may be owned by the current value
         var mTemp(mVar);
-        swap(mTemp);
+        clear_();
+        move_from_(mTemp);
     }
     return *this;
 }
@@ -84,7 +93,50 @@ bool var::operator != (const var& mVar) const
 
 void var::swap(var& mVar)
 {
-    std::swap(pValue_, mVar.pValue_);
+    if (!bInline_ && !mVar.bInline_)
+    {
+        std::swap(pValue_, mVar.pValue_);
+        return;
+    }
+
+    // Values stored in the buffer cannot be moved by swapping pointers
+    var mTemp;
+    mTemp.move_from_(mVar);
+    mVar.move_from_(*this);
+    move_from_(mTemp);
+}
+
+void var::move_from_(var& mVar)
+{
+    // This var must be empty
+    if (!mVar.pValue_)
+        return;
+
+    if (mVar.bInline_)
+    {
+        pValue_ = mVar.pValue_->move(&mBuffer_, bInline_);
+        mVar.clear_();
+    }
+    else
+    {
+        pValue_ = mVar.pValue_;
+        bInline_ = false;
+        mVar.pValue_ = nullptr;
+    }
+}
+
+void var::clear_()
+{
+    if (!pValue_)
+        return;
+
+    if (bInline_)
+        pValue_->~value_base();
+    else
+        delete pValue_;
+
+    pValue_ = nullptr;
+    bInline_ = false;
 }
 
 bool var::is_empty() const
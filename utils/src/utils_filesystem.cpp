@@ -303,11 +303,12 @@ bool make_directory(const std::string& sPath)
     utils::trim(sTemp, " \t");
     utils::replace(sTemp, "\\", "/");
     std::vector<std::string> lDirs = utils::cut(sTemp, "/");
+    bool bAbsolute = !sTemp.empty() && sTemp[0] == '/';
     sTemp = "";
 
     // Add back the root directory or drive
 #ifdef LINUX
-    if (!sTemp.empty() && sTemp[0] == '/')
+    if (bAbsolute)
     {
         sTemp = "/";
     }
@@ -326,8 +327,8 @@ bool make_directory(const std::string& sPath)
         if (iter->empty())
             continue;
 
-        if (sTemp.empty())
-            sTemp = *iter;
+        if (sTemp.empty() || sTemp[sTemp.size()-1] == '/')
+            sTemp += *iter;
         else
             sTemp += "/" + *iter;
 
@@ -4,8 +4,65 @@
 #include <lxgui/utils_string.hpp>
 #include <lxgui/utils_exception.hpp>
 
+#include <iostream>
+#include <algorithm>
+
 namespace xml
 {
+void write_uint(std::ostream& mStream, uint uiValue)
+{
+    // Always little endian, so that cache files are portable
+    char lBytes[4];
+    for (uint i = 0; i < 4; ++i)
+        lBytes[i] = static_cast<char>((uiValue >> (8*i)) & 0xFF);
+
+    mStream.write(lBytes, 4);
+}
+
+void write_string(std::ostream& mStream, const std::string& sValue)
+{
+    write_uint(mStream, sValue.size());
+    mStream.write(sValue.c_str(), sValue.size());
+}
+
+bool read_uint(std::istream& mStream, uint& uiValue)
+{
+    unsigned char lBytes[4];
+    if (!mStream.read(reinterpret_cast<char*>(lBytes), 4))
+        return false;
+
+    uiValue = 0;
+    for (uint i = 0; i < 4; ++i)
+        uiValue |= static_cast<uint>(lBytes[i]) << (8*i);
+
+    return true;
+}
+
+bool read_string(std::istream& mStream, std::string& sValue)
+{
+    uint uiSize;
+    if (!read_uint(mStream, uiSize))
+        return false;
+
+    // The size comes from a file that may be corrupted : the string is
+    // read by chunks, so that it never grows larger than the file
+    const uint CHUNK_SIZE = 4096u;
+
+    sValue.clear();
+    while (uiSize != 0)
+    {
+        uint uiChunk = std::min(uiSize, CHUNK_SIZE);
+        uint uiOffset = sValue.size();
+        sValue.resize(uiOffset + uiChunk);
+        if (!mStream.read(&sValue[uiOffset], uiChunk))
+            return false;
+
+        uiSize -= uiChunk;
+    }
+
+    return true;
+}
+
 attribute::attribute() : bOptional(false), bFound(false)
 {
 }
@@ -399,9 +456,9 @@ const std::string& block::get_value() const
     return sValue_;
 }
 
-void block::add_value(const std::string& sValue)
+void block::add_value(const char* pBegin, const char* pEnd)
 {
-    sValue_ += sValue;
+    sValue_.append(pBegin, pEnd);
 }
 
 block* block::get_parent() const
@@ -661,19 +718,23 @@ void block::add_block()
 {
     if (bCreating_)
     {
-        found_block_iterator iterAdded;
-        // Store the new block
-        iterAdded = lFoundBlockList_.insert(std::make_pair(pNewBlock_->get_name(), pNewBlock_));
-        // Position it on the global stack
-        lFoundBlockStack_.push_back(iterAdded);
-        // Position it on the sorted stack
-        lFoundBlockSortedStacks_[pNewBlock_->get_name()].push_back(iterAdded);
-
+        add_block(pNewBlock_);
         pNewBlock_ = nullptr;
         bCreating_ = false;
     }
 }
 
+void block::add_block(block* pBlock)
+{
+    found_block_iterator iterAdded;
+    // Store the new block
+    iterAdded = lFoundBlockList_.insert(std::make_pair(pBlock->get_name(), pBlock));
+    // Position it on the global stack
+    lFoundBlockStack_.push_back(iterAdded);
+    // Position it on the sorted stack
+    lFoundBlockSortedStacks_[pBlock->get_name()].push_back(iterAdded);
+}
+
 block* block::create_def_block(const std::string& sName, uint uiMinNbr, uint uiMaxNbr)
 {
     lDefBlockList_[sName] = block(sName, uiMinNbr, uiMaxNbr, pDoc_->get_current_file_name(), pDoc_->get_current_line_nbr());
@@ -763,4 +824,105 @@ void block::set_line_nbr(uint uiLineNbr)
 {
     uiLineNbr_ = uiLineNbr;
 }
+
+void block::save(std::ostream& mStream) const
+{
+    write_string(mStream, sName_);
+    write_string(mStream, sValue_);
+    write_string(mStream, sFile_);
+    write_uint(mStream, uiLineNbr_);
+
+    write_uint(mStream, lAttributeList_.size());
+    std::map<std::string, attribute>::const_iterator iterAttr;
+    foreach (iterAttr, lAttributeList_)
+    {
+        write_string(mStream, iterAttr->second.sName);
+        write_string(mStream, iterAttr->second.sValue);
+        write_uint(mStream, iterAttr->second.bFound ? 1u : 0u);
+    }
+
+    write_uint(mStream, lFoundBlockStack_.size());
+    std::vector<found_block_iterator>::const_iterator iterBlock;
+    foreach (iterBlock, lFoundBlockStack_)
+        (*iterBlock)->second->save(mStream);
+
+    // Radio blocks are stored as their position in the stack
+    write_uint(mStream, bRadioChilds_ ? 1u : 0u);
+    write_uint(mStream, lRadioBlockList_.size());
+    std::map<uint, block*>::const_iterator iterRadio;
+    foreach (iterRadio, lRadioBlockList_)
+    {
+        uint uiIndex = -1;
+        for (uint i = 0; i < lFoundBlockStack_.size(); ++i)
+        {
+            if (lFoundBlockStack_[i]->second == iterRadio->second)
+            {
+                uiIndex = i;
+                break;
+            }
+        }
+
+        write_uint(mStream, iterRadio->first);
+        write_uint(mStream, uiIndex);
+    }
+}
+
+bool block::load(std::istream& mStream)
+{
+    if (!read_string(mStream, sName_) || !read_string(mStream, sValue_) ||
+        !read_string(mStream, sFile_) || !read_uint(mStream, uiLineNbr_))
+        return false;
+
+    uint uiCount;
+    if (!read_uint(mStream, uiCount))
+        return false;
+
+    for (uint i = 0; i < uiCount; ++i)
+    {
+        attribute mAttrib;
+        uint uiFound;
+        if (!read_string(mStream, mAttrib.sName) || !read_string(mStream, mAttrib.sValue) ||
+            !read_uint(mStream, uiFound))
+            return false;
+
+        mAttrib.bFound = (uiFound != 0);
+        add(mAttrib);
+    }
+
+    if (!read_uint(mStream, uiCount))
+        return false;
+
+    for (uint i = 0; i < uiCount; ++i)
+    {
+        block* pBlock = new block();
+        pBlock->set_parent(this);
+        pBlock->set_document(pDoc_);
+        if (!pBlock->load(mStream))
+        {
+            delete pBlock;
+            return false;
+        }
+
+        add_block(pBlock);
+    }
+
+    uint uiRadioChilds;
+    if (!read_uint(mStream, uiRadioChilds) || !read_uint(mStream, uiCount))
+        return false;
+
+    bRadioChilds_ = (uiRadioChilds != 0);
+    for (uint i = 0; i < uiCount; ++i)
+    {
+        uint uiGroup, uiIndex;
+        if (!read_uint(mStream, uiGroup) || !read_uint(mStream, uiIndex))
+            return false;
+
+        if (uiIndex < lFoundBlockStack_.size())
+            lRadioBlockList_[uiGroup] = lFoundBlockStack_[uiIndex]->second;
+        else
+            lRadioBlockList_[uiGroup] = nullptr;
+    }
+
+    return true;
+}
 }
@@ -6,14 +6,56 @@
 #include <lxgui/utils_string.hpp>
 
 #include <fstream>
+#include <algorithm>
 
 namespace xml
 {
+std::string read_file(const std::string& sFileName)
+{
+    std::string sBuffer;
+
+    // Read the whole file at once
+    std::ifstream mFile(sFileName, std::ios::binary);
+    mFile.seekg(0, std::ios::end);
+    std::streamoff iSize = mFile.tellg();
+    if (iSize > 0)
+    {
+        sBuffer.resize(static_cast<size_t>(iSize));
+        mFile.seekg(0, std::ios::beg);
+        mFile.read(&sBuffer[0], iSize);
+        sBuffer.resize(static_cast<size_t>(mFile.gcount()));
+    }
+
+    return sBuffer;
+}
+
+// Format of the cache files, to increment when it changes
+const char* CACHE_MAGIC   = "LXGUIXML";
+const uint  CACHE_VERSION = 1u;
+
+unsigned long long hash_string(const std::string& s, unsigned long long uiHash = 14695981039346656037ull)
+{
+    // FNV-1a
+    std::string::const_iterator iter;
+    foreach (iter, s)
+    {
+        uiHash ^= static_cast<unsigned char>(*iter);
+        uiHash *= 1099511628211ull;
+    }
+
+    return uiHash;
+}
+
+const char* find_token(const char* pBegin, const char* pEnd, const char* sToken)
+{
+    return std::search(pBegin, pEnd, sToken, sToken + 3);
+}
+
 document::document(const std::string& sDefFileName, std::ostream& mOut) :
     out(mOut.rdbuf()), sDefFileName_(sDefFileName), uiCurrentLineNbr_(0),
-    bValid_(true), pState_(nullptr), bSmartComment_(false),
-    uiSmartCommentCount_(0), bMultilineComment_(false), uiMultilineCommentCount_(0),
-    bPreProcessor_(false), uiPreProcessorCount_(0), uiSkippedPreProcessorCount_(0)
+    bValid_(true), uiDefinitionHash_(0), pState_(nullptr), bSmartComment_(false),
+    uiSmartCommentCount_(0), bPreProcessor_(false), uiPreProcessorCount_(0),
+    uiSkippedPreProcessorCount_(0)
 {
     mXMLState_.set_document(this);
     mDefState_.set_document(this);
@@ -39,9 +81,8 @@ document::document(const std::string& sDefFileName, std::ostream& mOut) :
 
 document::document(const std::string& sFileName, const std::string& sDefFileName, std::ostream& mOut) :
     out(mOut.rdbuf()),sFileName_(sFileName), sDefFileName_(sDefFileName), uiCurrentLineNbr_(0),
-    bValid_(true), pState_(nullptr), bSmartComment_(false), uiSmartCommentCount_(0),
-    bMultilineComment_(false), uiMultilineCommentCount_(0), bPreProcessor_(false),
-    uiPreProcessorCount_(0), uiSkippedPreProcessorCount_(0)
+    bValid_(true), uiDefinitionHash_(0), pState_(nullptr), bSmartComment_(false), uiSmartCommentCount_(0),
+    bPreProcessor_(false), uiPreProcessorCount_(0), uiSkippedPreProcessorCount_(0)
 {
     mXMLState_.set_document(this);
     mDefState_.set_document(this);
@@ -72,6 +113,35 @@ document::document(const std::string& sFileName, const std::string& sDefFileName
     }
 }
 
+document::document(const std::string& sFileName, utils::refptr<definition> pDefinition, std::ostream& mOut) :
+    out(mOut.rdbuf()), sFileName_(sFileName), sDefFileName_(pDefinition->get_file_name()),
+    uiCurrentLineNbr_(0), bValid_(true), uiDefinitionHash_(0), pState_(nullptr), bSmartComment_(false),
+    uiSmartCommentCount_(0), bPreProcessor_(false), uiPreProcessorCount_(0),
+    uiSkippedPreProcessorCount_(0), pDefinition_(pDefinition)
+{
+    mXMLState_.set_document(this);
+    mDefState_.set_document(this);
+    if (utils::file_exists(sFileName_))
+    {
+        if (pDefinition_->is_valid())
+        {
+            // Only the main block is copied, pre-defined blocks are shared
+            mMainBlock_ = pDefinition_->mDocument_.mMainBlock_;
+            mMainBlock_.set_document(this);
+        }
+        else
+        {
+            out << "# Error # : xml::document : \"" << sDefFileName_ << "\" is not a valid definition file." << std::endl;
+            bValid_ = false;
+        }
+    }
+    else
+    {
+        out << "# Error # : xml::document : Can't find \"" << sFileName_ << "\"." << std::endl;
+        bValid_ = false;
+    }
+}
+
 document::~document()
 {
 }
@@ -114,27 +184,13 @@ std::string document::get_current_location() const
 
 void document::load_definition_()
 {
-    // Open the def file
-    std::ifstream mFile(sDefFileName_);
+    // Load the def file
     sCurrentFileName_ = sDefFileName_;
-    uiCurrentLineNbr_ = 0u;
-    std::string sLine, sTemp;
     pState_ = &mDefState_;
 
-    // Start parsing line by line
-    while (!mFile.eof() && bValid_)
-    {
-        getline(mFile, sTemp);
-        utils::replace(sTemp, "\r", "");
-        sLine += sTemp;
-        ++uiCurrentLineNbr_;
-
-        if (!utils::has_no_content(sLine))
-        {
-            // Read all tags on this line
-            read_tags_(sLine);
-        }
-    }
+    std::string sBuffer = read_file(sDefFileName_);
+    uiDefinitionHash_ = hash_string(sBuffer);
+    read_tags_(sBuffer);
 }
 
 std::vector<std::string> read_preprocessor_commands(const std::string& sCommands)
@@ -196,7 +252,7 @@ void document::read_opening_tag_(std::string& sTagContent)
     {
         if (sTagContent[0] == '!') // Smart comment
         {
-            if (!bMultilineComment_ && !bSmartComment_)
+            if (!bSmartComment_)
             {
                 bSmartComment_ = true;
                 // Remove the exclamation mark
@@ -343,115 +399,104 @@ void document::read_ending_tag_(std::string& sTagContent)
     }
 }
 
-void document::read_tags_(std::string& sLine)
+void document::read_tags_(std::string& sBuffer)
 {
-    if (!bMultilineComment_)
+    // Carriage returns are dropped, so that the content is the same on
+    // all platforms. Line breaks are only kept in XML files.
+    sBuffer.erase(std::remove(sBuffer.begin(), sBuffer.end(), '\r'), sBuffer.end());
+    bool bKeepLineBreaks = (pState_ != &mDefState_);
+
+    const char* pEnd     = sBuffer.c_str() + sBuffer.size();
+    const char* pContent = sBuffer.c_str(); // Start of the text that is not a tag
+    const char* pLine    = sBuffer.c_str(); // Position up to which lines are counted
+    uiCurrentLineNbr_ = 1u;
+
+    while (bValid_)
     {
-        // Search for multiline comments
-        size_t uiFirst  = sLine.find("<--");
-        size_t uiSecond = sLine.find("-->");
-        if (uiSecond < uiFirst)
-        {
-            // check there are no misplaced comment end token
-            out << "# Warning # : " << sCurrentFileName_ << ":" << uiCurrentLineNbr_
-                << " : Multiline comment end token in excess (\"-->\"). Ignored." << std::endl;
-
-            std::string sTemp = sLine.substr(0, uiFirst);
-            sLine.erase(0, uiFirst);
-            utils::replace(sTemp, "-->", "");
-            sLine = sTemp + sLine;
-            uiFirst = sLine.find("<--");
-            uiSecond = sLine.find("-->");
-        }
+        const char* pFirst = std::find(pContent, pEnd, '<');
+        if (pFirst == pEnd)
+            break;
 
-        while (uiFirst != sLine.npos)
+        const char* pSecond;
+        bool bComment = (pEnd - pFirst >= 3 && pFirst[1] == '-' && pFirst[2] == '-');
+        if (bComment)
         {
-            // Multiline comment started
-            uiSecond = sLine.find("-->", uiFirst);
-            if (uiSecond != sLine.npos)
-            {
-                // It ends on the same line
-                sLine.erase(uiFirst, uiSecond+3 - uiFirst);
-            }
-            else
-            {
-                // It ends later (hopefuly)
-                bMultilineComment_ = true;
+            // Multiline comment : it ends at the first "-->"
+            pSecond = find_token(pFirst + 1, pEnd, "-->");
+            if (pSecond == pEnd)
                 break;
-            }
 
-            uiFirst = sLine.find("<--");
+            pSecond += 2;
         }
-
-        if (!bMultilineComment_)
+        else
         {
-            // Check there are no misplaced comment end token
-            if (sLine.find("-->") != sLine.npos)
-            {
-                out << "# Warning # : " << sCurrentFileName_ << ":" << uiCurrentLineNbr_
-                    << " : Multiline comment end token in excess (\"-->\"). Ignored." << std::endl;
-                utils::replace(sLine, "-->", "");
-            }
+            pSecond = std::find(pFirst + 1, pEnd, '>');
+            if (pSecond == pEnd)
+                break;
+        }
 
-            // Parse the tag as usual
-            uiFirst = sLine.find("<");
-            uiSecond = sLine.find(">", uiFirst);
-            while (uiFirst != sLine.npos && uiSecond != sLine.npos && bValid_)
-            {
-                pState_->add_content(sLine.substr(0, uiFirst));
-                std::string sTagContent = sLine.substr(uiFirst+1, uiSecond - (uiFirst+1));
+        // Tags are reported at the line they end on
+        uiCurrentLineNbr_ += std::count(pLine, pSecond, '\n');
+        pLine = pSecond;
 
-                if (sTagContent[0] == '/')
-                {
-                    // Ending tag
-                    read_ending_tag_(sTagContent);
-                }
-                else if (sTagContent[sTagContent.length()-1] == '/')
-                {
-                    // Single tag
-                    read_single_tag_(sTagContent);
-                }
-                else
-                {
-                    // Opening tag
-                    read_opening_tag_(sTagContent);
-                }
+        add_content_(pContent, pFirst, bKeepLineBreaks);
+        pContent = pSecond + 1;
 
-                sLine.erase(0, uiSecond+1);
-                uiFirst = sLine.find("<");
-                uiSecond = sLine.find(">", uiFirst);
-            }
+        if (bComment)
+            continue;
+
+        std::string sTagContent(pFirst + 1, pSecond);
+        if (!bKeepLineBreaks)
+            sTagContent.erase(std::remove(sTagContent.begin(), sTagContent.end(), '\n'), sTagContent.end());
+
+        if (sTagContent[0] == '/')
+        {
+            // Ending tag
+            read_ending_tag_(sTagContent);
+        }
+        else if (sTagContent[sTagContent.length()-1] == '/')
+        {
+            // Single tag
+            read_single_tag_(sTagContent);
         }
         else
-            uiMultilineCommentCount_ = utils::count_occurrences(sLine, "<--") + 1;
+        {
+            // Opening tag
+            read_opening_tag_(sTagContent);
+        }
     }
-    else
-    {
-        // Search the line for an ending token
-        size_t uiFirst  = sLine.find("<--");
-        size_t uiSecond = sLine.find("-->");
 
-        while (uiSecond != sLine.npos)
-        {
-            if (uiFirst != sLine.npos && (uiFirst < uiSecond))
-                uiMultilineCommentCount_ += utils::count_occurrences(sLine.substr(uiFirst, uiSecond-uiFirst), "<--");
+    if (bValid_)
+        uiCurrentLineNbr_ += std::count(pLine, pEnd, '\n');
+}
 
-            sLine.erase(0, uiSecond+3);
+void document::add_content_(const char* pBegin, const char* pEnd, bool bKeepLineBreaks)
+{
+    const char* pToken = find_token(pBegin, pEnd, "-->");
+    if (pToken != pEnd)
+    {
+        // Check there are no misplaced comment end token
+        out << "# Warning # : " << sCurrentFileName_ << ":" << uiCurrentLineNbr_
+            << " : Multiline comment end token in excess (\"-->\"). Ignored." << std::endl;
+    }
 
-            --uiMultilineCommentCount_;
-            if (uiMultilineCommentCount_ == 0)
-            {
-                bMultilineComment_ = false;
-                read_tags_(sLine);
-                break;
-            }
+    while (pBegin != pEnd)
+    {
+        const char* pStop = pToken;
+        if (!bKeepLineBreaks)
+            pStop = std::find(pBegin, pToken, '\n');
 
-            uiFirst = sLine.find("<--");
-            uiSecond = sLine.find("-->");
-        }
+        pState_->add_content(pBegin, pStop);
 
-        if (uiSecond == sLine.npos)
-            uiMultilineCommentCount_ += utils::count_occurrences(sLine, "<--");
+        if (pStop != pToken)
+            pBegin = pStop + 1;
+        else if (pToken != pEnd)
+        {
+            pBegin = pToken + 3;
+            pToken = find_token(pBegin, pEnd, "-->");
+        }
+        else
+            break;
     }
 }
 
@@ -460,64 +505,139 @@ bool document::check(const std::string& sPreProcCommands)
     if (!bValid_)
         return false;
 
+    std::string sBuffer;
+    if (!sFileName_.empty())
+        sBuffer = read_file(sFileName_);
+    else
+        sBuffer = sSourceString_;
+
+    return parse_(sBuffer, sPreProcCommands);
+}
+
+bool document::check_cached(const std::string& sCacheFile, const std::string& sPreProcCommands)
+{
+    if (!bValid_)
+        return false;
+
+    if (sFileName_.empty())
+        return check(sPreProcCommands);
+
+    // The cache is only valid for the exact same input
+    std::string sBuffer = read_file(sFileName_);
+    unsigned long long uiKey = hash_string(sBuffer, hash_string(sPreProcCommands, get_definition_hash_()));
+
+    if (load_cache_(sCacheFile, uiKey))
+        return true;
+
+    if (!parse_(sBuffer, sPreProcCommands))
+        return false;
+
+    save_cache_(sCacheFile, uiKey);
+    return true;
+}
+
+bool document::parse_(std::string& sBuffer, const std::string& sPreProcCommands)
+{
     // Parse preprocessor commands given by the user
     lPreProcessorCommands_ = read_preprocessor_commands(sPreProcCommands);
 
     if (!sFileName_.empty())
-    {
-        // Open the XML file
-        std::ifstream mFile(sFileName_);
         sCurrentFileName_ = sFileName_;
-        uiCurrentLineNbr_ = 0u;
-        pState_ = &mXMLState_;
-        pState_->set_current_block(&mMainBlock_);
+    else
+        sCurrentFileName_ = "source string";
 
-        // Start parsing line by line
-        std::string sLine, sTemp;
-        while (!mFile.eof() && bValid_)
-        {
-            getline(mFile, sTemp);
-            utils::replace(sTemp, "\r", "");
-            sLine += sTemp + "\n";
-            ++uiCurrentLineNbr_;
+    pState_ = &mXMLState_;
+    pState_->set_current_block(&mMainBlock_);
 
-            if (!utils::has_no_content(sLine))
-            {
-                // Read all tags on this line
-                read_tags_(sLine);
-            }
-        }
-    }
+    read_tags_(sBuffer);
+
+    return bValid_;
+}
+
+unsigned long long document::get_definition_hash_() const
+{
+    if (pDefinition_)
+        return pDefinition_->mDocument_.uiDefinitionHash_;
     else
+        return uiDefinitionHash_;
+}
+
+bool document::load_cache_(const std::string& sCacheFile, unsigned long long uiKey)
+{
+    std::ifstream mFile(sCacheFile, std::ios::binary);
+    if (!mFile.is_open())
+        return false;
+
+    std::string sMagic(8, ' ');
+    uint uiVersion = 0u, uiKeyLow = 0u, uiKeyHigh = 0u;
+    if (!mFile.read(&sMagic[0], 8) || sMagic != CACHE_MAGIC || !read_uint(mFile, uiVersion) ||
+        uiVersion != CACHE_VERSION || !read_uint(mFile, uiKeyLow) || !read_uint(mFile, uiKeyHigh))
+        return false;
+
+    if ((static_cast<unsigned long long>(uiKeyHigh) << 32 | uiKeyLow) != uiKey)
+        return false;
+
+    // Load in a separate block, so that nothing is modified if the file is corrupted
+    block mBlock;
+    mBlock.set_document(this);
+
+    bool bLoaded;
+    try
     {
-        // Read the source string
-        sCurrentFileName_ = "source string";
-        uiCurrentLineNbr_ = 0u;
-        std::string sLine;
-        pState_ = &mXMLState_;
-        pState_->set_current_block(&mMainBlock_);
+        bLoaded = mBlock.load(mFile);
+    }
+    catch (const std::exception&)
+    {
+        bLoaded = false;
+    }
 
-        std::vector<std::string> lLines = utils::cut_each(sSourceString_, "\n");
-        std::vector<std::string>::iterator iterLine;
+    if (!bLoaded)
+    {
+        out << "# Warning # : xml::document : \"" << sCacheFile << "\" is corrupted. Ignored." << std::endl;
+        return false;
+    }
 
-        // Start parsing line by line
-        foreach (iterLine, lLines)
-        {
-            sLine += (*iterLine) + "\n";
-            ++uiCurrentLineNbr_;
+    mMainBlock_.sValue_ = mBlock.sValue_;
+    mMainBlock_.lAttributeList_ = mBlock.lAttributeList_;
+    mMainBlock_.lRadioBlockList_ = mBlock.lRadioBlockList_;
 
-            if (!utils::has_no_content(sLine))
-            {
-                // Read all tags on this line
-                read_tags_(sLine);
-            }
+    std::vector<block::found_block_iterator>::iterator iterBlock;
+    foreach (iterBlock, mBlock.lFoundBlockStack_)
+    {
+        (*iterBlock)->second->set_parent(&mMainBlock_);
+        mMainBlock_.add_block((*iterBlock)->second);
+    }
 
-            if (!bValid_)
-                break;
-        }
+    // The children now belong to the main block
+    mBlock.lFoundBlockList_.clear();
+    mBlock.lFoundBlockStack_.clear();
+    mBlock.lFoundBlockSortedStacks_.clear();
+
+    sCurrentFileName_ = sFileName_;
+    return true;
+}
+
+void document::save_cache_(const std::string& sCacheFile, unsigned long long uiKey)
+{
+    size_t uiPos = sCacheFile.find_last_of("/\\");
+    if (uiPos != sCacheFile.npos && !utils::make_directory(sCacheFile.substr(0, uiPos)))
+    {
+        out << "# Warning # : xml::document : Can't create directory for \"" << sCacheFile << "\"." << std::endl;
+        return;
     }
 
-    return bValid_;
+    std::ofstream mFile(sCacheFile, std::ios::binary);
+    if (!mFile.is_open())
+    {
+        out << "# Warning # : xml::document : Can't write \"" << sCacheFile << "\"." << std::endl;
+        return;
+    }
+
+    mFile.write(CACHE_MAGIC, 8);
+    write_uint(mFile, CACHE_VERSION);
+    write_uint(mFile, static_cast<uint>(uiKey & 0xFFFFFFFFull));
+    write_uint(mFile, static_cast<uint>(uiKey >> 32));
+    mMainBlock_.save(mFile);
 }
 
 void document::create_predefined_block(const std::string& sName, const std::string& sInheritance)
@@ -530,6 +650,9 @@ void document::create_predefined_block(const std::string& sName, const std::stri
 
 const block* document::get_predefined_block(const std::string& sName) const
 {
+    if (pDefinition_)
+        return pDefinition_->mDocument_.get_predefined_block(sName);
+
     std::map<std::string, block>::const_iterator iter = lPredefinedBlockList_.find(sName);
     if (iter != lPredefinedBlockList_.end())
     {
@@ -541,8 +664,10 @@ const block* document::get_predefined_block(const std::string& sName) const
     }
 }
 
-block* document::get_predefined_block(const std::string& sName)
+block* document::get_predefined_block_(const std::string& sName)
 {
+    // Only the definition file itself is allowed to modify its blocks : a
+    // document that uses a shared definition never parses definition tags
     std::map<std::string, block>::iterator iter = lPredefinedBlockList_.find(sName);
     if (iter != lPredefinedBlockList_.end())
     {
@@ -559,6 +684,25 @@ void document::set_invalid()
     bValid_ = false;
 }
 
+definition::definition(const std::string& sDefFileName, std::ostream& mOut) :
+    mDocument_(sDefFileName, mOut)
+{
+}
+
+definition::~definition()
+{
+}
+
+const std::string& definition::get_file_name() const
+{
+    return mDocument_.sDefFileName_;
+}
+
+bool definition::is_valid() const
+{
+    return mDocument_.bValid_;
+}
+
 document::state::state() : pDoc_(nullptr), pCurrentBlock_(nullptr), pCurrentParentBlock_(nullptr)
 {
 }
@@ -582,10 +726,10 @@ void document::state::set_current_parent_block(block* pParentBlock)
     pCurrentParentBlock_ = pParentBlock;
 }
 
-void document::state::add_content(const std::string& sContent)
+void document::state::add_content(const char* pBegin, const char* pEnd)
 {
     if (pCurrentBlock_)
-        pCurrentBlock_->add_value(sContent);
+        pCurrentBlock_->add_value(pBegin, pEnd);
 }
 
 const document::state::id& document::state::get_id() const
@@ -933,12 +1077,12 @@ void document::def_state::read_single_tag(const std::string& sTagContent)
     {
         if (bLoad)
         {
-            if (pDoc_->get_predefined_block(sName))
+            if (pDoc_->get_predefined_block_(sName))
             {
                 if (uiRadioGroup != (uint)(-1))
-                    pCurrentParentBlock_->add_predefined_radio_block(pDoc_->get_predefined_block(sName), uiRadioGroup);
+                    pCurrentParentBlock_->add_predefined_radio_block(pDoc_->get_predefined_block_(sName), uiRadioGroup);
                 else
-                    pCurrentParentBlock_->add_predefined_block(pDoc_->get_predefined_block(sName), uiMin, uiMax);
+                    pCurrentParentBlock_->add_predefined_block(pDoc_->get_predefined_block_(sName), uiMin, uiMax);
 
                 if (lAttributes.size() != 0)
                 {
@@ -964,9 +1108,9 @@ void document::def_state::read_single_tag(const std::string& sTagContent)
             if (!sParent.empty())
             {
                 // Inheritance
-                if (pDoc_->get_predefined_block(sParent))
+                if (pDoc_->get_predefined_block_(sParent))
                 {
-                    pCurrentBlock_->copy(pDoc_->get_predefined_block(sParent));
+                    pCurrentBlock_->copy(pDoc_->get_predefined_block_(sParent));
                 }
                 else
                 {
@@ -981,7 +1125,7 @@ void document::def_state::read_single_tag(const std::string& sTagContent)
         }
         else
         {
-            if (!pDoc_->get_predefined_block(sName))
+            if (!pDoc_->get_predefined_block_(sName))
             {
                 if (uiRadioGroup != (uint)(-1))
                     pCurrentBlock_ = pCurrentParentBlock_->create_radio_def_block(sName, uiRadioGroup);
@@ -1008,11 +1152,11 @@ void document::def_state::read_single_tag(const std::string& sTagContent)
             if (!sParent.empty())
             {
                 // Inheritance
-                if (pDoc_->get_predefined_block(sParent))
+                if (pDoc_->get_predefined_block_(sParent))
                 {
                     pDoc_->create_predefined_block(sName, sParent);
                     if (!bCopy)
-                        pDoc_->get_predefined_block(sParent)->add_derivated(sName);
+                        pDoc_->get_predefined_block_(sParent)->add_derivated(sName);
                 }
                 else
                 {
@@ -1025,7 +1169,7 @@ void document::def_state::read_single_tag(const std::string& sTagContent)
             else
                 pDoc_->create_predefined_block(sName);
 
-            pCurrentBlock_ = pDoc_->get_predefined_block(sName);
+            pCurrentBlock_ = pDoc_->get_predefined_block_(sName);
             pCurrentBlock_->set_document(pDoc_);
             pCurrentBlock_->set_name(sName);
 
@@ -1034,7 +1178,7 @@ void document::def_state::read_single_tag(const std::string& sTagContent)
         else
         {
             // Main block
-            if (!pDoc_->get_predefined_block(sName))
+            if (!pDoc_->get_predefined_block_(sName))
             {
                 pCurrentBlock_ = pDoc_->get_main_block();
                 pCurrentBlock_->set_name(sName);
@@ -1137,8 +1281,8 @@ void document::def_state::read_opening_tag(const std::string& sTagContent)
             if (!sParent.empty())
             {
                 // Inheritance
-                if (pDoc_->get_predefined_block(sParent))
-                    pCurrentBlock_->copy(pDoc_->get_predefined_block(sParent));
+                if (pDoc_->get_predefined_block_(sParent))
+                    pCurrentBlock_->copy(pDoc_->get_predefined_block_(sParent));
                 else
                 {
                     throw utils::exception(pDoc_->get_current_location(),
@@ -1150,7 +1294,7 @@ void document::def_state::read_opening_tag(const std::string& sTagContent)
 
             pCurrentParentBlock_ = pCurrentBlock_;
         }
-        else if (!pDoc_->get_predefined_block(sName))
+        else if (!pDoc_->get_predefined_block_(sName))
         {
             if (uiRadioGroup != (uint)(-1))
                 pCurrentBlock_ = pCurrentParentBlock_->create_radio_def_block(sName, uiRadioGroup);
@@ -1176,11 +1320,11 @@ void document::def_state::read_opening_tag(const std::string& sTagContent)
             if (!sParent.empty())
             {
                 // Inheritance
-                if (pDoc_->get_predefined_block(sParent))
+                if (pDoc_->get_predefined_block_(sParent))
                 {
                     pDoc_->create_predefined_block(sName, sParent);
                     if (!bCopy)
-                        pDoc_->get_predefined_block(sParent)->add_derivated(sName);
+                        pDoc_->get_predefined_block_(sParent)->add_derivated(sName);
                 }
                 else
                 {
@@ -1193,7 +1337,7 @@ void document::def_state::read_opening_tag(const std::string& sTagContent)
             else
                 pDoc_->create_predefined_block(sName);
 
-            pCurrentBlock_ = pDoc_->get_predefined_block(sName);
+            pCurrentBlock_ = pDoc_->get_predefined_block_(sName);
             pCurrentBlock_->set_document(pDoc_);
         }
         else